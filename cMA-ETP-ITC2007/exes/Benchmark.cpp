@@ -0,0 +1,286 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+#include <cstdlib>
+#include <new>
+#include <chrono>
+#include <functional>
+#include <utils/eoRNG.h>
+#include "testset/ITC2007TestSet.h"
+#include "chromosome/eoChromosome.h"
+#include "containers/TimetableContainerMatrix.h"
+#include "init/ETTPInit.h"
+#include "kempeChain/ETTPKempeChainHeuristic.h"
+
+using namespace std;
+
+
+// Microbenchmarks of the solver's hot kernels, written as CSV to the standard output: one line
+// per dataset and kernel with the # timed operations, the mean time and the mean # heap
+// allocations per operation. The kernels are:
+//   - saturationDegree: construction of a solution from scratch (ETTPInit)
+//   - chromosomeCopy: eoChromosome copy constructor
+//   - containerCopy: TimetableContainerMatrix copy constructor
+//   - containerUnschedule, containerSchedule: unscheduling an exam and scheduling it back
+//   - containerReplacePeriod: replacing a period by its own contents
+//   - kempeBuild, kempeEvaluate: building a random Kempe chain move and evaluating it
+//   - kempeDo, kempeUndo: applying a feasible move to the solution and undoing it
+//   - incrementalCost: eoChromosome::computeSolutionCostIncremental of a feasible move
+//   - fullCost: eoChromosome::computeCost
+// The global rng is seeded before the constructions and the Kempe chain moves are drawn from a
+// random generator with the same seed, so every run with the same seed times the same start
+// solution and moves. The benchmark is single threaded.
+
+
+// # heap allocations made by the process
+static unsigned long long numAllocations = 0;
+
+void *operator new(size_t _size) {
+    ++numAllocations;
+    if (void *p = malloc(_size ? _size : 1))
+        return p;
+    throw bad_alloc();
+}
+
+void *operator new[](size_t _size) {
+    return operator new(_size);
+}
+
+void operator delete(void *_p) noexcept {
+    free(_p);
+}
+
+void operator delete[](void *_p) noexcept {
+    free(_p);
+}
+
+void operator delete(void *_p, size_t) noexcept {
+    free(_p);
+}
+
+void operator delete[](void *_p, size_t) noexcept {
+    free(_p);
+}
+
+
+// Accumulated measurements of a kernel
+struct KernelStats {
+    string name;
+    long numOps = 0;
+    double totalNs = 0;
+    unsigned long long totalAllocations = 0;
+};
+
+
+// Overhead of one timing, in ns, subtracted from each measurement
+static double timerOverheadNs = 0;
+
+
+// Time one call of _op and add it to _stats
+template <typename Op>
+inline void measure(KernelStats &_stats, Op const &_op) {
+    unsigned long long allocationsBefore = numAllocations;
+    auto start = chrono::steady_clock::now();
+    _op();
+    auto end = chrono::steady_clock::now();
+    _stats.totalAllocations += numAllocations - allocationsBefore;
+    _stats.totalNs += chrono::duration<double, nano>(end - start).count() - timerOverheadNs;
+    ++_stats.numOps;
+}
+
+
+// Estimate the overhead of one timing
+void calibrateTimer() {
+    KernelStats stats;
+    for (int i = 0; i < 100000; ++i)
+        measure(stats, []() { });
+    timerOverheadNs = stats.totalNs/stats.numOps;
+}
+
+
+// Write the measurements of kernel _stats on dataset _datasetName as a CSV line
+void writeStats(KernelStats const &_stats, string const &_datasetName) {
+    cout << _datasetName << "," << _stats.name << "," << _stats.numOps << ",";
+    if (_stats.numOps == 0) {
+        cout << "," << endl;
+        return;
+    }
+    cout << max(0.0, _stats.totalNs/_stats.numOps) << "," << (double)_stats.totalAllocations/_stats.numOps << endl;
+}
+
+
+// Run the benchmarks on the problem _timetableProblemData of dataset _datasetName
+void benchmarkDataset(TimetableProblemData const *_timetableProblemData, string const &_datasetName,
+                      int _numConstructions, int _numMoves, int _numContainerOps, uint32_t _seed) {
+    ETTPInit<eoChromosome> init(_timetableProblemData);
+    //
+    // Construction. The start solution is the first feasible one
+    //
+    KernelStats constructionStats;
+    constructionStats.name = "saturationDegree";
+    boost::shared_ptr<eoChromosome> startSolution;
+    rng.reseed(_seed);
+    for (int i = 0; i < _numConstructions || (startSolution.get() == nullptr && i < 10*_numConstructions); ++i) {
+        boost::shared_ptr<eoChromosome> sol(new eoChromosome(_timetableProblemData));
+        measure(constructionStats, [&]() { init(*sol.get()); });
+        if (startSolution.get() == nullptr && sol->isFeasible())
+            startSolution = sol;
+    }
+    writeStats(constructionStats, _datasetName);
+    if (startSolution.get() == nullptr)
+        throw runtime_error("No feasible solution was constructed");
+    eoChromosome &sol = *startSolution.get();
+    sol.computeCost();
+
+    //
+    // Copies
+    //
+    KernelStats chromosomeCopyStats, containerCopyStats;
+    chromosomeCopyStats.name = "chromosomeCopy";
+    containerCopyStats.name = "containerCopy";
+    for (int i = 0; i < _numContainerOps; ++i)
+        measure(chromosomeCopyStats, [&]() { eoChromosome copy(sol); });
+    auto const &container = dynamic_cast<TimetableContainerMatrix const &>(sol.getTimetableContainer());
+    for (int i = 0; i < _numContainerOps; ++i)
+        measure(containerCopyStats, [&]() { TimetableContainerMatrix copy(container); });
+    writeStats(chromosomeCopyStats, _datasetName);
+    writeStats(containerCopyStats, _datasetName);
+
+    //
+    // Container updates, on a copy of the start solution. Each exam is unscheduled and scheduled
+    // back into its period and room, and each period is replaced by its own contents
+    //
+    eoChromosome scratch(sol);
+    TimetableContainer &scratchContainer = scratch.getTimetableContainer();
+    KernelStats unscheduleStats, scheduleStats, replacePeriodStats;
+    unscheduleStats.name = "containerUnschedule";
+    scheduleStats.name = "containerSchedule";
+    replacePeriodStats.name = "containerReplacePeriod";
+    int numExams = scratch.getNumExams();
+    int numPeriods = scratch.getNumPeriods();
+    for (int i = 0; i < _numContainerOps; ++i) {
+        int ei = i % numExams;
+        // Get exam period and room
+        ScheduledExam const &scheduledExam = scratchContainer.getScheduledExamsVector()[ei];
+        int tj = scheduledExam.getPeriod();
+        int rk = scheduledExam.getRoom();
+        measure(unscheduleStats, [&]() { scratchContainer.unscheduleExam(ei, tj); });
+        measure(scheduleStats, [&]() { scratchContainer.scheduleExam(ei, tj, rk); });
+    }
+    vector<int> periodRooms(numExams);
+    for (int i = 0; i < _numContainerOps; ++i) {
+        int ti = i % numPeriods;
+        // Get period column, with the room of each exam scheduled in ti
+        int size = 0;
+        for (int ei = 0; ei < numExams; ++ei) {
+            periodRooms[ei] = scratchContainer.isExamScheduled(ei, ti) ? scratchContainer.getRoom(ei, ti) : REMOVE_EXAM;
+            size += (periodRooms[ei] != REMOVE_EXAM);
+        }
+        measure(replacePeriodStats, [&]() { scratchContainer.replacePeriod(ti, periodRooms, size); });
+    }
+    writeStats(unscheduleStats, _datasetName);
+    writeStats(scheduleStats, _datasetName);
+    writeStats(replacePeriodStats, _datasetName);
+
+    //
+    // Kempe chain moves on the start solution, which is left unchanged by each move
+    //
+    eoRng moveRng(_seed);
+    ETTPKempeChainHeuristic<eoChromosome> kempe;
+    kempe.setRandomGenerator(moveRng);
+    KernelStats buildStats, evaluateStats, doStats, undoStats, incrementalStats, fullStats;
+    buildStats.name = "kempeBuild";
+    evaluateStats.name = "kempeEvaluate";
+    doStats.name = "kempeDo";
+    undoStats.name = "kempeUndo";
+    incrementalStats.name = "incrementalCost";
+    fullStats.name = "fullCost";
+    long solutionCost = sol.getSolutionCost();
+    for (int i = 0; i < _numMoves; ++i) {
+        measure(buildStats, [&]() { kempe.build(sol); });
+        measure(evaluateStats, [&]() { kempe.evaluateSolutionMove(sol); });
+        if (!kempe.isFeasibleNeighbour())
+            continue;
+        measure(incrementalStats, [&]() { sol.computeSolutionCostIncremental(kempe.getKempeChain()); });
+        sol.setSolutionCost(solutionCost);
+        measure(doStats, [&]() { kempe.doSolutionMove(sol); });
+        measure(fullStats, [&]() { sol.computeCost(); });
+        measure(undoStats, [&]() { kempe.undoSolutionMove(sol); });
+        sol.setSolutionCost(solutionCost);
+    }
+    writeStats(buildStats, _datasetName);
+    writeStats(evaluateStats, _datasetName);
+    writeStats(doStats, _datasetName);
+    writeStats(undoStats, _datasetName);
+    writeStats(incrementalStats, _datasetName);
+    writeStats(fullStats, _datasetName);
+}
+
+
+
+int main(int argc, char* argv[])
+{
+    int numConstructions = 20;
+    int numMoves = 100000;
+    int numContainerOps = 100000;
+    uint32_t seed = 1;
+    vector<string> datasetNames;
+    vector<string> args;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--constructions" && i+1 < argc)
+            numConstructions = atoi(argv[++i]);
+        else if (arg == "--moves" && i+1 < argc)
+            numMoves = atoi(argv[++i]);
+        else if (arg == "--container-ops" && i+1 < argc)
+            numContainerOps = atoi(argv[++i]);
+        else if (arg == "--seed" && i+1 < argc)
+            seed = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--datasets" && i+1 < argc) {
+            stringstream ss(argv[++i]);
+            string number;
+            while (getline(ss, number, ','))
+                datasetNames.push_back("exam_comp_set" + number + ".exam");
+        }
+        else
+            args.push_back(arg);
+    }
+    if (args.size() != 1 || numConstructions < 1 || numMoves < 0 || numContainerOps < 0) {
+        cout << "Usage: ./Benchmark [--datasets LIST] [--moves N] [--container-ops N] [--constructions N] [--seed S]   <test benchmarks directory>" << endl;
+        cout << "   Example: ./Benchmark --datasets 1,4 ./../../ETTP-Benchmarks/ITC2007 > kernels.csv" << endl;
+        cout << "   --datasets: comma separated ITC2007 dataset numbers (default: 1 to 12)" << endl;
+        cout << "   --moves: # Kempe chain moves (default: 100000)" << endl;
+        cout << "   --container-ops: # copies and container updates of each kind (default: 100000)" << endl;
+        cout << "   --constructions: # solutions constructed (default: 20)" << endl;
+        cout << "   --seed: seed of the constructions and the Kempe chain moves (default: 1)" << endl;
+        return 1;
+    }
+    string testBenchmarksDir = args[0];
+    if (datasetNames.empty()) {
+        for (int i = 1; i <= 12; ++i)
+            datasetNames.push_back("exam_comp_set" + to_string(i) + ".exam");
+    }
+
+    calibrateTimer();
+    cout << "dataset,kernel,ops,nsPerOp,allocationsPerOp" << endl;
+    int status = 0;
+    for (auto const &name : datasetNames) {
+        // The loading and construction messages go to the standard error, keeping the CSV output clean
+        streambuf *coutBuf = cout.rdbuf(cerr.rdbuf());
+        try {
+            ITC2007TestSet testSet(name, name, testBenchmarksDir);
+            testSet.load();
+            cout.rdbuf(coutBuf);
+            benchmarkDataset(testSet.getTimetableProblemData().get(), name, numConstructions, numMoves, numContainerOps, seed);
+        }
+        catch (runtime_error const &e) {
+            cout.rdbuf(coutBuf);
+            cerr << name << ": " << e.what() << endl;
+            status = 2;
+        }
+    }
+
+    return status;
+}
@@ -2,28 +2,103 @@
 #include <cmath>
 #include <iostream>
 #include <stdlib.h>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "utils/CellularEAConfig.h"
 
 using namespace std;
 
 
-extern void runAlgo(int _datasetIndex, string const& _testBenchmarksDir, string const& _outputDir);
+extern void runAlgo(int _datasetIndex, string const& _testBenchmarksDir, string const& _outputDir, bool _resume,
+                    vector<string> const& _warmStartFiles, CellularEAConfig const& _config);
+extern void runRacing(string const& _testBenchmarksDir, string const& _outputDir, CellularEAConfig const& _baseConfig,
+                      string const& _tuningFilename);
 
 
 
 int main(int argc, char* argv[])
 {
-    if (argc != 4) {
-        cout << "Usage: ./exes <test set number [1..N]>   <test benchmarks directory>   <output directory>" << endl;
-        cout << "   Example: ./exes 1 ./../../ETTP-Benchmarks/ITC2007 ./Run1/" << endl;
+    // Continue from the last checkpoint
+    bool resume = false;
+    // Solutions seeding the initial population
+    vector<string> warmStartFiles;
+    // Algorithm parameters. Configuration files and assignments are applied in order
+    CellularEAConfig config;
+    bool printConfig = false;
+    // Parameter tuning file. If given, the parameters are tuned instead of running the cEA
+    string tuningFilename;
+    vector<string> positionalArgs;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if (arg == "--resume")
+                resume = true;
+            else if (arg == "--warm-start" && i+1 < argc)
+                warmStartFiles.push_back(argv[++i]);
+            else if (arg == "--config" && i+1 < argc)
+                config.load(argv[++i]);
+            else if (arg == "--set" && i+1 < argc)
+                config.set(argv[++i]);
+            else if (arg == "--print-config")
+                printConfig = true;
+            else if (arg == "--tune" && i+1 < argc)
+                tuningFilename = argv[++i];
+            else if (arg.compare(0, 2, "--") != 0)
+                positionalArgs.push_back(arg);
+            else
+                throw runtime_error("unknown option " + arg);
+        }
+        config.check();
+    }
+    catch (runtime_error const &e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    if (printConfig) {
+        config.write(cout, true);
+        return 0;
+    }
+    if (!tuningFilename.empty() && positionalArgs.size() == 2) {
+        try {
+            runRacing(positionalArgs[0], positionalArgs[1], config, tuningFilename);
+        }
+        catch (runtime_error const &e) {
+            cout << "Error: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+    if (positionalArgs.size() != 3 || !tuningFilename.empty()) {
+        cout << "Usage: ./exes <test set number [1..N]>   <test benchmarks directory>   <output directory>   [--resume]   [--warm-start <solution file>]..." << endl;
+        cout << "                [--config <configuration file>]...   [--set <key>=<value>]...   [--print-config]" << endl;
+        cout << "       ./exes --tune <tuning file>   <test benchmarks directory>   <output directory>   [--config <configuration file>]...   [--set <key>=<value>]..." << endl;
+        cout << "   Example: ./exes 1 ./../../ETTP-Benchmarks/ITC2007 ./Run1/ --warm-start ./Run2/exam_comp_set1.exam.sol" << endl;
+        cout << "   Example: ./exes 1 ./../../ETTP-Benchmarks/ITC2007 ./Run1/ --config sweep.cfg --set nlines=2 --set ncols=8" << endl;
+        cout << "   --resume: continue the run from the checkpoint in the output directory" << endl;
+        cout << "   --warm-start: seed the initial population with an ITC2007 solution (may be repeated)" << endl;
+        cout << "   --config: read algorithm parameters from a file of \"key = value\" lines" << endl;
+        cout << "   --set: assign an algorithm parameter. Later assignments override earlier ones" << endl;
+        cout << "   --print-config: write the configuration, with the parameter descriptions, and exit" << endl;
+        cout << "   --tune: race configurations sampled around the given one on short runs of the datasets, and write the" << endl;
+        cout << "           survivors into the output directory. The tuning file gives the sampled parameter ranges and the" << endl;
+        cout << "           racing options, e.g. \"mp = 0.01 0.5\", \"alpha = 1e-4 1e-2 log\", \"runTime = 60\", \"jobs = 16\"" << endl;
+        return 1;
     }
     // Get dataset index
-    int datasetIndex = atoi(argv[1])-1;
+    int datasetIndex = atoi(positionalArgs[0].c_str())-1;
     // Get test benchmarks directory
-    string testBenchmarksDir = argv[2];
+    string testBenchmarksDir = positionalArgs[1];
     // Get output directory
-    string outputDir = argv[3];
+    string outputDir = positionalArgs[2];
 
-    runAlgo(datasetIndex, testBenchmarksDir, outputDir);
+    try {
+        runAlgo(datasetIndex, testBenchmarksDir, outputDir, resume, warmStartFiles, config);
+    }
+    catch (runtime_error const &e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
 
     return 0;
 }
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdlib>
+#include "utils/ConvergenceTrace.h"
+
+using namespace std;
+
+
+// Reads the convergence traces (<instance>.trace) written by the cEA runs and merges them
+// into a performance profile, written as CSV to the standard output. For each point of a
+// time (or # evaluations) grid, the profile gives the best cost statistics over the runs
+// and the fraction of runs which reached each target cost.
+
+
+// Get the x coordinate of record _record: seconds or # evaluations
+double getX(ConvergenceTraceRecord const &_record, bool _evals) {
+    return _evals ? (double)_record.numEvaluations : _record.time;
+}
+
+
+// Write the records of one trace as CSV
+void dumpTrace(vector<ConvergenceTraceRecord> const &_records) {
+    cout << "time,generation,evaluations,bestCost";
+    for (char const *name : ConvergenceTrace::CONSTRAINT_NAMES)
+        cout << "," << name;
+    cout << ",popMean,popVariance,feasibleRate,acceptRate,improveRate" << endl;
+    for (auto const &r : _records) {
+        cout << r.time << "," << r.generation << "," << r.numEvaluations << "," << r.bestCost;
+        for (int i = 0; i < NUM_CONSTRAINT_COSTS; ++i)
+            cout << "," << r.constraintCosts[i];
+        cout << "," << r.popMean << "," << r.popVariance << "," << r.feasibleRate
+             << "," << r.acceptRate << "," << r.improveRate << endl;
+    }
+}
+
+
+// Write the performance profile of runs _runs over _numPoints grid points
+void writeProfile(vector<vector<ConvergenceTraceRecord> > const &_runs, bool _evals, int _numPoints,
+                  vector<double> const &_targets) {
+    double maxX = 0;
+    for (auto const &run : _runs) {
+        if (!run.empty())
+            maxX = max(maxX, getX(run.back(), _evals));
+    }
+    cout << (_evals ? "evaluations" : "time") << ",runs,mean,min,median,max";
+    for (double target : _targets)
+        cout << ",P(cost<=" << target << ")";
+    cout << endl;
+    // Index of the last record of each run before the current grid point
+    vector<int> last(_runs.size(), -1);
+    for (int k = 1; k <= _numPoints; ++k) {
+        double x = maxX*k/_numPoints;
+        vector<double> costs;
+        for (int r = 0; r < (int)_runs.size(); ++r) {
+            while (last[r]+1 < (int)_runs[r].size() && getX(_runs[r][last[r]+1], _evals) <= x)
+                ++last[r];
+            if (last[r] >= 0)
+                costs.push_back(_runs[r][last[r]].bestCost);
+        }
+        cout << x << "," << costs.size();
+        if (costs.empty())
+            cout << ",,,,";
+        else {
+            sort(costs.begin(), costs.end());
+            double sum = 0;
+            for (double cost : costs)
+                sum += cost;
+            int n = costs.size();
+            double median = (n % 2 == 1) ? costs[n/2] : (costs[n/2-1] + costs[n/2]) / 2;
+            cout << "," << sum/n << "," << costs.front() << "," << median << "," << costs.back();
+        }
+        // Fraction of all the runs, including those without records yet
+        for (double target : _targets)
+            cout << "," << (double)count_if(costs.begin(), costs.end(), [target](double _c) { return _c <= target; }) / _runs.size();
+        cout << endl;
+    }
+}
+
+
+
+int main(int argc, char* argv[])
+{
+    bool evals = false;
+    bool dump = false;
+    int numPoints = 100;
+    vector<double> targets;
+    vector<string> filenames;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--evals")
+            evals = true;
+        else if (arg == "--dump")
+            dump = true;
+        else if (arg == "--points" && i+1 < argc)
+            numPoints = max(1, atoi(argv[++i]));
+        else if (arg == "--target" && i+1 < argc)
+            targets.push_back(atof(argv[++i]));
+        else
+            filenames.push_back(arg);
+    }
+    if (filenames.empty() || (dump && filenames.size() != 1)) {
+        cout << "Usage: ./TraceProfile [--evals] [--points N] [--target COST]...   <trace files>" << endl;
+        cout << "       ./TraceProfile --dump   <trace file>" << endl;
+        cout << "   Example: ./TraceProfile --target 4000 ./Run*/exam_comp_set1.exam.trace > profile.csv" << endl;
+        cout << "   --evals: use the # evaluations instead of the time (in seconds) as x axis" << endl;
+        cout << "   --points: # grid points (default 100)" << endl;
+        cout << "   --target: also give the fraction of runs with best cost <= COST" << endl;
+        cout << "   --dump: write the records of one trace as CSV" << endl;
+        return 1;
+    }
+    try {
+        vector<vector<ConvergenceTraceRecord> > runs;
+        for (auto const &filename : filenames)
+            runs.push_back(ConvergenceTrace::read(filename));
+        if (dump)
+            dumpTrace(runs[0]);
+        else
+            writeProfile(runs, evals, numPoints, targets);
+    }
+    catch (runtime_error const &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
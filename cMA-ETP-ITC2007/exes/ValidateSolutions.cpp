@@ -0,0 +1,132 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <stdexcept>
+#include <cstdlib>
+#include <thread>
+#include "testset/ITC2007TestSet.h"
+#include "chromosome/eoChromosome.h"
+#include "eval/ETTPSolutionValidator.h"
+
+using namespace std;
+
+
+// Scores and checks ITC2007 solution files, written as CSV to the standard output: one line
+// per file with its status (feasible, infeasible or error), its cost, the cost of each soft
+// constraint, and the violated hard constraints. Each instance is loaded once, and its
+// solutions are validated in parallel.
+
+
+// Get the instance name of solution file _filename: its base name without ".sol"
+// (and "_snapshot"), e.g. ./Run1/exam_comp_set1.exam.sol -> exam_comp_set1.exam
+string getInstanceName(string const &_filename) {
+    string name = _filename.substr(_filename.find_last_of("/\\") + 1);
+    for (string suffix : { ".sol", "_snapshot" }) {
+        if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+            name.erase(name.size() - suffix.size());
+    }
+    return name;
+}
+
+
+// Quote CSV field _field
+string quote(string const &_field) {
+    string quoted = "\"";
+    for (char c : _field) {
+        if (c == '"')
+            quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+
+// Write report _report of a solution of instance _instanceName as a CSV line
+void writeReport(SolutionReport const &_report, string const &_instanceName) {
+    cout << quote(_report.filename) << "," << _instanceName << ",";
+    if (!_report.error.empty()) {
+        cout << "error,,,,,,,,,," << quote(_report.error) << endl;
+        return;
+    }
+    SoftConstraintCosts const &c = _report.costs;
+    cout << (_report.isFeasible() ? "feasible" : "infeasible") << "," << _report.cost << ","
+         << c.twoInARow << "," << c.twoInADay << "," << c.periodSpread << "," << c.mixedDurations << ","
+         << c.frontLoad << "," << c.roomPenalty << "," << c.periodPenalty << "," << _report.violations.size() << ",";
+    string details;
+    for (auto const &violation : _report.violations)
+        details += (details.empty() ? "" : "; ") + violation.type + ": " + violation.description;
+    cout << quote(details) << endl;
+}
+
+
+
+int main(int argc, char* argv[])
+{
+    int numThreads = std::thread::hardware_concurrency();
+    string instanceName;
+    vector<string> args;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--threads" && i+1 < argc)
+            numThreads = atoi(argv[++i]);
+        else if (arg == "--instance" && i+1 < argc)
+            instanceName = argv[++i];
+        else
+            args.push_back(arg);
+    }
+    if (args.size() < 2) {
+        cout << "Usage: ./ValidateSolutions [--threads N] [--instance NAME]   <test benchmarks directory>   <solution files>" << endl;
+        cout << "   Example: ./ValidateSolutions ./../../ETTP-Benchmarks/ITC2007 ./Run*/exam_comp_set*.exam.sol > report.csv" << endl;
+        cout << "   --threads: # validation threads (default: # hardware threads)" << endl;
+        cout << "   --instance: instance of all the solutions (default: from each file name, e.g. exam_comp_set1.exam)" << endl;
+        return 1;
+    }
+    string testBenchmarksDir = args[0];
+    // Group the solution files by instance, keeping their order
+    vector<string> instanceNames;
+    map<string, vector<string> > instanceFiles;
+    for (auto it = args.begin()+1; it != args.end(); ++it) {
+        string name = instanceName.empty() ? getInstanceName(*it) : instanceName;
+        if (instanceFiles.find(name) == instanceFiles.end())
+            instanceNames.push_back(name);
+        instanceFiles[name].push_back(*it);
+    }
+
+    cout << "file,instance,status,cost,twoInARow,twoInADay,periodSpread,mixedDurations,frontLoad,roomPenalty,"
+            "periodPenalty,numViolations,violations" << endl;
+    bool allFeasible = true;
+    for (auto const &name : instanceNames) {
+        vector<string> const &filenames = instanceFiles[name];
+        try {
+            ITC2007TestSet testSet(name, name, testBenchmarksDir);
+            // The loading messages go to the standard error, keeping the CSV output clean
+            streambuf *coutBuf = cout.rdbuf(cerr.rdbuf());
+            try {
+                testSet.load();
+            }
+            catch (...) {
+                cout.rdbuf(coutBuf);
+                throw;
+            }
+            cout.rdbuf(coutBuf);
+            ETTPSolutionValidator<eoChromosome> validator(testSet.getTimetableProblemData().get());
+            for (auto const &report : validator.validate(filenames, numThreads)) {
+                writeReport(report, name);
+                allFeasible = allFeasible && report.isFeasible();
+            }
+        }
+        catch (runtime_error const &e) {
+            // The instance couldn't be loaded
+            for (auto const &filename : filenames) {
+                SolutionReport report;
+                report.filename = filename;
+                report.error = e.what();
+                writeReport(report, name);
+            }
+            allFeasible = false;
+        }
+    }
+
+    return allFeasible ? 0 : 2;
+}
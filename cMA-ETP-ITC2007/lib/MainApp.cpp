@@ -1,33 +1,34 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
 
-// Handling Ctrl+c signal
-#include <signal.h>
-
-bool volatile keepRunning = true;
-
-void intHandler(int dummy=0) {
-
-//    std::cout << "Catch signal" << std::endl;
-//    std::cin.get();
-    keepRunning = false;
-}
+// Handling SIGINT, SIGTERM, SIGUSR1 and SIGUSR2 signals
+#include "utils/SignalHandler.h"
+// Run configuration
+#include "utils/CellularEAConfig.h"
 
 using namespace std;
 
 
 
 // Toronto benchmarks
-extern void runITC2007Datasets(int _datasetIndex, string const& _testBenchmarksDir, const string& _outputDir);
+extern void runITC2007Datasets(int _datasetIndex, string const& _testBenchmarksDir, const string& _outputDir, bool _resume,
+                               vector<string> const& _warmStartFiles, CellularEAConfig const& _config);
+
 
+void runAlgo(int _datasetIndex, string const& _testBenchmarksDir, const string& _outputDir, bool _resume,
+             vector<string> const& _warmStartFiles, CellularEAConfig const& _config) {
+    // Invalid parameter combinations are reported before loading the dataset
+    _config.check();
 
-void runAlgo(int _datasetIndex, string const& _testBenchmarksDir, const string& _outputDir) {
-    // Handling Ctrl+c signal
-    signal(SIGINT, intHandler);
+    // Handling stop, snapshot and reload signals. See SignalHandler
+    SignalHandler::install();
 
-    // Run optimization algorithm on the ITC2007 datasets
-    runITC2007Datasets(_datasetIndex, _testBenchmarksDir, _outputDir);
+    // Run optimization algorithm on the ITC2007 datasets. If _resume is set, the
+    // evolution continues from the checkpoint saved in the output directory. Otherwise, the
+    // population may be seeded from the solutions in _warmStartFiles
+    runITC2007Datasets(_datasetIndex, _testBenchmarksDir, _outputDir, _resume, _warmStartFiles, _config);
 }
 
 
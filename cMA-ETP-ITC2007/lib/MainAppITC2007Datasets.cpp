@@ -5,10 +5,13 @@
 #include <vector>
 #include <fstream>
 #include <string>
+#include <climits>
+#include <ctime>
 
 #include "testset/TestSetDescription.h"
 #include "testset/ITC2007TestSet.h"
 #include "init/ETTPInit.h"
+#include "init/ETTPWarmStartInit.h"
 
 #include "neighbourhood/ETTPneighborEval.h"
 #include "eval/eoETTPEval.h"
@@ -19,11 +22,16 @@
 #include "algorithms/eo/eoSelectBestOne.h"
 
 #include "algorithms/eo/eoGenerationContinuePopVector.h"
+#include "algorithms/eo/eoTimeBudgetContinuePopVector.h"
 #include "eoSelectOne.h"
 #include "algorithms/eo/eoDeterministicTournamentSelectorPointer.h" // eoDeterministicTournamentSelector using boost::shared_ptr
 
 // For counting the # evaluations
 #include "eval/eoNumberEvalsCounter.h"
+// Kempe chain adaptive operator selection
+#include "kempeChain/ETTPOperatorSelector.h"
+// Adaptive TA threshold schedule
+#include "algorithms/mo/moAdaptiveCoolingSchedule.h"
 
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
@@ -34,6 +42,8 @@
 
 
 #include "containers/ConflictBasedStatistics.h"
+// Run configuration
+#include "utils/CellularEAConfig.h"
 
 
 using namespace std;
@@ -48,21 +58,53 @@ extern int getSANumberEvaluations(double tmax, double r, double k, double tmin);
 
 
 // These function is defined below
-void runCellularEA(string const& _outputDir, TestSet const& _testSet);
+void runCellularEA(string const& _outputDir, TestSet const& _testSet, bool _resume, vector<string> const& _warmStartFiles,
+                   CellularEAConfig const& _config);
 void generateExamMoveStatistics(const string &_outputDir, const TestSet &_testSet);
 
 
+// Get the cellular topology of name _name ("auto" - Ring for 1-row grids, L5 otherwise)
+static CellularTopology getCellularTopology(string const& _name, int _nlines) {
+    for (CellularTopology topology : { CellularTopology::Ring, CellularTopology::L5, CellularTopology::L9,
+                                       CellularTopology::C9, CellularTopology::C13 }) {
+        if (getCellularTopologyName(topology) == _name)
+            return topology;
+    }
+    return (_nlines == 1) ? CellularTopology::Ring : CellularTopology::L5;
+}
+
+
+// Get the improvement step of configuration value _name
+static ImprovementStep getImprovementStep(string const& _name) {
+    if (_name == "LateAcceptance")
+        return ImprovementStep::LateAcceptance;
+    if (_name == "GreatDeluge")
+        return ImprovementStep::GreatDeluge;
+    return ImprovementStep::ThresholdAccepting;
+}
+
+
 
 ////////////////////////////////////////////////////////
 // ITC 2007 benchmarks
 //
 //
-void runITC2007Datasets(int _datasetIndex, string const& _testBenchmarksDir, string const& _outputDir)
+void runITC2007Datasets(int _datasetIndex, string const& _testBenchmarksDir, string const& _outputDir, bool _resume,
+                        vector<string> const& _warmStartFiles, CellularEAConfig const& _config)
 {
     /// ADDED 25-JAN-2016
     ///
 
-    std::srand(std::time(0)); // Seed random generator used in random_shuffle
+    // Run seed. If it is taken from the clock, it is recorded in the configuration, so the
+    // configuration echoed in the run output replays the run
+    CellularEAConfig config(_config);
+    if (config.getInt("seed") == 0)
+        config.set("seed", to_string(std::max<long>(1, std::time(0) % INT_MAX)));
+    uint32_t seed = static_cast<uint32_t>(config.getInt("seed"));
+    std::srand(seed); // Seed random generator used in random_shuffle
+    // Seed the EO random generator once per run. The graph colouring heuristic, the variation
+    // operators and the local search draw from it, and its state is saved in the checkpoints
+    rng.reseed(seed);
 
 
 //    cout << endl << "Start Date/Time = " << currentDateTime() << endl;
@@ -102,7 +144,7 @@ void runITC2007Datasets(int _datasetIndex, string const& _testBenchmarksDir, str
 #endif
 
     // Run test set
-    runCellularEA(_outputDir, testSet);
+    runCellularEA(_outputDir, testSet, _resume, _warmStartFiles, config);
 }
 
 
@@ -111,54 +153,90 @@ void runITC2007Datasets(int _datasetIndex, string const& _testBenchmarksDir, str
 
 
 
-void runCellularEA(const string &_outputDir, TestSet const& _testSet) {
+void runCellularEA(const string &_outputDir, TestSet const& _testSet, bool _resume, vector<string> const& _warmStartFiles,
+                   CellularEAConfig const& _config) {
     //
-    // cEA parameters
+    // cEA parameters. See CellularEAConfig for their descriptions and default values
     //
 
-
-    ////// Pop size = 16  ////////
-    // Rect
-//    const int NLINES = 2;
-//    const int NCOLS = 8;
-
-
-/// COR2015 Paper
-//    // Matrix
-    const int NLINES = 4;
-    const int NCOLS = 4;
-
-    // Matrix
-//    const int NLINES = 10;
-//    const int NCOLS = 10;
-
-
-//    // Ring
-//    const int NLINES = 1;
-//    const int NCOLS = 16;
-    //////////////////////////////
+    // Population grid
+    const int NLINES = _config.getInt("nlines");
+    const int NCOLS = _config.getInt("ncols");
+    // Neighbourhood of each cell. A 1-row grid is a ring cGA
+    const CellularTopology CELLULAR_TOPOLOGY = getCellularTopology(_config.getString("topology"), NLINES);
 
     const int POP_SIZE = NLINES*NCOLS;  // Population size
-    const int L = 5000000; // Number of generations
+    const int L = _config.getInt("generations"); // Number of generations
+    // Wall-clock time limit in seconds (0 - no time limit, only the number of generations is used)
+    const double TIME_LIMIT = _config.getDouble("timeLimit");
+    // # generations between evolution checkpoints (0 - disabled). A checkpoint is also written on SIGINT/SIGTERM
+    const int CHECKPOINT_INTERVAL = _config.getInt("checkpointInterval");
+    // Generation report cadence: every LOG_INTERVAL generations (0 - disabled), on best solution
+    // improvement, and at least every LOG_PERIOD seconds (0 - disabled)
+    const int LOG_INTERVAL = _config.getInt("logInterval");
+    const bool LOG_ON_IMPROVEMENT = _config.getBool("logOnImprovement");
+    const double LOG_PERIOD = _config.getDouble("logPeriod");
+    // Warm start. When solution files are given, they seed some cells (the best ones, if there are
+    // more files than cells). WARM_START_PERTURBED_FRACTION of the other cells are copies of the
+    // seeds perturbed by WARM_START_NUM_PERTURBATIONS mutations; the rest are built from scratch
+    const double WARM_START_PERTURBED_FRACTION = _config.getDouble("warmStartPerturbedFraction");
+    const int WARM_START_NUM_PERTURBATIONS = _config.getInt("warmStartNumPerturbations");
+    // Time limit multiplier: (local ITC2007 benchmark program time) / (ITC2007 benchmark machine time)
+    const double MACHINE_SPEED_FACTOR = _config.getDouble("machineSpeedFactor");
 
     // Crossover probability
-    const double cp = 0;
-
+    const double cp = _config.getDouble("cp");
     // Mutation probability
-//    const double mp = 1;
-//        const double mp = 0.5;
-    const double mp = 0.1;
-//    const double mp = 0.01;
-//    const double mp = 0;
-
+    const double mp = _config.getDouble("mp");
     // Improve probability
-    const double ip = 0.1;
-//    const double ip = 0.5;
-//      const double ip = 1;
-//      const double ip = 0;
-
-    // TA parameters
-    moSimpleCoolingSchedule<eoChromosome> coolSchedule(10, 0.001, 5, 2e-4);
+    const double ip = _config.getDouble("ip");
+
+    // TA parameters. The adaptive threshold schedule speeds up cooling when nearly every move
+    // is accepted, holds the threshold when the search is productive and reheats on stagnation
+    boost::shared_ptr<moSimpleCoolingSchedule<eoChromosome> > coolSchedulePtr;
+    if (_config.getString("coolingSchedule") == "adaptive")
+        coolSchedulePtr = boost::make_shared<moAdaptiveCoolingSchedule<eoChromosome> >(
+                    _config.getDouble("initT"), _config.getDouble("alpha"), _config.getInt("span"), _config.getDouble("finalT"));
+    else
+        coolSchedulePtr = boost::make_shared<moSimpleCoolingSchedule<eoChromosome> >(
+                    _config.getDouble("initT"), _config.getDouble("alpha"), _config.getInt("span"), _config.getDouble("finalT"));
+    moSimpleCoolingSchedule<eoChromosome> &coolSchedule = *coolSchedulePtr.get();
+    // # neighbours evaluated per TA iteration (1 - one random neighbour per iteration)
+    const int TA_BATCH_SIZE = _config.getInt("taBatchSize");
+    // Candidate submitted to the threshold test when TA_BATCH_SIZE > 1
+    const BatchAcceptance TA_BATCH_ACCEPTANCE = (_config.getString("taBatchAcceptance") == "FirstAcceptable")
+            ? BatchAcceptance::FirstAcceptable : BatchAcceptance::BestCandidate;
+    // # threads of the speculative TA (1 - sequential TA). If > 1, TA_BATCH_SIZE is ignored
+    const int TA_NUM_THREADS = (_config.getInt("taNumThreads") > 0) ? _config.getInt("taNumThreads")
+                                                                    : std::max(1u, std::thread::hardware_concurrency());
+
+    // Local search of the improvement step. Late Acceptance and Great Deluge
+    // run for the nominal # iterations of the TA cooling schedule
+    const ImprovementStep IMPROVEMENT_STEP = getImprovementStep(_config.getString("improvementStep"));
+    // Late Acceptance history length
+    const int LAHC_HISTORY_LENGTH = _config.getInt("lahcHistoryLength");
+    // Great Deluge target cost, as a fraction of the initial cost
+    const double GD_TARGET_RATIO = _config.getDouble("gdTargetRatio");
+    // # entries of the cache of local search outcomes, keyed by the solution Zobrist hash.
+    // Duplicate solutions take the cached outcome instead of being improved again (0 - disabled)
+    const int TA_CACHE_SIZE = (_config.getInt("taCacheSize") >= 0) ? _config.getInt("taCacheSize") : 2*POP_SIZE;
+    // Diversity. Distances are # exams scheduled in different periods, as a fraction of the # exams.
+    // An offspring within MIN_REPLACEMENT_DISTANCE of another, not worse, cell does not replace the
+    // current individual. When the population mean distance drops below RESTART_DISTANCE, at most
+    // RESTART_FRACTION of the cells, among those converged to the best one, are re-seeded (0 - disabled)
+    const double MIN_REPLACEMENT_DISTANCE = _config.getDouble("minReplacementDistance");
+    const double RESTART_DISTANCE = _config.getDouble("restartDistance");
+    const double RESTART_FRACTION = _config.getDouble("restartFraction");
+
+    // Kempe chain operator selection policy
+    boost::shared_ptr<OperatorSelectionPolicy> operatorSelectionPolicy;
+    if (_config.getString("operatorSelection") == "Uniform")
+        operatorSelectionPolicy = boost::make_shared<UniformOperatorSelection>();
+    else
+        operatorSelectionPolicy = boost::make_shared<AdaptivePursuitOperatorSelection>(
+                    _config.getDouble("apPMin"), _config.getDouble("apAlpha"), _config.getDouble("apBeta"));
+    boost::shared_ptr<ETTPOperatorSelector> operatorSelector = boost::make_shared<ETTPOperatorSelector>(
+                operatorSelectionPolicy, ETTPKempeChainHeuristic<eoChromosome>::getOperatorNames());
 
 
     // Creating the output file in the specified output directory
@@ -170,7 +248,14 @@ void runCellularEA(const string &_outputDir, TestSet const& _testSet) {
 
     string filename;
     sstream >> filename;
-    ofstream outFile(filename);
+
+    // Evolution checkpoint. If resuming and the checkpoint exists, the evolution continues from it
+    // and the output file is appended to
+    string checkpointFilename = _outputDir + _testSet.getName() + ".ckpt";
+    bool resume = _resume && ifstream(checkpointFilename).good();
+    if (_resume && !resume)
+        cout << "Checkpoint " << checkpointFilename << " not found. Starting a new run" << endl;
+    ofstream outFile(filename, resume ? ios::app : ios::trunc);
 
     cout << "Start Date/Time = " << currentDateTime() << endl;
     // Write Start time and algorithm parameters to file
@@ -181,26 +266,64 @@ void runCellularEA(const string &_outputDir, TestSet const& _testSet) {
     outFile << _testSet << endl;
     // getSANumberEvaluations(double tmax, double r, double k, double tmin)
     long numEvalsTA = getSANumberEvaluations(coolSchedule.initT, coolSchedule.alpha,
-                                             coolSchedule.span, coolSchedule.finalT);
+                                             coolSchedule.span, coolSchedule.finalT)*(TA_NUM_THREADS > 1 ? 1 : TA_BATCH_SIZE);
     /////////////////////////// Writing the cGA parameters ////////////////////////////////////////////////////////
     cout << "cGA parameters:" << endl;
-    cout << "NLINES = " << NLINES << ", NCOLS = " << NCOLS << endl;
+    cout << "NLINES = " << NLINES << ", NCOLS = " << NCOLS << ", topology: " << getCellularTopologyName(CELLULAR_TOPOLOGY) << endl;
     cout << "cp = " << cp << ", mp = " << mp << ", ip = " << ip << endl;
+    cout << "Improvement step: " << getImprovementStepName(IMPROVEMENT_STEP) << endl;
+    cout << "LAHC history length: " << LAHC_HISTORY_LENGTH << ", GD target ratio: " << GD_TARGET_RATIO << endl;
     cout << "TA parameters:" << endl;
-    cout << "cooling schedule: " << coolSchedule.initT << ", " << coolSchedule.alpha << ", "
+    cout << "cooling schedule (" << coolSchedule.className() << "): " << coolSchedule.initT << ", " << coolSchedule.alpha << ", "
             << coolSchedule.span << ", " << coolSchedule.finalT << endl;
+    cout << "TA batch size: " << TA_BATCH_SIZE << ", TA # threads: " << TA_NUM_THREADS << endl;
+    cout << "TA cache size: " << TA_CACHE_SIZE << endl;
+    cout << "Min. replacement distance: " << MIN_REPLACEMENT_DISTANCE << ", restart distance: " << RESTART_DISTANCE
+         << ", restart fraction: " << RESTART_FRACTION << endl;
     cout << "# evals per TA local search: " << numEvalsTA << endl;
+    cout << "Time limit: " << TIME_LIMIT << " s, machine speed factor: " << MACHINE_SPEED_FACTOR << endl;
+    cout << "Operator selection policy: " << operatorSelectionPolicy->className() << endl;
     ///
     outFile << "cGA parameters:" << endl;
-    outFile << "NLINES = " << NLINES << ", NCOLS = " << NCOLS << endl;
+    outFile << "NLINES = " << NLINES << ", NCOLS = " << NCOLS << ", topology: " << getCellularTopologyName(CELLULAR_TOPOLOGY) << endl;
     outFile << "cp = " << cp << ", mp = " << mp << ", ip = " << ip << endl;
+    outFile << "Improvement step: " << getImprovementStepName(IMPROVEMENT_STEP) << endl;
+    outFile << "LAHC history length: " << LAHC_HISTORY_LENGTH << ", GD target ratio: " << GD_TARGET_RATIO << endl;
     outFile << "TA parameters:" << endl;
-    outFile << "cooling schedule: " << coolSchedule.initT << ", " << coolSchedule.alpha << ", "
+    outFile << "cooling schedule (" << coolSchedule.className() << "): " << coolSchedule.initT << ", " << coolSchedule.alpha << ", "
             << coolSchedule.span << ", " << coolSchedule.finalT << endl;
+    outFile << "TA batch size: " << TA_BATCH_SIZE << ", TA # threads: " << TA_NUM_THREADS << endl;
+    outFile << "TA cache size: " << TA_CACHE_SIZE << endl;
+    outFile << "Min. replacement distance: " << MIN_REPLACEMENT_DISTANCE << ", restart distance: " << RESTART_DISTANCE
+            << ", restart fraction: " << RESTART_FRACTION << endl;
     outFile << "# evals per TA local search: " << numEvalsTA << endl;
+    outFile << "Time limit: " << TIME_LIMIT << " s, machine speed factor: " << MACHINE_SPEED_FACTOR << endl;
+    outFile << "Operator selection policy: " << operatorSelectionPolicy->className() << endl;
+    outFile << "Log cadence: every " << LOG_INTERVAL << " generations, on improvement: " << LOG_ON_IMPROVEMENT
+            << ", every " << LOG_PERIOD << " s" << endl;
+    // Full configuration, in the configuration file format, so the run can be repeated with --config
+    cout << "Configuration:" << endl;
+    _config.write(cout);
+    outFile << "Configuration:" << endl;
+    _config.write(outFile);
     //////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Solution initializer
     ETTPInit<eoChromosome> init(_testSet.getTimetableProblemData().get());
+    // Warm start initializer. The solution files are read and validated here
+    Mutation<eoChromosome> warmStartPerturbation;
+    boost::shared_ptr<ETTPWarmStartInit<eoChromosome> > warmStartInit;
+    if (!_warmStartFiles.empty() && !resume) {
+        warmStartInit = boost::make_shared<ETTPWarmStartInit<eoChromosome> >(
+                    _testSet.getTimetableProblemData().get(), _warmStartFiles, init, warmStartPerturbation,
+                    POP_SIZE, WARM_START_PERTURBED_FRACTION, WARM_START_NUM_PERTURBATIONS);
+        cout << "Warm start from " << warmStartInit->getNumSeeds() << " solution(s)" << endl;
+        outFile << "Warm start from " << warmStartInit->getNumSeeds() << " solution(s):";
+        for (auto const &filename : _warmStartFiles)
+            outFile << " " << filename;
+        outFile << endl;
+    }
+    // Initializer of the initial population. Restarted cells are always built from scratch
+    eoInit<eoChromosome> &popInit = warmStartInit ? static_cast<eoInit<eoChromosome> &>(*warmStartInit.get()) : init;
     // Generate initial population
 //    eoPop<eoChromosome> pop(POP_SIZE, init);
       // We can't work with eoPop of shared_ptr because shared_ptr is not an EO
@@ -212,8 +335,9 @@ void runCellularEA(const string &_outputDir, TestSet const& _testSet) {
     for (int i = 0; i < POP_SIZE; ++i) {
         // Create solution object and insert it in the vector
         solutionPop.push_back(boost::shared_ptr<eoChromosome>(new eoChromosome(_testSet.getTimetableProblemData().get())));
-        // Initialize chromosome
-        init(*solutionPop[i].get());
+        // Initialize chromosome. When resuming, the cells are loaded from the checkpoint
+        if (!resume)
+            popInit(*solutionPop[i].get());
     }
 
     // # evaluations counter
@@ -221,7 +345,7 @@ void runCellularEA(const string &_outputDir, TestSet const& _testSet) {
     // Objective function evaluation
     eoETTPEval<eoChromosome> eval;
     // Objective function evaluation
-    for (int i = 0; i < solutionPop.size(); ++i) {
+    for (int i = 0; i < solutionPop.size() && !resume; ++i) {
         eval(*solutionPop[i].get());
     }
 
@@ -229,28 +353,37 @@ void runCellularEA(const string &_outputDir, TestSet const& _testSet) {
     /////////////////////////////////////////////////////////////////////////////////
     // Print population information to output and
     // save population information into file
-    std::cout << std::endl << "Initial population" << std::endl;
-    outFile << std::endl << "Initial population" << std::endl;
-    int k = 0;
-    for (int i = 0; i < NLINES; ++i) {
-        for (int j = 0; j < NCOLS; ++j, ++k) {
-            std::cout << (*solutionPop[k].get()).fitness() << "\t";
-            outFile << (*solutionPop[k].get()).fitness() << "\t";
+    if (!resume) {
+        std::cout << std::endl << "Initial population" << std::endl;
+        outFile << std::endl << "Initial population" << std::endl;
+        int k = 0;
+        for (int i = 0; i < NLINES; ++i) {
+            for (int j = 0; j < NCOLS; ++j, ++k) {
+                std::cout << (*solutionPop[k].get()).fitness() << "\t";
+                outFile << (*solutionPop[k].get()).fitness() << "\t";
+            }
+            std::cout << std::endl;
+            outFile << std::endl;
         }
-        std::cout << std::endl;
-        outFile << std::endl;
     }
     /////////////////////////////////////////////////////////////////////////////////
 
     //
     // Build CellularGA
     //
-    // Terminate after concluding L time loops or 'Ctrl+C' signal is received
+    // Terminate after concluding L time loops. SIGINT/SIGTERM are handled by the cGA
 //    eoGenerationContinue<eoChromosome> terminator(L);
 //    eoCheckPoint<eoChromosome> checkpoint(terminator);
     // The eoGenerationContinuePopVector object, instead of using an eoPop to represent the population,
     // uses a vector. A vector is used in order to swap offspring and population efficiently using pointers
-    eoGenerationContinuePopVector<eoChromosome> terminator(L);
+    // If a time limit is given, the run also stops when the time budget is spent, and the TA
+    // cooling schedule is rescaled according to the throughput measured in the first seconds
+    boost::shared_ptr<eoGenerationContinuePopVector<eoChromosome> > terminator;
+    if (TIME_LIMIT > 0)
+        terminator = boost::make_shared<eoTimeBudgetContinuePopVector<eoChromosome> >(
+                    TIME_LIMIT, coolSchedule, numEvalCounter, L, MACHINE_SPEED_FACTOR);
+    else
+        terminator = boost::make_shared<eoGenerationContinuePopVector<eoChromosome> >(L);
 
     // Declare 1-selectors
     //
@@ -265,15 +398,12 @@ void runCellularEA(const string &_outputDir, TestSet const& _testSet) {
     eoSelectBestOne<eoChromosome> selectBestOne;
 
     boost::shared_ptr<eoCellularEA<eoChromosome> > cGA;
-    // Build the corresponding type of cGA object depending on the layout (Ring or Matrix)
-    if (NLINES == 1) { // Ring cGA
-        /// NOT IMPLEMENTED
-    }
-    else {
+    // Build the cGA object. The layout (Ring or Matrix) is given by the cellular topology
+    {
         cGA = boost::make_shared<eoCellularEAMatrix<eoChromosome> >(
                     outFile, NLINES, NCOLS,
                     cp, mp, ip, coolSchedule,
-                    terminator,
+                    *terminator,
 //                    checkpoint,
                     eval,
 //                    detSelectNeighbour,
@@ -281,11 +411,36 @@ void runCellularEA(const string &_outputDir, TestSet const& _testSet) {
                     crossover, mutation,
                     selectBestOne, // To choose one from the both children
                     selectBestOne,  // Which to keep between the new child and the old individual?
-                    numEvalCounter
+                    numEvalCounter,
+                    operatorSelector,
+                    TA_BATCH_SIZE,
+                    TA_BATCH_ACCEPTANCE,
+                    TA_NUM_THREADS,
+                    IMPROVEMENT_STEP,
+                    LAHC_HISTORY_LENGTH,
+                    GD_TARGET_RATIO,
+                    TA_CACHE_SIZE,
+                    &init,
+                    MIN_REPLACEMENT_DISTANCE,
+                    RESTART_DISTANCE,
+                    RESTART_FRACTION,
+                    CELLULAR_TOPOLOGY
         );
 
     }
 
+    // Save the evolution state periodically and continue from the checkpoint if resuming
+    cGA->setCheckpoint(checkpointFilename, CHECKPOINT_INTERVAL);
+    cGA->setResume(resume);
+    // On SIGUSR1 the best solution is written into <instance>_snapshot.sol. On SIGUSR2 the
+    // cp, mp, ip, initT, alpha, span and finalT parameters are reloaded from <instance>.params,
+    // a file of "key = value" lines
+    cGA->setSnapshotFile(_outputDir + _testSet.getName() + "_snapshot.sol");
+    cGA->setParametersFile(_outputDir + _testSet.getName() + ".params");
+    cGA->setLogCadence(LOG_INTERVAL, LOG_ON_IMPROVEMENT, LOG_PERIOD);
+    // Convergence trace of every generation, read by the TraceProfile tool
+    cGA->setTraceFile(_outputDir + _testSet.getName() + ".trace");
+
     // Run the algorithm
     (*cGA.get())(pop);
 
@@ -0,0 +1,468 @@
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <cstdio>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "testset/ITC2007TestSet.h"
+#include "chromosome/eoChromosome.h"
+#include "eval/ETTPSolutionValidator.h"
+#include "utils/CellularEAConfig.h"
+#include "utils/ParameterFile.h"
+#include "utils/FriedmanRace.h"
+#include "utils/CurrentDateTime.h"
+
+#include <boost/shared_ptr.hpp>
+
+
+using namespace std;
+
+
+
+// Defined in MainApp.cpp
+extern void runAlgo(int _datasetIndex, string const& _testBenchmarksDir, const string& _outputDir, bool _resume,
+                    vector<string> const& _warmStartFiles, CellularEAConfig const& _config);
+
+
+namespace {
+
+// # ITC2007 datasets
+const int NUM_DATASETS = 12;
+
+
+/**
+ * @brief The RacingOptions struct Racing options of the tuning file
+ */
+struct RacingOptions {
+    RacingOptions()
+        : numCandidates(24), runTime(60), maxBlocks(0), numJobs(0), seed(1),
+          significance(0.05), firstTest(5), minSurvivors(1) {
+        for (int d = 1; d <= NUM_DATASETS; ++d)
+            datasets.push_back(d);
+    }
+    int numCandidates; // # configurations, including the base one
+    double runTime; // Time limit of each run (seconds)
+    vector<int> datasets; // Datasets [1..12] of the blocks, in order
+    int maxBlocks; // Maximum # blocks (0 - two per dataset)
+    int numJobs; // # parallel runs (0 - # hardware threads / # threads of a run)
+    unsigned seed; // Seed of the configuration sampling and of the runs
+    double significance; // Significance level of the racing tests
+    int firstTest; // # blocks before the first test
+    int minSurvivors; // The race stops when only this # candidates remain
+};
+
+
+/**
+ * @brief The SampledParameter struct Configuration parameter sampled by the tuner: uniformly
+ * (or log-uniformly) in [min, max] if it is numeric, among values otherwise
+ */
+struct SampledParameter {
+    string key;
+    double min, max;
+    bool logScale;
+    vector<string> values;
+};
+
+
+// Split _s at blanks and commas
+vector<string> splitValues(string const &_s) {
+    vector<string> tokens;
+    string token;
+    istringstream in(_s);
+    while (getline(in, token, ',')) {
+        istringstream words(token);
+        string word;
+        while (words >> word)
+            tokens.push_back(word);
+    }
+    return tokens;
+}
+
+
+// Format number _x without losing small values
+string formatNumber(double _x) {
+    ostringstream os;
+    os << _x;
+    return os.str();
+}
+
+
+// Parse number _value of option _key. Throws std::runtime_error if it is malformed
+double parseNumber(string const &_key, string const &_value) {
+    char *end;
+    double number = strtod(_value.c_str(), &end);
+    if (_value.empty() || *end != '\0')
+        throw runtime_error("invalid number for " + _key + ": " + _value);
+    return number;
+}
+
+
+/**
+ * @brief readTuningFile Read tuning file _filename: racing options and sampled parameters
+ * @param _filename
+ * @param _baseConfig Used to check the sampled parameters
+ * @param _options
+ * @param _parameters
+ */
+void readTuningFile(string const &_filename, CellularEAConfig const &_baseConfig,
+                    RacingOptions &_options, vector<SampledParameter> &_parameters) {
+    ParameterFile file;
+    file.load(_filename);
+    for (auto const &key : file.getKeys()) {
+        string value = file.getString(key, "");
+        try {
+            if (key == "candidates")
+                _options.numCandidates = max(1, (int)parseNumber(key, value));
+            else if (key == "runTime") {
+                _options.runTime = parseNumber(key, value);
+                if (_options.runTime <= 0)
+                    throw runtime_error("runTime must be > 0");
+            }
+            else if (key == "maxBlocks")
+                _options.maxBlocks = (int)parseNumber(key, value);
+            else if (key == "jobs")
+                _options.numJobs = (int)parseNumber(key, value);
+            else if (key == "seed")
+                _options.seed = (unsigned)parseNumber(key, value);
+            else if (key == "significance")
+                _options.significance = parseNumber(key, value);
+            else if (key == "firstTest")
+                _options.firstTest = (int)parseNumber(key, value);
+            else if (key == "survivors")
+                _options.minSurvivors = max(1, (int)parseNumber(key, value));
+            else if (key == "datasets") {
+                _options.datasets.clear();
+                for (auto const &token : splitValues(value)) {
+                    int d = (int)parseNumber(key, token);
+                    if (d < 1 || d > NUM_DATASETS)
+                        throw runtime_error("datasets must be in [1.." + to_string(NUM_DATASETS) + "]");
+                    _options.datasets.push_back(d);
+                }
+                if (_options.datasets.empty())
+                    throw runtime_error("no datasets");
+            }
+            else {
+                // Sampled configuration parameter
+                SampledParameter param = { key, 0, 0, false, splitValues(value) };
+                CellularEAConfig config = _baseConfig;
+                if (_baseConfig.isNumeric(key)) {
+                    if (param.values.size() < 2 || param.values.size() > 3 || (param.values.size() == 3 && param.values[2] != "log"))
+                        throw runtime_error("expected 'min max [log]' for " + key);
+                    param.min = parseNumber(key, param.values[0]);
+                    param.max = parseNumber(key, param.values[1]);
+                    param.logScale = param.values.size() == 3;
+                    if (param.min > param.max || (param.logScale && param.min <= 0))
+                        throw runtime_error("invalid range for " + key);
+                    param.values.clear();
+                    // Both ends must be valid values
+                    config.set(key, formatNumber(param.min));
+                    config.set(key, formatNumber(param.max));
+                }
+                else {
+                    if (param.values.empty())
+                        throw runtime_error("no values for " + key);
+                    for (auto const &v : param.values)
+                        config.set(key, v);
+                }
+                _parameters.push_back(param);
+            }
+        }
+        catch (runtime_error const &e) {
+            throw runtime_error(_filename + ":" + to_string(file.getLine(key)) + ": " + e.what());
+        }
+    }
+    if (_options.maxBlocks <= 0)
+        _options.maxBlocks = 2*_options.datasets.size();
+}
+
+
+/**
+ * @brief sampleConfigurations Sample the candidate configurations. The first one is the base configuration
+ * @param _baseConfig
+ * @param _parameters
+ * @param _options
+ * @return The candidates
+ */
+vector<CellularEAConfig> sampleConfigurations(CellularEAConfig const &_baseConfig, vector<SampledParameter> const &_parameters,
+                                              RacingOptions const &_options) {
+    vector<CellularEAConfig> candidates(1, _baseConfig);
+    std::mt19937 gen(_options.seed);
+    for (int attempt = 0; (int)candidates.size() < _options.numCandidates; ++attempt) {
+        if (attempt >= 100*_options.numCandidates)
+            throw runtime_error("most sampled configurations are invalid. Check the parameter ranges");
+        CellularEAConfig config = _baseConfig;
+        for (auto const &param : _parameters) {
+            string value;
+            if (!param.values.empty())
+                value = param.values[std::uniform_int_distribution<int>(0, param.values.size()-1)(gen)];
+            else {
+                double x = param.logScale
+                        ? exp(std::uniform_real_distribution<double>(log(param.min), log(param.max))(gen))
+                        : std::uniform_real_distribution<double>(param.min, param.max)(gen);
+                x = min(max(x, param.min), param.max);
+                value = _baseConfig.isInteger(param.key) ? to_string(lround(x)) : formatNumber(x);
+            }
+            config.set(param.key, value);
+        }
+        // Combinations such as initT < finalT are sampled again
+        try {
+            config.check();
+        }
+        catch (runtime_error const &) {
+            continue;
+        }
+        candidates.push_back(config);
+    }
+    return candidates;
+}
+
+
+// Get the # threads of a run of configuration _config
+int getNumRunThreads(CellularEAConfig const &_config) {
+    int numThreads = _config.getInt("taNumThreads");
+    return (numThreads > 0) ? numThreads : max(1u, std::thread::hardware_concurrency());
+}
+
+
+// Get the seed of the run of candidate _candidate in block _block. It depends only on the
+// racing seed and on the block and candidate indexes, so the race is reproducible
+int getRunSeed(unsigned _seed, int _block, int _candidate) {
+    // SplitMix64 finaliser
+    uint64_t x = ((uint64_t)_seed << 32) ^ ((uint64_t)_block << 16) ^ (uint64_t)_candidate;
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    // The seed parameter is in [1, INT_MAX] (0 - from the clock)
+    return (int)(x % INT_MAX) + 1;
+}
+
+
+// Create directory _dir, if it doesn't exist
+void makeDirectory(string const &_dir) {
+    if (mkdir(_dir.c_str(), 0755) != 0 && errno != EEXIST)
+        throw runtime_error("couldn't create directory " + _dir);
+}
+
+
+// Get the instance name of dataset _dataset [1..12]
+string getDatasetName(int _dataset) {
+    return "exam_comp_set" + to_string(_dataset) + ".exam";
+}
+
+
+/**
+ * @brief startRun Run configuration _config on dataset _dataset in a child process. Its output
+ * files are written into _runDir, and its console output into _runDir/run.log
+ * @return The child process id
+ */
+pid_t startRun(CellularEAConfig const &_config, int _dataset, string const &_testBenchmarksDir, string const &_runDir) {
+    // Buffered output would be written again by the child
+    cout.flush();
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0)
+        throw runtime_error("couldn't start a tuning run");
+    if (pid > 0)
+        return pid;
+    // Child process
+    int fd = open((_runDir + "run.log").c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+    }
+    int exitCode = 0;
+    try {
+        runAlgo(_dataset-1, _testBenchmarksDir, _runDir, false, vector<string>(), _config);
+    }
+    catch (exception const &e) {
+        cout << "Error: " << e.what() << endl;
+        exitCode = 1;
+    }
+    cout.flush();
+    fflush(stdout);
+    _exit(exitCode);
+}
+
+}
+
+
+
+/**
+ * @brief runRacing Tune the cEA parameters by racing (see FriedmanRace). Candidate configurations
+ * are sampled around _baseConfig, and raced on short runs of the ITC2007 datasets, run in parallel
+ * child processes. The run costs are the validated costs of the solutions written by the runs
+ * (infeasible or missing solutions lose against any feasible one).
+ *
+ * The tuning file has "key = value" lines. Keys which are cEA parameters (see CellularEAConfig)
+ * are sampled: numeric ones as "min max" or "min max log" (log-uniform), the others among a list
+ * of values. The other keys are racing options: candidates, runTime (seconds per run), datasets
+ * (list of dataset numbers, in block order), maxBlocks, jobs, seed, significance, firstTest and
+ * survivors. Each run is seeded from the racing seed and its block and candidate indexes. The surviving configurations are written into _outputDir as race_survivor_<k>.cfg,
+ * by mean rank, and can be run with --config
+ * @param _testBenchmarksDir
+ * @param _outputDir
+ * @param _baseConfig
+ * @param _tuningFilename
+ */
+void runRacing(string const& _testBenchmarksDir, string const& _outputDir, CellularEAConfig const& _baseConfig,
+               string const& _tuningFilename) {
+    RacingOptions options;
+    vector<SampledParameter> parameters;
+    readTuningFile(_tuningFilename, _baseConfig, options, parameters);
+    // Short runs, without checkpoints
+    CellularEAConfig runConfig = _baseConfig;
+    runConfig.set("timeLimit", formatNumber(options.runTime));
+    runConfig.set("checkpointInterval", "0");
+    vector<CellularEAConfig> candidates = sampleConfigurations(runConfig, parameters, options);
+    int numCandidates = candidates.size();
+    // By default, the parallel runs use the hardware threads without oversubscribing them,
+    // including the threads of the speculative TA
+    if (options.numJobs <= 0) {
+        int numRunThreads = 1;
+        for (auto const &candidate : candidates)
+            numRunThreads = max(numRunThreads, getNumRunThreads(candidate));
+        options.numJobs = max(1, (int)std::thread::hardware_concurrency() / numRunThreads);
+    }
+
+    makeDirectory(_outputDir);
+    string raceDir = _outputDir + "race/";
+    makeDirectory(raceDir);
+    ofstream logFile(_outputDir + "race.txt");
+    auto log = [&logFile](string const &_message) {
+        cout << _message << endl;
+        logFile << _message << endl;
+    };
+    ofstream runsFile(_outputDir + "race_runs.csv");
+    runsFile << "block,dataset,candidate,status,cost" << endl;
+
+    ostringstream header;
+    header << "Racing start Date/Time = " << currentDateTime() << endl
+           << numCandidates << " candidates, " << options.runTime << " s per run, " << options.numJobs
+           << " parallel runs, at most " << options.maxBlocks << " blocks, significance " << options.significance;
+    log(header.str());
+
+    // Instances, used to validate the solutions of the runs. They are loaded before the
+    // race, so missing datasets are reported at once
+    map<int, boost::shared_ptr<ITC2007TestSet> > testSets;
+    for (int dataset : options.datasets) {
+        if (testSets.find(dataset) != testSets.end())
+            continue;
+        boost::shared_ptr<ITC2007TestSet> testSet(new ITC2007TestSet(getDatasetName(dataset), getDatasetName(dataset),
+                                                                     _testBenchmarksDir));
+        // The loading messages are not shown
+        streambuf *coutBuf = cout.rdbuf(nullptr);
+        try {
+            testSet->load();
+        }
+        catch (...) {
+            cout.rdbuf(coutBuf);
+            throw;
+        }
+        cout.rdbuf(coutBuf);
+        testSets[dataset] = testSet;
+    }
+
+    FriedmanRace race(numCandidates, options.significance, options.firstTest);
+    for (int block = 1; block <= options.maxBlocks && (int)race.getAlive().size() > options.minSurvivors; ++block) {
+        int dataset = options.datasets[(block-1) % options.datasets.size()];
+        string instanceName = getDatasetName(dataset);
+        ETTPSolutionValidator<eoChromosome> validator(testSets[dataset]->getTimetableProblemData().get());
+
+        // Run the remaining candidates, at most numJobs at a time
+        vector<int> alive = race.getAlive();
+        vector<double> costs(numCandidates, INFINITY);
+        map<pid_t, int> running;
+        size_t next = 0;
+        while (next < alive.size() || !running.empty()) {
+            while (next < alive.size() && (int)running.size() < options.numJobs) {
+                int c = alive[next++];
+                string runDir = raceDir + "b" + to_string(block) + "_c" + to_string(c) + "/";
+                makeDirectory(runDir);
+                CellularEAConfig config = candidates[c];
+                config.set("seed", to_string(getRunSeed(options.seed, block, c)));
+                running[startRun(config, dataset, _testBenchmarksDir, runDir)] = c;
+            }
+            int status;
+            pid_t pid = waitpid(-1, &status, 0);
+            if (pid < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw runtime_error("lost the tuning runs");
+            }
+            auto it = running.find(pid);
+            if (it == running.end())
+                continue;
+            int c = it->second;
+            running.erase(it);
+            string runDir = raceDir + "b" + to_string(block) + "_c" + to_string(c) + "/";
+            SolutionReport report = validator.validate(runDir + instanceName + ".sol");
+            bool succeeded = WIFEXITED(status) && WEXITSTATUS(status) == 0 && report.isFeasible();
+            if (succeeded)
+                costs[c] = report.cost;
+            runsFile << block << "," << dataset << "," << c << "," << (succeeded ? "ok" : "failed") << ","
+                     << (succeeded ? to_string(report.cost) : "") << endl;
+        }
+
+        vector<int> dropped = race.addBlock(costs);
+        ostringstream message;
+        message << "Block " << block << " (dataset " << dataset << "): " << alive.size() << " candidates, best cost "
+                << *min_element(costs.begin(), costs.end());
+        if (!dropped.empty()) {
+            message << ", dropped:";
+            for (int c : dropped)
+                message << " " << c;
+        }
+        log(message.str());
+    }
+
+    // Survivors, by mean rank
+    vector<int> survivors = race.getAlive();
+    stable_sort(survivors.begin(), survivors.end(), [&race](int _a, int _b) { return race.getMeanRank(_a) < race.getMeanRank(_b); });
+    ostringstream summary;
+    summary << survivors.size() << " surviving candidate(s) after " << race.getNumBlocks() << " blocks:";
+    for (int k = 0; k < (int)survivors.size(); ++k) {
+        int c = survivors[k];
+        string filename = _outputDir + "race_survivor_" + to_string(k+1) + ".cfg";
+        // The survivors are written with the time limit and checkpoints of the base configuration
+        CellularEAConfig survivor = candidates[c];
+        survivor.set("timeLimit", _baseConfig.getString("timeLimit"));
+        survivor.set("checkpointInterval", _baseConfig.getString("checkpointInterval"));
+        ofstream cfgFile(filename);
+        cfgFile << "# Candidate " << c << ", mean rank " << race.getMeanRank(c) << " over " << race.getNumBlocks() << " blocks" << endl;
+        survivor.write(cfgFile);
+        summary << endl << "  " << filename << ": candidate " << c << ", mean rank " << race.getMeanRank(c);
+    }
+    log(summary.str());
+    // All the candidates and their sampled parameters
+    ofstream candidatesFile(_outputDir + "race_candidates.csv");
+    candidatesFile << "candidate,droppedAtBlock,meanRank";
+    for (auto const &param : parameters)
+        candidatesFile << "," << param.key;
+    candidatesFile << endl;
+    for (int c = 0; c < numCandidates; ++c) {
+        candidatesFile << c << "," << (race.isAlive(c) ? "" : to_string(race.getDroppedAtBlock(c))) << "," << race.getMeanRank(c);
+        for (auto const &param : parameters)
+            candidatesFile << "," << candidates[c].getString(param.key);
+        candidatesFile << endl;
+    }
+    log("Racing end Date/Time = " + currentDateTime());
+}
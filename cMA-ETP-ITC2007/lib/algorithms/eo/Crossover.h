@@ -4,7 +4,7 @@
 
 /**
   *
-  * Crossover was not implemented in cMA applied to ITC 2007
+  * Period-based crossover for the ITC 2007 examination timetabling problem
   *
   */
 
@@ -12,7 +12,14 @@
 #include "chromosome/eoChromosome.h"
 #include <eoOp.h>
 #include "kempeChain/ETTPKempeChainHeuristic.h"
+#include "kempeChain/ETTPPeriodScorer.h"
 #include <utility>
+#include <tuple>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
 #include <boost/unordered_map.hpp>
 #include "neighbourhood/ETTPneighborhood.h"
 #include "algorithms/mo/moTA.h"
@@ -21,16 +28,55 @@
 #include "testset/TestSetDescription.h"
 #include <eoGenContinue.h>
 #include <utils/eoCheckPoint.h>
+#include <utils/eoRNG.h>
 
 // For debugging purposes
 //#define _CROSSOVER_DEBUG
 
 
+//////////////////////////////////////////////////////////
+//
+// Period-based crossover
+//
+// Each offspring inherits whole periods from the other parent: a random
+// number (1 to maxInheritedPeriods) of random periods of the parent is
+// copied, with the parent rooms, into the same periods of the offspring.
+// The periods are copied from the parent period exams vectors, in
+// O(period size), and the current period of an exam is obtained from the
+// scheduled exams vector in O(1).
+//
+// The inherited exams are first removed from their current periods, as
+// well as the exams of the inherited periods which are not inherited.
+// Then the inherited exams are scheduled. Their conflicts and rooms are
+// those of the feasible parent period, so only the Period-Related
+// constraints with the other exams are verified. The exams which can't be
+// inherited and the removed exams are reinserted by a saturation degree
+// repair: the exam with the fewest conflict-free periods is scheduled
+// first, in the feasible period with the lowest cost estimated by the
+// ETTPPeriodScorer. The cost is updated incrementally on every removal and
+// insertion.
+//
+// If an exam can't be reinserted, the offspring is rolled back to the
+// original solution.
+//
+
+
 template <typename EOT>
 class Crossover : public eoQuadOp<EOT>
 {
 
 public:
+    // Exam-Room tuple definition
+    typedef TimetableContainer::ExamRoomTuple ExamRoomTuple;
+    // Period inherited from a parent: period and its exam-room tuples
+    typedef std::pair<int, std::vector<ExamRoomTuple> > InheritedPeriod;
+
+    /**
+     * @brief Crossover Constructor
+     * @param _maxInheritedPeriods Maximum # periods inherited from the other parent
+     */
+    Crossover(int _maxInheritedPeriods = 3)
+        : maxInheritedPeriods(std::max(_maxInheritedPeriods, 1)) { }
 
     /**
     * the class name (used to display statistics)
@@ -47,22 +93,60 @@ public:
 protected:
 
     /**
-    * generation of an offspring
-    * @param _parent1 the first parent
-    * @param _parent2 the second parent
-    */
-    void generateOffspring(EOT &_parent1, EOT &_parent2);
+     * @brief selectPeriods Copy random distinct periods of _parent
+     * @param _parent
+     * @param _inheritedPeriods Copied periods (out parameter)
+     */
+    void selectPeriods(EOT const &_parent, std::vector<InheritedPeriod> &_inheritedPeriods);
+
+    /**
+     * @brief insertExams Insert the inherited periods into _offspring and repair it
+     * @param _offspring
+     * @param _inheritedPeriods
+     * @return true if _offspring was modified, false if it was rolled back
+     */
+    bool insertExams(EOT &_offspring, std::vector<InheritedPeriod> const &_inheritedPeriods);
+
+    /**
+     * @brief repair Reinsert the unscheduled exams by saturation degree
+     * @param _offspring
+     * @param _unscheduledExams
+     * @return true if all exams were reinserted
+     */
+    bool repair(EOT &_offspring, std::vector<int> &_unscheduledExams);
 
-    void insertExams(EOT &_offspring, const EOT &_parent);
+    /**
+     * @brief availablePeriods Determine the periods where exam _ei has no conflicts and
+     * satisfies the Period-Utilisation constraint. Pre-condition: _ei is not scheduled
+     * @param _offspring
+     * @param _ei
+     * @param _periods Available periods (out parameter)
+     */
+    void availablePeriods(EOT &_offspring, int _ei, std::vector<int> &_periods);
 
     /**
-     * @brief eoChromosome::removeExam Remove exam _ei from timetable ignoring period _randOffspringPeriod
-     * @param _timetableOffspring
+     * @brief removeExam Unschedule exam _ei and record its period and room for the rollback
+     * @param _offspring
      * @param _ei
-     * @param _randOffspringPeriod
      */
-    int findExamPeriod(TimetableContainer &_timetable, int _ei, int _randOffspringPeriod) const;
+    void removeExam(EOT &_offspring, int _ei);
 
+    /**
+     * @brief rollback Restore the removed exams in their original periods and rooms
+     * @param _offspring
+     * @param _solutionCost Original solution cost
+     */
+    void rollback(EOT &_offspring, long _solutionCost);
+
+    // Maximum # periods inherited from the other parent
+    int maxInheritedPeriods;
+    // Period scorer used to rank the periods of the reinserted exams
+    ETTPPeriodScorer<EOT> periodScorer;
+    // Removed exams: exam, original period and original room
+    std::vector<std::tuple<int, int, int> > removedExams;
+    // Auxiliary vectors
+    std::vector<int> periods;
+    std::vector<ExamRoomTuple> periodExams;
 };
 
 
@@ -81,70 +165,214 @@ bool Crossover<EOT>::operator()(EOT& _chromosome1, EOT& _chromosome2)
 {
 //    cout << "Crossover" << endl;
 
-    bool oneAtLeastIsModified = true;
-    // Computation of the offspring
-    EOT chrom1 = _chromosome1; // Original chromosome 1
-    EOT chrom2 = _chromosome2; // Original chromosome 2
-    generateOffspring(_chromosome1, chrom2); // offspring 1 is the resulting chromosome 1
-    generateOffspring(_chromosome2, chrom1); // offspring 2 is the resulting chromosome 2
-
-    return oneAtLeastIsModified;
+    // Copy the periods inherited by each offspring before changing the parents.
+    // Only the inherited periods are copied, instead of the whole chromosomes
+    std::vector<InheritedPeriod> periodsOfParent1, periodsOfParent2;
+    selectPeriods(_chromosome2, periodsOfParent2);
+    selectPeriods(_chromosome1, periodsOfParent1);
+    // Offspring 1 is the resulting chromosome 1, and offspring 2 is the resulting chromosome 2
+    bool offspring1IsModified = insertExams(_chromosome1, periodsOfParent2);
+    bool offspring2IsModified = insertExams(_chromosome2, periodsOfParent1);
+
+    // Return 'true' if at least one genotype has been modified
+    return offspring1IsModified || offspring2IsModified;
 }
 
 
 
-//===
-// Abdullah et al., Sabar et. al feasible crossover
-//===
+/**
+ * @brief selectPeriods Copy random distinct periods of _parent
+ * @param _parent
+ * @param _inheritedPeriods Copied periods (out parameter)
+ */
 template <typename EOT>
-void Crossover<EOT>::generateOffspring(EOT &_parent1, EOT &_parent2)
-{
-    //
-    // This crossover operator generates two offspring in the following way:
-    // exams chosen from a random period in parent2 are inserted in a
-    // random period in period1. Unfeasible exams are nor inserted and all
-    // duplicated exams in the other periods in parent1 are deleted in order
-    // to maintain feasibility.
-    //
-    // Instantiate a copy of parent1 to be used in the generation of offspring2
-    EOT parent1Copy = _parent1;
-    // We change directly _parent1 and _parent2 to be the new offsprings because
-    // they're already a copy of the original parents.
-    EOT& offspring1 = _parent1;
-    EOT& offspring2 = _parent2;
-    // Insert exams in offspring1 and compute offspring1 proximity cost incrementally
-    insertExams(offspring1, _parent2);
-    // Insert exams in offspring2 and compute offspring2 proximity cost incrementally
-    insertExams(offspring2, parent1Copy);
+void Crossover<EOT>::selectPeriods(EOT const &_parent, std::vector<InheritedPeriod> &_inheritedPeriods) {
+    TimetableContainer const &timetableCont = _parent.getTimetableContainer();
+    int numPeriods = _parent.getNumPeriods();
+    int numInheritedPeriods = 1 + rng.random(std::min(maxInheritedPeriods, numPeriods));
+    // Select distinct random periods by a partial shuffle
+    periods.resize(numPeriods);
+    std::iota(periods.begin(), periods.end(), 0);
+    _inheritedPeriods.clear();
+    for (int i = 0; i < numInheritedPeriods; ++i) {
+        int j = i + rng.random(numPeriods-i);
+        std::swap(periods[i], periods[j]);
+        _inheritedPeriods.push_back(std::make_pair(periods[i], timetableCont.getPeriodExams(periods[i])));
+    }
 }
 
 
+
+/**
+ * @brief insertExams Insert the inherited periods into _offspring and repair it
+ * @param _offspring
+ * @param _inheritedPeriods
+ * @return true if _offspring was modified, false if it was rolled back
+ */
 template <typename EOT>
-void Crossover<EOT>::insertExams(EOT &_offspring, const EOT &_parent)
+bool Crossover<EOT>::insertExams(EOT &_offspring, std::vector<InheritedPeriod> const &_inheritedPeriods)
 {
+    TimetableContainer &timetableCont = _offspring.getTimetableContainer();
+    long originalSolutionCost = _offspring.getSolutionCost();
+    removedExams.clear();
+    std::vector<int> unscheduledExams;
+
+    // Remove the inherited exams from their current periods
+    for (auto const &inheritedPeriod : _inheritedPeriods) {
+        for (auto const &examRoomTuple : inheritedPeriod.second)
+            removeExam(_offspring, std::get<0>(examRoomTuple));
+    }
+    // Remove the exams of the inherited periods which are not inherited
+    for (auto const &inheritedPeriod : _inheritedPeriods) {
+        // Copy the period exams because the period changes while removing them
+        periodExams = timetableCont.getPeriodExams(inheritedPeriod.first);
+        for (auto const &examRoomTuple : periodExams) {
+            int ei = std::get<0>(examRoomTuple);
+            removeExam(_offspring, ei);
+            unscheduledExams.push_back(ei);
+        }
+    }
+    // Schedule the inherited exams with the parent rooms. Conflicts and rooms are those
+    // of the feasible parent period, so only the Period-Related constraints are verified
+    for (auto const &inheritedPeriod : _inheritedPeriods) {
+        int tp = inheritedPeriod.first;
+        for (auto const &examRoomTuple : inheritedPeriod.second) {
+            int ei = std::get<0>(examRoomTuple);
+            if (_offspring.verifyPeriodRelatedConstraints(ei, tp))
+                _offspring.scheduleExamIncremental(ei, tp, std::get<1>(examRoomTuple));
+            else
+                unscheduledExams.push_back(ei);
+        }
+    }
 
+#ifdef _CROSSOVER_DEBUG
+    std::cout << "In [Crossover::insertExams]: # inherited periods = " << _inheritedPeriods.size()
+              << ", # removed exams = " << removedExams.size()
+              << ", # exams to reinsert = " << unscheduledExams.size() << std::endl;
+#endif
 
+    // Reinsert the unscheduled exams
+    if (!repair(_offspring, unscheduledExams)) {
+        rollback(_offspring, originalSolutionCost);
+        return false;
+    }
+    _offspring.fitness(_offspring.getSolutionCost());
+
+#ifdef _CROSSOVER_DEBUG
+    EOT check = _offspring;
+    check.computeCost();
+    std::cout << "In [Crossover::insertExams]: cost = " << originalSolutionCost << " -> "
+              << _offspring.getSolutionCost() << " (full evaluation = " << check.getSolutionCost() << ")" << std::endl;
+    if (check.getSolutionCost() != _offspring.getSolutionCost())
+        throw std::runtime_error("In [Crossover::insertExams]: incremental and full evaluation costs differ");
+#endif
+    return true;
 }
 
 
+
 /**
- * @brief eoChromosome::removeExam Remove exam _ei from timetable ignoring period _randOffspringPeriod
- * @param _timetableOffspring
- * @param _ei
- * @param _randOffspringPeriod
+ * @brief repair Reinsert the unscheduled exams by saturation degree
+ * @param _offspring
+ * @param _unscheduledExams
+ * @return true if all exams were reinserted
  */
 template <typename EOT>
-int Crossover<EOT>::findExamPeriod(TimetableContainer &_timetable, int _ei, int _randOffspringPeriod) const {
-    // For each period (except _randOffspringPeriod) do
-    for (int pi = 0; pi < _timetable.getNumPeriods(); ++pi) {
-        if (pi != _randOffspringPeriod) {
-            // If exam ei is scheduled in period pi
-            if (_timetable.isExamScheduled(_ei, pi)) {
-                return pi;
+bool Crossover<EOT>::repair(EOT &_offspring, std::vector<int> &_unscheduledExams) {
+    while (!_unscheduledExams.empty()) {
+        // Select the exam with the fewest available periods
+        std::size_t selected = 0;
+        int minAvailablePeriods = INT_MAX;
+        for (std::size_t k = 0; k < _unscheduledExams.size(); ++k) {
+            availablePeriods(_offspring, _unscheduledExams[k], periods);
+            if ((int)periods.size() < minAvailablePeriods) {
+                minAvailablePeriods = (int)periods.size();
+                selected = k;
+            }
+        }
+        int ei = _unscheduledExams[selected];
+        _unscheduledExams[selected] = _unscheduledExams.back();
+        _unscheduledExams.pop_back();
+        // Try the available periods by increasing estimated cost
+        availablePeriods(_offspring, ei, periods);
+        std::sort(periods.begin(), periods.end(), [this](int _p1, int _p2) {
+            return periodScorer.getDelta(_p1) < periodScorer.getDelta(_p2);
+        });
+        bool scheduled = false;
+        for (int tj : periods) {
+            int rk;
+            // Verify Period-Related constraints and get a feasible room
+            if (_offspring.getFeasiblePeriodRoom(ei, tj, rk)) {
+                _offspring.scheduleExamIncremental(ei, tj, rk);
+                scheduled = true;
+                break;
             }
         }
+        if (!scheduled) {
+#ifdef _CROSSOVER_DEBUG
+            std::cout << "In [Crossover::repair]: exam " << ei << " can't be reinserted" << std::endl;
+#endif
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+/**
+ * @brief availablePeriods Determine the periods where exam _ei has no conflicts and
+ * satisfies the Period-Utilisation constraint. Pre-condition: _ei is not scheduled
+ * @param _offspring
+ * @param _ei
+ * @param _periods Available periods (out parameter)
+ */
+template <typename EOT>
+void Crossover<EOT>::availablePeriods(EOT &_offspring, int _ei, std::vector<int> &_periods) {
+    // Period 0 is the reference period of the deltas. As _ei is not scheduled,
+    // the deltas only rank the periods
+    periodScorer.scorePeriods(_offspring, _ei, 0);
+    _periods.clear();
+    for (int p = 0; p < _offspring.getNumPeriods(); ++p) {
+        if (!periodScorer.hasConflicts(p) && _offspring.verifyPeriodUtilisationConstraint(_ei, p))
+            _periods.push_back(p);
+    }
+}
+
+
+
+/**
+ * @brief removeExam Unschedule exam _ei and record its period and room for the rollback
+ * @param _offspring
+ * @param _ei
+ */
+template <typename EOT>
+void Crossover<EOT>::removeExam(EOT &_offspring, int _ei) {
+    ScheduledExam const &scheduledExam = _offspring.getScheduledExamsVector()[_ei];
+    removedExams.push_back(std::make_tuple(_ei, scheduledExam.getPeriod(), scheduledExam.getRoom()));
+    _offspring.unscheduleExamIncremental(_ei);
+}
+
+
+
+/**
+ * @brief rollback Restore the removed exams in their original periods and rooms
+ * @param _offspring
+ * @param _solutionCost Original solution cost
+ */
+template <typename EOT>
+void Crossover<EOT>::rollback(EOT &_offspring, long _solutionCost) {
+    TimetableContainer &timetableCont = _offspring.getTimetableContainer();
+    auto const &scheduledExamsVector = _offspring.getScheduledExamsVector();
+    // Only the removed exams were moved. Unschedule them and schedule them back
+    for (auto const &removedExam : removedExams) {
+        int ei = std::get<0>(removedExam);
+        if (scheduledExamsVector[ei].isScheduled())
+            timetableCont.unscheduleExam(ei, scheduledExamsVector[ei].getPeriod());
     }
-    return -1; // Exam not found
+    for (auto const &removedExam : removedExams)
+        timetableCont.scheduleExam(std::get<0>(removedExam), std::get<1>(removedExam), std::get<2>(removedExam));
+    _offspring.setSolutionCost(_solutionCost);
 }
 
 
@@ -8,6 +8,9 @@
 #include "algorithms/eo/eoDeterministicTournamentSelectorPointer.h"
 #include <eoPopEvalFunc.h>
 #include "algorithms/eo/eoAlgoPointer.h"
+#include "algorithms/eo/eoPopulationDiversity.h"
+#include "algorithms/eo/eoCellularTopology.h"
+#include <eoInit.h>
 #include <eoOp.h>
 
 #include "neighbourhood/ETTPneighborhood.h"
@@ -15,11 +18,32 @@
 
 #include "algorithms/mo/moSimpleCoolingSchedule.h"
 #include "algorithms/mo/moTA.h"
+#include "algorithms/mo/moTAbatch.h"
+#include "algorithms/mo/moTAspeculative.h"
+#include "algorithms/mo/moLAHC.h"
+#include "algorithms/mo/moGD.h"
 #include "eval/eoETTPEval.h"
 #include "eval/eoNumberEvalsCounter.h"
+#include "kempeChain/ETTPOperatorSelector.h"
+#include "kempeChain/ETTPMoveFilter.h"
 
 #include "utils/CurrentDateTime.h"
+#include "utils/BinaryStream.h"
+#include "utils/MappedFile.h"
+#include "utils/SignalHandler.h"
+#include "utils/ParameterFile.h"
+#include "utils/AsyncLogWriter.h"
+#include "utils/ConvergenceTrace.h"
+#include "utils/WorkerPool.h"
 #include <boost/make_shared.hpp>
+#include <boost/unordered_map.hpp>
+#include <deque>
+#include <algorithm>
+#include <sstream>
+#include <cstdint>
+#include <stdexcept>
+#include <cstdio>
+#include <chrono>
 
 // Using boost accumulators framework for computing the variance
 #include <boost/accumulators/accumulators.hpp>
@@ -32,11 +56,36 @@
 namespace a = boost::accumulators;
 
 
-#define EOCELLULARGA_DEBUG
+//#define EOCELLULARGA_DEBUG
 
 
 /**
-   The abstract cellular evolutionary algorithm.
+ * @brief The ImprovementStep enum Local search used in the cEA improvement step
+ *   - ThresholdAccepting: Threshold Accepting driven by the cooling schedule
+ *   - LateAcceptance: Late Acceptance Hill Climbing
+ *   - GreatDeluge: Great Deluge with a linearly decreasing level
+ * Late Acceptance and Great Deluge run for the nominal # iterations of the cooling
+ * schedule, so that all local searches use the same # evaluations
+ */
+enum class ImprovementStep { ThresholdAccepting, LateAcceptance, GreatDeluge };
+
+/**
+ * @brief getImprovementStepName
+ * @param _improvementStep
+ * @return The improvement step name
+ */
+inline std::string getImprovementStepName(ImprovementStep _improvementStep) {
+    switch (_improvementStep) {
+    case ImprovementStep::LateAcceptance: return "Late Acceptance Hill Climbing";
+    case ImprovementStep::GreatDeluge: return "Great Deluge";
+    default: return "Threshold Accepting";
+    }
+}
+
+
+/**
+   The cellular evolutionary algorithm. The population is a toroidal grid, and the
+   partner of each cell is selected among the neighbours given by the topology.
 
    @ingroup Algorithms
  */
@@ -50,7 +99,7 @@ public :
      * Constructor
      */
     eoCellularEA(std::ofstream & _outFile, int _nrows, int _ncols, double _cp, double _mp, double _ip,
-                 moSimpleCoolingSchedule<EOT> const& _coolSchedule,
+                 moSimpleCoolingSchedule<EOT> & _coolSchedule, // TA cooling schedule. It may be reloaded by SIGUSR2
 //                 eoContinue<EOT> & _cont, // Stop. criterion
                  eoGenerationContinuePopVector<EOT> &_cont, // Stop. criterion
                  eoEvalFunc<EOT> & _eval, // Evaluation function
@@ -61,7 +110,20 @@ public :
                  eoSelectOne<EOT> & _sel_child, // To choose one from the both children
                  eoSelectOne<EOT> & _sel_repl,   // Which to keep between the new
                                                  // child and the old individual?
-                 eoNumberEvalsCounter &_numEvalCounter // # evaluations counter
+                 eoNumberEvalsCounter &_numEvalCounter, // # evaluations counter
+                 boost::shared_ptr<ETTPOperatorSelector> const &_operatorSelector, // Kempe chain operator selector
+                 int _taBatchSize = 1, // # neighbours evaluated per TA iteration
+                 BatchAcceptance _taBatchAcceptance = BatchAcceptance::BestCandidate, // TA batch acceptance rule
+                 int _taNumThreads = 1, // # threads of the speculative TA (1 - sequential TA)
+                 ImprovementStep _improvementStep = ImprovementStep::ThresholdAccepting, // Local search
+                 int _lahcHistoryLength = 500, // Late Acceptance history length
+                 double _gdTargetRatio = 0.5, // Great Deluge target cost, as a fraction of the initial cost
+                 int _taCacheSize = 0, // # entries of the local search outcome cache (0 - disabled)
+                 eoInit<EOT> *_init = nullptr, // Solution initialiser used to re-seed converged cells
+                 double _minReplacementDistance = 0, // Min. distance of an offspring to the other cells, as a fraction of the # exams
+                 double _restartDistance = 0, // Mean population distance which triggers a partial restart (0 - disabled)
+                 double _restartFraction = 0.5, // Max. fraction of the cells re-seeded in a restart
+                 CellularTopology _topology = CellularTopology::L5 // Neighbourhood of each cell
                  ) :
         outFile(_outFile),
         nrows(_nrows), ncols(_ncols),
@@ -76,9 +138,99 @@ public :
         sel_repl(_sel_repl),
         bestSolution(nullptr),
         popVariance(0),
-        numEvalsCounter(_numEvalCounter)
+        numEvalsCounter(_numEvalCounter),
+        operatorSelector(_operatorSelector),
+        taBatchSize(_taBatchSize),
+        taBatchAcceptance(_taBatchAcceptance),
+        taNumThreads(_taNumThreads),
+        workerPool(_taNumThreads > 1 ? new WorkerPool(_taNumThreads-1) : nullptr),
+        improvementStep(_improvementStep),
+        lahcHistoryLength(_lahcHistoryLength),
+        gdTargetRatio(_gdTargetRatio),
+        taCacheSize(_taCacheSize),
+        numTAruns(0),
+        numTAskipped(0),
+        init(_init),
+        minReplacementDistance(_minReplacementDistance),
+        restartDistance(_restartDistance),
+        restartFraction(_restartFraction),
+        popDistance(0),
+        numRestartedCells(0),
+        topology(_nrows, _ncols, _topology),
+        checkpointInterval(0),
+        resume(false),
+        logInterval(1),
+        logOnImprovement(false),
+        logPeriod(0),
+        runTimeOffset(0),
+        logger({ &std::cout, &_outFile, &traceFile })
     { }
 
+    /**
+     * @brief CHECKPOINT_VERSION Checkpoint format version. It must be incremented whenever the format changes
+     */
+    static const std::uint32_t CHECKPOINT_VERSION = 3;
+
+    /**
+     * @brief setCheckpoint Save the evolution state into file _filename every _interval
+     * generations, and when a stop signal is received
+     * @param _filename
+     * @param _interval # generations between checkpoints (0 - disabled)
+     */
+    void setCheckpoint(std::string const &_filename, int _interval) {
+        checkpointFilename = _filename;
+        checkpointInterval = _interval;
+    }
+
+    /**
+     * @brief setResume If set, the evolution continues from the checkpoint file, and
+     * the population given to the algorithm is only used as storage
+     * @param _resume
+     */
+    void setResume(bool _resume) {
+        resume = _resume;
+    }
+
+    /**
+     * @brief setSnapshotFile On SIGUSR1, the best solution is written into file _filename
+     * @param _filename
+     */
+    void setSnapshotFile(std::string const &_filename) {
+        snapshotFilename = _filename;
+    }
+
+    /**
+     * @brief setParametersFile On SIGUSR2, the tunable parameters are reloaded from
+     * file _filename. See reloadParameters
+     * @param _filename
+     */
+    void setParametersFile(std::string const &_filename) {
+        parametersFilename = _filename;
+    }
+
+    /**
+     * @brief setLogCadence Set when the generation report (fitness grid, variance, distance and
+     * # evaluations) is logged. It is logged if any of the enabled conditions holds. The best
+     * solution is written into the output file only when it improves
+     * @param _interval Log every _interval generations (0 - disabled)
+     * @param _onImprovement Log the generations which improve the best solution
+     * @param _period Log if _period seconds elapsed since the last report (0 - disabled)
+     */
+    void setLogCadence(int _interval, bool _onImprovement, double _period) {
+        logInterval = _interval;
+        logOnImprovement = _onImprovement;
+        logPeriod = _period;
+    }
+
+    /**
+     * @brief setTraceFile Write a convergence trace record into file _filename at the end of
+     * every generation. See ConvergenceTrace
+     * @param _filename
+     */
+    void setTraceFile(std::string const &_filename) {
+        traceFilename = _filename;
+    }
+
     /**
      *   Evolve a given population
      */
@@ -97,32 +249,55 @@ public :
 
         int genNumber = 1;
 
+        // Precompute the Kempe chain move filter tables
+        moveFilter = boost::make_shared<ETTPMoveFilter<EOT> >(*(*_pop.get())[0].get());
+
+        // Restore the evolution state. The checkpoint was saved right before the stop criterion was checked
+        if (resume) {
+            loadCheckpoint(*_pop.get(), genNumber);
+            std::ostringstream message;
+            message << std::endl << "Resuming evolution from checkpoint " << checkpointFilename
+                    << " at generation # " << genNumber << ", Date/Time = " << currentDateTime() << std::endl;
+            logger.write(message.str(), LOG_OUTPUT);
+        }
+
 #ifdef EOCELLULARGA_DEBUG
-      std::cout << "Running cGA" << std::endl;
+      logger.write("Running cGA\n", LOG_CONSOLE);
 
 #endif
 
-        do {
+        // Time of the last generation report
+        std::chrono::steady_clock::time_point lastLogTime = std::chrono::steady_clock::now();
+        runStartTime = lastLogTime;
+        if (!resume)
+            runTimeOffset = 0;
+        // Open the convergence trace. When resuming, the records are appended
+        if (!traceFilename.empty() && !ConvergenceTrace::openFile(traceFile, traceFilename, resume))
+            logger.write("Warning: couldn't open trace file " + traceFilename + "\n", LOG_CONSOLE);
+        tracedSolution.reset();
+        getOperatorTotals(traceTotals);
+
+        bool running = !resume || cont(*_pop.get());
+        while (running) {
             // Clear the offspring population produced in the previous generation
             (*offspringPop.get()).clear();
 
             // Get reference to original population
             std::vector<boost::shared_ptr<EOT> > &originalPop = *_pop.get();
+            // Extract the exam -> period arrays of the population
+            diversity.update(originalPop);
 
             // Produce the generation offspring
             for (int i = 0; i < originalPop.size(); ++i) {
                 // Who are neighbouring to the current individual?
                 //
-                // The neighbours method return a vector containing const pointers
-                // the neighbour solutions
-                std::vector<boost::shared_ptr<EOT> > neighs = neighbours(originalPop, i);
-
-                // cout << "Neighbours: " << endl;
+                // The partner is selected among the neighbour indexes of the current individual,
+                // given by the precomputed topology table
                 // cout << "_pop[i].fitness() = " << _pop[i].fitness() << endl;
 
                 // Create, in the heap, object copies of current individual and its neighbour
                 boost::shared_ptr<EOT> solCopy(new EOT(*originalPop[i].get())); // Invoke the copy ctor
-                boost::shared_ptr<EOT> part(new EOT(*sel_neigh(neighs).get())); // Invoke the copy ctor
+                boost::shared_ptr<EOT> part(new EOT(*sel_neigh(originalPop, topology.begin(i), topology.end(i)).get())); // Invoke the copy ctor
 
                 // To perform cross-over
                 if (rng.uniform() < cp) {
@@ -145,25 +320,49 @@ public :
                 // Local search used: Threshold Accepting algorithm
                 //
                 // moTA parameters
-                boost::shared_ptr<ETTPKempeChainHeuristic<EOT> > kempeChainHeuristic(new ETTPKempeChainHeuristic<EOT>());
+                boost::shared_ptr<ETTPKempeChainHeuristic<EOT> > kempeChainHeuristic(new ETTPKempeChainHeuristic<EOT>(operatorSelector, moveFilter));
                 ETTPneighborhood<EOT> neighborhood(kempeChainHeuristic);
+                // In the batched and speculative TA each candidate neighbour uses its own Kempe chain heuristic
+                std::vector<boost::shared_ptr<ETTPKempeChainHeuristic<EOT> > > kempeChainHeuristics(1, kempeChainHeuristic);
+                for (int k = 1; k < std::max(taBatchSize, taNumThreads); ++k)
+                    kempeChainHeuristics.push_back(boost::make_shared<ETTPKempeChainHeuristic<EOT> >(operatorSelector, moveFilter));
 //                ETTPneighborEval<EOT> neighEval;
                 // ETTPneighborEvalWithStatistics which receives as argument an
                 // eoNumberEvalsCounter for counting neigbour # evaluations
                 ETTPneighborEvalNumEvalsCounter<EOT> neighEval(this->numEvalsCounter);
-                // Copy of cool schedule to use in TA solver
-                auto cool = coolSchedule;
-
-                moTA<ETTPneighbor<EOT> > ta(neighborhood, fullEval, neighEval, cool);
+                // Copy of cool schedule to use in TA solver. The copy is polymorphic
+                // because the schedule may be adaptive and keep its own state
+                boost::shared_ptr<moSimpleCoolingSchedule<EOT> > coolPtr(coolSchedule.clone());
+                moSimpleCoolingSchedule<EOT> &cool = *coolPtr.get();
 
                 if (rng.uniform() < ip) {
-                    // Change the solutions directly
-                    ta(*solCopy.get());
+                    // Late Acceptance or Great Deluge if selected. Otherwise, speculative TA if several
+                    // threads are used, batched TA if several neighbours are evaluated per iteration,
+                    // and sequential TA otherwise
+                    boost::shared_ptr<moLocalSearch<ETTPneighbor<EOT> > > taPtr;
+                    if (improvementStep == ImprovementStep::LateAcceptance)
+                        taPtr = boost::make_shared<moLAHC<ETTPneighbor<EOT> > >(
+                                    neighborhood, fullEval, neighEval, lahcHistoryLength, cool.getNumIterations());
+                    else if (improvementStep == ImprovementStep::GreatDeluge)
+                        taPtr = boost::make_shared<moGD<ETTPneighbor<EOT> > >(
+                                    neighborhood, fullEval, neighEval, cool.getNumIterations(), gdTargetRatio);
+                    else if (taNumThreads > 1)
+                        taPtr = boost::make_shared<moTAspeculative<EOT> >(
+                                    neighborhood, fullEval, neighEval, cool, kempeChainHeuristics, numEvalsCounter, *workerPool.get());
+                    else if (taBatchSize > 1)
+                        taPtr = boost::make_shared<moTAbatch<EOT> >(
+                                    neighborhood, fullEval, neighEval, cool, kempeChainHeuristics, taBatchAcceptance);
+                    else
+                        taPtr = boost::make_shared<moTA<ETTPneighbor<EOT> > >(neighborhood, fullEval, neighEval, cool);
+                    moLocalSearch<ETTPneighbor<EOT> > &ta = *taPtr.get();
+                    // Change the solutions directly. Solutions identical to an already
+                    // improved one take the cached outcome instead
+                    improve(ta, *solCopy.get());
 //                    std::cout << "After TA" << std::endl;
 //                    std::cout << "# evaluations generation: " << numEvalsCounter.getGenerationNumEvals()
 //                    << ", Total # evaluations: " << numEvalsCounter.getTotalNumEvals() << std::endl;
 
-                    ta(*part.get());
+                    improve(ta, *part.get());
 //                    std::cout << "After TA" << std::endl;
 //                    std::cout << "# evaluations generation: " << numEvalsCounter.getGenerationNumEvals()
 //                    << ", Total # evaluations: " << numEvalsCounter.getTotalNumEvals() << std::endl;
@@ -189,6 +388,12 @@ public :
                     boost::shared_ptr<EOT> originalSol(new EOT(*originalPop[i].get())); // Invoke the copy ctor
                     bestOffspringSol = originalSol;
                 }
+                else if (isNearDuplicate(originalPop, i, *offspringSol.get())) {
+                    // Diversity-aware replacement: an offspring which is a near-duplicate of another,
+                    // not worse, cell does not replace the current individual
+                    boost::shared_ptr<EOT> originalSol(new EOT(*originalPop[i].get())); // Invoke the copy ctor
+                    bestOffspringSol = originalSol;
+                }
                 else
                     bestOffspringSol = offspringSol;
 
@@ -204,6 +409,12 @@ public :
             // Get reference to population
             std::vector<boost::shared_ptr<EOT> > &finalPop = *_pop.get();
 
+            ///////////////////////////////////////////////////////////////////////////////////////////////////
+            // Compute population mean distance and re-seed converged cells if the population has converged
+            diversity.update(finalPop);
+            popDistance = diversity.getMeanDistance();
+            int numGenRestartedCells = restart(finalPop);
+
             ///////////////////////////////////////////////////////////////////////////////////////////////////
             // Compute population variance
             // The accumulator set which will calculate the properties for us:
@@ -212,46 +423,51 @@ public :
                 acc_variance((*finalPop[i].get()).fitness());
             // Set variance value
             popVariance = a::variance(acc_variance);
+            double popMean = a::mean(acc_variance);
 
             ///////////////////////////////////////////////////////////////////////////////////////////////////
             // Determine the best solution
+            bool improved = false;
             for (unsigned i = 0; i < finalPop.size(); ++i) {
-                if (bestSolution.get() == nullptr || (*finalPop[i].get()).fitness() < bestSolution->fitness())
+                if (bestSolution.get() == nullptr || (*finalPop[i].get()).fitness() < bestSolution->fitness()) {
                     bestSolution = finalPop[i];
+                    improved = true;
+                }
             }
 
             ///////////////////////////////////////////////////////////////////////////////////////////////////
-            // Print population information to output and
-            // save population information into file
-            std::cout << std::endl << "==============================================================" << std::endl;
-            std::cout << "Generation # " << genNumber << ", Date/Time = " << currentDateTime() << std::endl;
-            outFile << std::endl << "==============================================================" << std::endl;
-            outFile << "Generation # " << genNumber << ", Date/Time = " << currentDateTime() << std::endl;
-            int k = 0;
-            for (int i = 0; i < nrows; ++i) {
-                for (int j = 0; j < ncols; ++j, ++k) {
-                    std::cout << (*finalPop[k].get()).fitness() << "\t";
-                    outFile << (*finalPop[k].get()).fitness() << "\t";
+            // Log population information. The text is formatted here and written by the log thread
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            bool logGeneration = (logInterval > 0 && genNumber % logInterval == 0) || (logOnImprovement && improved) ||
+                    (logPeriod > 0 && std::chrono::duration<double>(now - lastLogTime).count() >= logPeriod);
+            if (logGeneration) {
+                lastLogTime = now;
+                std::ostringstream report;
+                report << "\n==============================================================\n";
+                report << "Generation # " << genNumber << ", Date/Time = " << currentDateTime() << "\n";
+                int k = 0;
+                for (int i = 0; i < nrows; ++i) {
+                    for (int j = 0; j < ncols; ++j, ++k)
+                        report << (*finalPop[k].get()).fitness() << "\t";
+                    report << "\n";
                 }
-                std::cout << std::endl;
-                outFile << std::endl;
+                report << "popVariance = " << popVariance << ", popDistance = " << popDistance
+                       << ", # restarted cells = " << numGenRestartedCells << ", best sol = " << bestSolution->fitness() << "\n"
+                       << "# evaluations generation: " << numEvalsCounter.getGenerationNumEvals()
+                       << ", Total # evaluations: " << numEvalsCounter.getTotalNumEvals() << "\n";
+                report << "==============================================================\n";
+                logger.write(report.str(), LOG_OUTPUT);
+            }
+            // Trace record, written by the log thread
+            if (traceFile.is_open())
+                logger.write(ConvergenceTrace::toBytes(getTraceRecord(genNumber, popMean)), LOG_TRACE);
+            // Save best solution to file when it improves
+            if (improved) {
+                std::ostringstream solution;
+                solution << "New best solution at generation # " << genNumber << ": " << bestSolution->fitness() << "\n"
+                         << *getBestSolution() << "\n";
+                logger.write(solution.str(), LOG_FILE);
             }
-// Just print population vector
-//            for (int i = 0; i < nrows*ncols; ++i) {
-//                outFile << (*finalPop[i].get()).fitness() << "\t";
-//            }
-//            outFile << std::endl;
-
-            std::cout << "popVariance = " << popVariance << ", best sol = " << bestSolution->fitness() << std::endl
-                      << "# evaluations generation: " << numEvalsCounter.getGenerationNumEvals()
-                      << ", Total # evaluations: " << numEvalsCounter.getTotalNumEvals() << std::endl;
-            outFile << "popVariance = " << popVariance << ", best sol = " << bestSolution->fitness() << std::endl
-                      << "# evaluations generation: " << numEvalsCounter.getGenerationNumEvals()
-                      << ", Total # evaluations: " << numEvalsCounter.getTotalNumEvals() << std::endl;
-            // Save best solution to file
-            outFile << *getBestSolution() << std::endl;
-            cout << "==============================================================" << std::endl;
-            outFile << "==============================================================" << std::endl;
             ///////////////////////////////////////////////////////////////////////////////////////////////////
 
             // Increment # generations
@@ -260,14 +476,45 @@ public :
             // Reset # evaluations generation counter
             numEvalsCounter.setGenerationNumEvals(0);
 
-        } while (cont(*_pop.get()));
+            // Signal requests, polled once per generation
+            int requests = SignalHandler::getRequests();
+            if (requests & SignalHandler::DumpRequest) {
+                SignalHandler::takeRequests(SignalHandler::DumpRequest);
+                dumpSnapshot(genNumber-1);
+            }
+            if (requests & SignalHandler::ReloadRequest) {
+                SignalHandler::takeRequests(SignalHandler::ReloadRequest);
+                reloadParameters();
+            }
+            bool stopRequested = (requests & SignalHandler::StopRequest) != 0;
+
+            // Save the evolution state periodically, and before stopping on a signal
+            if (checkpointInterval > 0 && ((genNumber-1) % checkpointInterval == 0 || stopRequested)) {
+                if (!saveCheckpoint(*_pop.get(), genNumber))
+                    logger.write("Warning: couldn't write checkpoint " + checkpointFilename + "\n", LOG_CONSOLE);
+            }
+
+            if (stopRequested) {
+                logger.write("STOP: stop signal received\n", LOG_OUTPUT);
+                running = false;
+            }
+            else
+                running = cont(*_pop.get());
+        }
 
-        std::cout << std::endl << "End of evolution cycle" << std::endl
-             << "Writing best solution to file..." << std::endl;
+        logger.write("\nEnd of evolution cycle\nWriting best solution to file...\n", LOG_CONSOLE);
         // Write best solution to file
-        outFile << std::endl << "End of evolution cycle" << std::endl
-                << "Best solution: " << std::endl;
-        outFile << *getBestSolution() << std::endl;
+        std::ostringstream solution;
+        solution << "\nEnd of evolution cycle\nBest solution: \n" << *getBestSolution() << "\n";
+        logger.write(solution.str(), LOG_FILE);
+        // Write run statistics
+        std::ostringstream statistics;
+        printStatistics(statistics);
+        logger.write(statistics.str(), LOG_OUTPUT);
+        // The output streams may be written by the caller after the run
+        logger.flush();
+        if (traceFile.is_open())
+            traceFile.close();
     }
 
 
@@ -275,13 +522,427 @@ public :
 
 protected :
 
-    virtual std::vector<boost::shared_ptr<EOT> > neighbours (
-            const std::vector<boost::shared_ptr<EOT> > &_pop, int _rank) const = 0;
+    /**
+     * @brief printStatistics Print the Kempe chain operator, move rejection, restart and
+     * local search outcome cache statistics
+     * @param _os
+     */
+    void printStatistics(std::ostream &_os) const {
+        // Kempe chain operator statistics
+        _os << std::endl << "Kempe chain operator statistics:" << std::endl;
+        operatorSelector->print(_os);
+        // Kempe chain move rejection statistics
+        _os << std::endl << "Kempe chain move rejections:" << std::endl;
+        moveFilter->print(_os);
+        // Restart statistics
+        if (restartDistance > 0)
+            _os << std::endl << "Total # restarted cells: " << numRestartedCells << std::endl;
+        // Local search outcome cache statistics
+        if (taCacheSize > 0)
+            _os << std::endl << "Local search runs: " << numTAruns << ", skipped duplicates: " << numTAskipped << std::endl;
+    }
+
+    // Get the # seconds since the start of the run, including the time before a resumed checkpoint
+    double getRunTime() const {
+        return runTimeOffset + std::chrono::duration<double>(std::chrono::steady_clock::now() - runStartTime).count();
+    }
+
+    // Get the neighbour counters summed over the Kempe chain operators: built, feasible, accepted and improving
+    void getOperatorTotals(long _totals[4]) const {
+        std::fill(_totals, _totals + 4, 0);
+        for (int op = 0; op < operatorSelector->getNumOperators(); ++op) {
+            OperatorStatistics const &stats = operatorSelector->getStatistics(op);
+            _totals[0] += stats.numApplications;
+            _totals[1] += stats.numFeasible;
+            _totals[2] += stats.numAccepted;
+            _totals[3] += stats.numImprovements;
+        }
+    }
+
+    /**
+     * @brief getTraceRecord Build the convergence trace record of generation _genNumber. The soft
+     * constraint costs are only recomputed when the best solution changes, and the rates are
+     * computed from the operator counters of this generation
+     * @param _genNumber
+     * @param _popMean Population mean fitness
+     * @return
+     */
+    ConvergenceTraceRecord getTraceRecord(int _genNumber, double _popMean) {
+        if (tracedSolution != bestSolution) {
+            tracedSolution = bestSolution;
+            tracedCosts = bestSolution->computeSoftConstraintCosts();
+        }
+        ConvergenceTraceRecord record;
+        record.time = getRunTime();
+        record.generation = _genNumber;
+        record.numEvaluations = numEvalsCounter.getTotalNumEvals();
+        record.bestCost = bestSolution->fitness();
+        record.constraintCosts[0] = tracedCosts.twoInARow;
+        record.constraintCosts[1] = tracedCosts.twoInADay;
+        record.constraintCosts[2] = tracedCosts.periodSpread;
+        record.constraintCosts[3] = tracedCosts.mixedDurations;
+        record.constraintCosts[4] = tracedCosts.frontLoad;
+        record.constraintCosts[5] = tracedCosts.roomPenalty;
+        record.constraintCosts[6] = tracedCosts.periodPenalty;
+        record.popMean = _popMean;
+        record.popVariance = popVariance;
+        long totals[4];
+        getOperatorTotals(totals);
+        double numBuilt = std::max(1L, totals[0] - traceTotals[0]);
+        record.feasibleRate = (totals[1] - traceTotals[1]) / numBuilt;
+        record.acceptRate = (totals[2] - traceTotals[2]) / numBuilt;
+        record.improveRate = (totals[3] - traceTotals[3]) / numBuilt;
+        std::copy(totals, totals + 4, traceTotals);
+        return record;
+    }
+
+    /**
+     * @brief dumpSnapshot Print the best solution cost and the run statistics, and write
+     * the best solution into the snapshot file
+     * @param _genNumber Last generation number
+     */
+    void dumpSnapshot(int _genNumber) {
+        std::ostringstream snapshot;
+        snapshot << std::endl << "Snapshot at generation # " << _genNumber << ", Date/Time = " << currentDateTime() << std::endl
+                 << "best sol = " << bestSolution->fitness()
+                 << ", Total # evaluations: " << numEvalsCounter.getTotalNumEvals() << std::endl;
+        printStatistics(snapshot);
+        logger.write(snapshot.str(), LOG_OUTPUT);
+        if (snapshotFilename.empty())
+            return;
+        // Write a temporary file and rename it, so the snapshot file is always complete
+        std::string tmpFilename = snapshotFilename + ".tmp";
+        std::ofstream solutionFile(tmpFilename.c_str());
+        solutionFile << *bestSolution.get();
+        solutionFile.close();
+        if (!solutionFile || std::rename(tmpFilename.c_str(), snapshotFilename.c_str()) != 0) {
+            std::remove(tmpFilename.c_str());
+            logger.write("Warning: couldn't write snapshot " + snapshotFilename + "\n", LOG_CONSOLE);
+        }
+    }
+
+    /**
+     * @brief reloadParameters Reload the tunable parameters from the parameters file. Keys are
+     * cp, mp, ip (crossover, mutation and improvement probabilities) and initT, alpha, span, finalT
+     * (TA cooling schedule); missing keys keep their values. Invalid files are ignored
+     */
+    void reloadParameters() {
+        if (parametersFilename.empty())
+            return;
+        try {
+            ParameterFile params;
+            params.load(parametersFilename);
+            double newCp = params.getDouble("cp", cp);
+            double newMp = params.getDouble("mp", mp);
+            double newIp = params.getDouble("ip", ip);
+            double initT = params.getDouble("initT", coolSchedule.initT);
+            double alpha = params.getDouble("alpha", coolSchedule.alpha);
+            int span = params.getInt("span", coolSchedule.span);
+            double finalT = params.getDouble("finalT", coolSchedule.finalT);
+            if (newCp < 0 || newCp > 1 || newMp < 0 || newMp > 1 || newIp < 0 || newIp > 1)
+                throw std::runtime_error("cp, mp and ip must be in [0, 1]");
+            if (alpha <= 0 || span < 1 || finalT <= 0 || initT < finalT)
+                throw std::runtime_error("invalid cooling schedule");
+            cp = newCp;
+            mp = newMp;
+            ip = newIp;
+            coolSchedule.initT = initT;
+            coolSchedule.alpha = alpha;
+            coolSchedule.span = span;
+            coolSchedule.finalT = finalT;
+        }
+        catch (std::runtime_error const &e) {
+            logger.write(std::string("Warning: parameters not reloaded: ") + e.what() + "\n", LOG_OUTPUT);
+            return;
+        }
+        std::ostringstream message;
+        message << "Parameters reloaded from " << parametersFilename << ": cp = " << cp << ", mp = " << mp
+                << ", ip = " << ip << ", cooling schedule: " << coolSchedule.initT << ", " << coolSchedule.alpha
+                << ", " << coolSchedule.span << ", " << coolSchedule.finalT << std::endl;
+        logger.write(message.str(), LOG_OUTPUT);
+    }
+
+    /**
+     * @brief saveCheckpoint Save the evolution state into the checkpoint file: the cells, the best
+     * solution, the generation number, the evaluation and local search counters, the local search
+     * outcome cache, the stop criterion, operator selection and move filter states and the RNG state
+     * @param _pop
+     * @param _genNumber Next generation number
+     * @return true if the checkpoint was written
+     */
+    bool saveCheckpoint(std::vector<boost::shared_ptr<EOT> > const &_pop, int _genNumber) const {
+        BinaryWriter writer;
+        writer.putBytes(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        writer.put<std::uint32_t>(CHECKPOINT_VERSION);
+        writer.put<std::uint32_t>(CHECKPOINT_BYTE_ORDER_MARK);
+        // Problem and population sizes
+        EOT const &sol = *_pop[0].get();
+        writer.put<std::int32_t>(sol.getNumExams());
+        writer.put<std::int32_t>(sol.getNumPeriods());
+        writer.put<std::int32_t>(sol.getNumRooms());
+        writer.put<std::int32_t>(_pop.size());
+        // Counters
+        writer.put<std::int32_t>(_genNumber);
+        writer.put<std::int64_t>(numEvalsCounter.getTotalNumEvals());
+        writer.put<std::int64_t>(numTAruns);
+        writer.put<std::int64_t>(numTAskipped);
+        writer.put<std::int64_t>(numRestartedCells);
+        writer.put<double>(getRunTime());
+        // Tunable parameters, which may have been reloaded or, for the cooling
+        // schedule, calibrated by the time budget stop criterion
+        writer.put<double>(cp);
+        writer.put<double>(mp);
+        writer.put<double>(ip);
+        writer.put<double>(coolSchedule.initT);
+        writer.put<double>(coolSchedule.alpha);
+        writer.put<std::uint32_t>(coolSchedule.span);
+        writer.put<double>(coolSchedule.finalT);
+        // RNG state
+        std::ostringstream rngState;
+        rng.printOn(rngState);
+        writer.putString(rngState.str());
+        // Stop criterion, operator selection and move filter states
+        cont.saveState(writer);
+        operatorSelector->saveState(writer);
+        moveFilter->saveState(writer);
+        // Cells and best solution
+        for (auto const &cell : _pop)
+            saveSolution(writer, *cell.get());
+        saveSolution(writer, *bestSolution.get());
+        // Local search outcome cache, in insertion order
+        writer.put<std::int32_t>(taCacheKeys.size());
+        for (unsigned long long key : taCacheKeys) {
+            auto const &entry = taCache.find(key)->second;
+            writer.put<std::uint64_t>(key);
+            writer.put<double>(entry.first);
+            saveSolution(writer, *entry.second.get());
+        }
+        return writer.writeFile(checkpointFilename);
+    }
+
+    /**
+     * @brief loadCheckpoint Restore the evolution state from the checkpoint file.
+     * Throws std::runtime_error if the checkpoint is invalid or was written for another problem
+     * @param _pop Population. The cells are replaced by the checkpoint ones
+     * @param _genNumber Next generation number
+     */
+    void loadCheckpoint(std::vector<boost::shared_ptr<EOT> > &_pop, int &_genNumber) {
+        try {
+            MappedFile file(checkpointFilename);
+            BinaryReader reader(file.getData(), file.getData() + file.getSize());
+            char magic[sizeof(CHECKPOINT_MAGIC)];
+            for (char &c : magic)
+                c = reader.get<char>();
+            if (!std::equal(magic, magic + sizeof(magic), CHECKPOINT_MAGIC) || reader.get<std::uint32_t>() != CHECKPOINT_VERSION
+                    || reader.get<std::uint32_t>() != CHECKPOINT_BYTE_ORDER_MARK)
+                throw std::runtime_error("unsupported checkpoint format");
+            // Problem and population sizes
+            EOT const &sol = *_pop[0].get();
+            if (reader.get<std::int32_t>() != sol.getNumExams() || reader.get<std::int32_t>() != sol.getNumPeriods()
+                    || reader.get<std::int32_t>() != sol.getNumRooms() || reader.get<std::int32_t>() != (int)_pop.size())
+                throw std::runtime_error("checkpoint of another problem instance or population size");
+            TimetableProblemData const *data = sol.getTimetableProblemData();
+            // Counters
+            _genNumber = reader.getInt(1, INT32_MAX);
+            numEvalsCounter.setTotalNumEvals(reader.get<std::int64_t>());
+            numEvalsCounter.setGenerationNumEvals(0);
+            numTAruns = reader.get<std::int64_t>();
+            numTAskipped = reader.get<std::int64_t>();
+            numRestartedCells = reader.get<std::int64_t>();
+            runTimeOffset = reader.get<double>();
+            // Tunable parameters
+            cp = reader.get<double>();
+            mp = reader.get<double>();
+            ip = reader.get<double>();
+            coolSchedule.initT = reader.get<double>();
+            coolSchedule.alpha = reader.get<double>();
+            coolSchedule.span = reader.get<std::uint32_t>();
+            coolSchedule.finalT = reader.get<double>();
+            // RNG state
+            std::istringstream rngState(reader.getString());
+            rng.readFrom(rngState);
+            // Stop criterion, operator selection and move filter states
+            cont.loadState(reader);
+            operatorSelector->loadState(reader);
+            moveFilter->loadState(reader);
+            // Cells and best solution
+            for (auto &cell : _pop)
+                cell = loadSolution(reader, data);
+            bestSolution = loadSolution(reader, data);
+            // Local search outcome cache
+            taCache.clear();
+            taCacheKeys.clear();
+            int numEntries = reader.getInt(0, INT32_MAX);
+            for (int i = 0; i < numEntries; ++i) {
+                unsigned long long key = reader.get<std::uint64_t>();
+                double fitness = reader.get<double>();
+                taCache[key] = std::make_pair(fitness, loadSolution(reader, data));
+                taCacheKeys.push_back(key);
+            }
+            if (!reader.atEnd())
+                throw std::runtime_error("unexpected data at the end of the checkpoint");
+        }
+        catch (std::runtime_error const &e) {
+            throw std::runtime_error("In [eoCellularEA::loadCheckpoint]: " + checkpointFilename + ": " + e.what());
+        }
+    }
+
+    /**
+     * @brief saveSolution Save solution _sol into a checkpoint. The exams of each period are saved
+     * in the container order, which determines the exams picked by the random moves
+     * @param _writer
+     * @param _sol
+     */
+    static void saveSolution(BinaryWriter &_writer, EOT const &_sol) {
+        _writer.put<double>(_sol.fitness());
+        _writer.put<std::int64_t>(_sol.getSolutionCost());
+        _writer.put<std::uint8_t>(_sol.isFeasible());
+        TimetableContainer const &timetableCont = _sol.getTimetableContainer();
+        for (int tj = 0; tj < timetableCont.getNumPeriods(); ++tj) {
+            auto const &periodExams = timetableCont.getPeriodExams(tj);
+            _writer.put<std::int32_t>(periodExams.size());
+            for (auto const &examRoomTuple : periodExams) {
+                _writer.put<std::int32_t>(std::get<0>(examRoomTuple));
+                _writer.put<std::int32_t>(std::get<1>(examRoomTuple));
+            }
+        }
+    }
+
+    /**
+     * @brief loadSolution Load a solution saved by saveSolution
+     * @param _reader
+     * @param _data Problem data
+     * @return The solution
+     */
+    static boost::shared_ptr<EOT> loadSolution(BinaryReader &_reader, TimetableProblemData const *_data) {
+        boost::shared_ptr<EOT> sol(new EOT(_data));
+        double fitness = _reader.get<double>();
+        long solutionCost = _reader.get<std::int64_t>();
+        bool feasible = _reader.get<std::uint8_t>() != 0;
+        TimetableContainer &timetableCont = (*sol.get()).getTimetableContainer();
+        int numExams = _data->getNumExams();
+        std::vector<bool> scheduled(numExams, false);
+        for (int tj = 0; tj < _data->getNumPeriods(); ++tj) {
+            int periodSize = _reader.getInt(0, numExams);
+            for (int k = 0; k < periodSize; ++k) {
+                int ei = _reader.getInt(0, numExams-1);
+                int rk = _reader.getInt(0, _data->getNumRooms()-1);
+                if (scheduled[ei])
+                    throw std::runtime_error("exam scheduled more than once");
+                scheduled[ei] = true;
+                timetableCont.scheduleExam(ei, tj, rk);
+            }
+        }
+        if (std::find(scheduled.begin(), scheduled.end(), false) != scheduled.end())
+            throw std::runtime_error("unscheduled exam");
+        (*sol.get()).setSolutionCost(solutionCost);
+        (*sol.get()).setFeasible(feasible);
+        (*sol.get()).fitness(fitness);
+        return sol;
+    }
+
+    /**
+     * @brief improve Apply the local search _ta to solution _sol. If a solution with the same
+     * Zobrist hash and fitness was already improved, the cached outcome is copied instead
+     * @param _ta
+     * @param _sol
+     */
+    void improve(moLocalSearch<ETTPneighbor<EOT> > &_ta, EOT &_sol) {
+        if (taCacheSize <= 0) {
+            _ta(_sol);
+            ++numTAruns;
+            return;
+        }
+        // Get solution hash and fitness before the local search
+        unsigned long long hash = _sol.getHash();
+        double fitness = _sol.fitness();
+        auto it = taCache.find(hash);
+        // The fitness is compared as well, to guard against hash collisions
+        if (it != taCache.end() && it->second.first == fitness) {
+            _sol = *it->second.second.get();
+            ++numTAskipped;
+            return;
+        }
+        _ta(_sol);
+        ++numTAruns;
+        // Cache the outcome, evicting the oldest entry when the cache is full
+        if (it != taCache.end())
+            it->second = std::make_pair(fitness, boost::make_shared<EOT>(_sol));
+        else {
+            if ((int)taCacheKeys.size() >= taCacheSize) {
+                taCache.erase(taCacheKeys.front());
+                taCacheKeys.pop_front();
+            }
+            taCache[hash] = std::make_pair(fitness, boost::make_shared<EOT>(_sol));
+            taCacheKeys.push_back(hash);
+        }
+    }
+
+    /**
+     * @brief isNearDuplicate
+     * @param _pop
+     * @param _i Cell of the individual to be replaced
+     * @param _offspring
+     * @return true if _offspring is at distance <= min. replacement distance of a cell, other than
+     * _i, with fitness not worse than the offspring's
+     */
+    bool isNearDuplicate(std::vector<boost::shared_ptr<EOT> > const &_pop, int _i, EOT const &_offspring) {
+        if (minReplacementDistance <= 0)
+            return false;
+        int maxDistance = (int)(minReplacementDistance*diversity.getNumExams());
+        for (int j = 0; j < (int)_pop.size(); ++j) {
+            if (j != _i && (*_pop[j].get()).fitness() <= _offspring.fitness() &&
+                    diversity.distance(_offspring, j) <= maxDistance)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief restart If the population mean distance is below the restart distance, re-seed
+     * the cells converged to the best individual, worst first, with new initial solutions.
+     * The best individual and at most restartFraction of the cells are kept. The new solutions
+     * draw from the run's rng stream, so each re-seeded cell is a different timetable.
+     * Pre-condition: diversity was updated with _pop
+     * @param _pop
+     * @return The # re-seeded cells
+     */
+    int restart(std::vector<boost::shared_ptr<EOT> > &_pop) {
+        if (restartDistance <= 0 || init == nullptr || popDistance >= restartDistance)
+            return 0;
+        // Get best individual
+        int best = 0;
+        for (int j = 1; j < (int)_pop.size(); ++j)
+            if ((*_pop[j].get()).fitness() < (*_pop[best].get()).fitness())
+                best = j;
+        // Get cells converged to the best individual
+        int maxDistance = (int)(restartDistance*diversity.getNumExams());
+        std::vector<int> convergedCells;
+        for (int j = 0; j < (int)_pop.size(); ++j)
+            if (j != best && diversity.distance(j, best) <= maxDistance)
+                convergedCells.push_back(j);
+        // Worst cells first
+        std::sort(convergedCells.begin(), convergedCells.end(), [&_pop](int _a, int _b) {
+            return (*_pop[_a].get()).fitness() > (*_pop[_b].get()).fitness(); });
+        int numCells = std::min((int)convergedCells.size(), (int)(restartFraction*_pop.size()));
+        for (int k = 0; k < numCells; ++k) {
+            boost::shared_ptr<EOT> newSol(new EOT((*_pop[best].get()).getTimetableProblemData()));
+            (*init)(*newSol.get());
+            fullEval(*newSol.get());
+#ifdef EOCELLULARGA_DEBUG
+            std::cout << "Restarted cell " << convergedCells[k] << ": cost = " << newSol->getSolutionCost()
+                      << ", hash = " << newSol->getTimetableContainer().getHash() << std::endl;
+#endif
+            _pop[convergedCells[k]] = newSol;
+        }
+        numRestartedCells += numCells;
+        return numCells;
+    }
 
     std::ofstream & outFile;
     int nrows, ncols;
     double cp, mp, ip;
-    moSimpleCoolingSchedule<EOT> const& coolSchedule;
+    moSimpleCoolingSchedule<EOT> & coolSchedule;
 //    eoContinue<EOT> & cont;
     eoGenerationContinuePopVector<EOT> &cont; // Stop. criterion
     eoEvalFunc<EOT> & fullEval;
@@ -296,8 +957,68 @@ protected :
     boost::shared_ptr<EOT> bestSolution; // Reference to the best solution
     double popVariance; // Population variance
     eoNumberEvalsCounter &numEvalsCounter;
+    boost::shared_ptr<ETTPOperatorSelector> operatorSelector; // Kempe chain operator selector
+    boost::shared_ptr<ETTPMoveFilter<EOT> > moveFilter; // Kempe chain quick-reject move filter
+    int taBatchSize; // # neighbours evaluated per TA iteration
+    BatchAcceptance taBatchAcceptance; // TA batch acceptance rule
+    int taNumThreads; // # threads of the speculative TA
+    boost::shared_ptr<WorkerPool> workerPool; // Worker threads of the speculative TA, shared by its runs
+    ImprovementStep improvementStep; // Local search used in the improvement step
+    int lahcHistoryLength; // Late Acceptance history length
+    double gdTargetRatio; // Great Deluge target cost, as a fraction of the initial cost
+    int taCacheSize; // # entries of the local search outcome cache
+    // Local search outcomes keyed by the hash of the input solution. Each entry keeps
+    // the input fitness and the improved solution
+    boost::unordered_map<unsigned long long, std::pair<double, boost::shared_ptr<EOT> > > taCache;
+    std::deque<unsigned long long> taCacheKeys; // Cache keys in insertion order
+    long numTAruns; // # local search runs
+    long numTAskipped; // # local search runs skipped on duplicate solutions
+    eoInit<EOT> *init; // Solution initialiser used to re-seed converged cells
+    double minReplacementDistance; // Min. distance of an offspring to the other cells, as a fraction of the # exams
+    double restartDistance; // Mean population distance which triggers a partial restart
+    double restartFraction; // Max. fraction of the cells re-seeded in a restart
+    eoPopulationDiversity<EOT> diversity; // Assignment distance between individuals
+    double popDistance; // Population mean distance, as a fraction of the # exams
+    long numRestartedCells; // Total # re-seeded cells
+    eoCellularTopology topology; // Neighbour index tables of the cells
+    std::string checkpointFilename; // Evolution checkpoint file
+    int checkpointInterval; // # generations between checkpoints (0 - disabled)
+    bool resume; // Continue the evolution from the checkpoint file
+    std::string snapshotFilename; // Best solution file written on SIGUSR1
+    std::string parametersFilename; // Tunable parameters file reloaded on SIGUSR2
+    int logInterval; // # generations between generation reports (0 - disabled)
+    bool logOnImprovement; // Report the generations which improve the best solution
+    double logPeriod; // Max. seconds between generation reports (0 - disabled)
+    std::string traceFilename; // Convergence trace file
+    std::ofstream traceFile;
+    std::chrono::steady_clock::time_point runStartTime; // Start time of this run (or resumed run)
+    double runTimeOffset; // Run time before the resumed checkpoint, in seconds
+    boost::shared_ptr<EOT> tracedSolution; // Best solution of the last trace record
+    SoftConstraintCosts tracedCosts; // Soft constraint costs of tracedSolution
+    long traceTotals[4]; // Operator neighbour counters at the last trace record
+    // Log sinks: bit 0 - std::cout, bit 1 - output file, bit 2 - trace file
+    static const unsigned LOG_CONSOLE = 1;
+    static const unsigned LOG_FILE = 2;
+    static const unsigned LOG_TRACE = 4;
+    static const unsigned LOG_OUTPUT = LOG_CONSOLE | LOG_FILE;
+    // Writes std::cout and the output file from a background thread. Declared last, so the
+    // queued text is written before the other members are destroyed
+    AsyncLogWriter logger;
+
+    // Checkpoint file signature
+    static constexpr char CHECKPOINT_MAGIC[8] = { 'C', 'M', 'A', 'E', 'T', 'P', 'C', 'K' };
+    // Written in the native byte order, to detect checkpoints with a different byte order
+    static const std::uint32_t CHECKPOINT_BYTE_ORDER_MARK = 0x01020304;
 };
 
+// Checkpoint constants definitions
+template <class EOT>
+const std::uint32_t eoCellularEA<EOT>::CHECKPOINT_VERSION;
+template <class EOT>
+constexpr char eoCellularEA<EOT>::CHECKPOINT_MAGIC[8];
+template <class EOT>
+const std::uint32_t eoCellularEA<EOT>::CHECKPOINT_BYTE_ORDER_MARK;
+
 
 
 
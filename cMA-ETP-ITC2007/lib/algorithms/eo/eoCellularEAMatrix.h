@@ -8,6 +8,8 @@
 
 /**
  *  The cellular evolutionary algorithm - matrix grid.
+ *  The cell neighbourhoods are given by the topology (L5 by default); a 1-row
+ *  grid with the Ring topology gives the ring cGA.
  *
  *  @ingroup Algorithms
  */
@@ -21,7 +23,7 @@ public :
    */
 
     eoCellularEAMatrix(std::ofstream & _outFile, int _nrows, int _ncols,
-                     double _cp, double _mp, double _ip, moSimpleCoolingSchedule<EOT> const& _coolSchedule,
+                     double _cp, double _mp, double _ip, moSimpleCoolingSchedule<EOT> & _coolSchedule,
 //                     eoContinue<EOT> & _cont, // Stop. criterion
                      eoGenerationContinuePopVector<EOT> &_cont, // Stop. criterion
                      eoEvalFunc<EOT> & _eval, // Evaluation function
@@ -31,53 +33,28 @@ public :
                      eoMonOp<EOT> & _mut, // Mutation operator
                      eoSelectOne<EOT> & _sel_child, // To choose one from the both children
                      eoSelectOne<EOT> & _sel_repl,  // Which to keep between the new child and the old individual?
-                     eoNumberEvalsCounter &_numEvalCounter // # evaluations counter
+                     eoNumberEvalsCounter &_numEvalCounter, // # evaluations counter
+                     boost::shared_ptr<ETTPOperatorSelector> const &_operatorSelector, // Kempe chain operator selector
+                     int _taBatchSize = 1, // # neighbours evaluated per TA iteration
+                     BatchAcceptance _taBatchAcceptance = BatchAcceptance::BestCandidate, // TA batch acceptance rule
+                     int _taNumThreads = 1, // # threads of the speculative TA (1 - sequential TA)
+                     ImprovementStep _improvementStep = ImprovementStep::ThresholdAccepting, // Local search
+                     int _lahcHistoryLength = 500, // Late Acceptance history length
+                     double _gdTargetRatio = 0.5, // Great Deluge target cost, as a fraction of the initial cost
+                     int _taCacheSize = 0, // # entries of the local search outcome cache (0 - disabled)
+                     eoInit<EOT> *_init = nullptr, // Solution initialiser used to re-seed converged cells
+                     double _minReplacementDistance = 0, // Min. distance of an offspring to the other cells, as a fraction of the # exams
+                     double _restartDistance = 0, // Mean population distance which triggers a partial restart (0 - disabled)
+                     double _restartFraction = 0.5, // Max. fraction of the cells re-seeded in a restart
+                     CellularTopology _topology = CellularTopology::L5 // Neighbourhood of each cell
                     )
         : eoCellularEA<EOT>(_outFile, _nrows, _ncols, _cp, _mp, _ip, _coolSchedule,
-                            _cont, _eval, _sel_neigh, _cross, _mut, _sel_child, _sel_repl, _numEvalCounter)
+                            _cont, _eval, _sel_neigh, _cross, _mut, _sel_child, _sel_repl, _numEvalCounter,
+                            _operatorSelector, _taBatchSize, _taBatchAcceptance, _taNumThreads,
+                            _improvementStep, _lahcHistoryLength, _gdTargetRatio, _taCacheSize,
+                            _init, _minReplacementDistance, _restartDistance, _restartFraction, _topology)
   { }
 
-    // Neighbouring of the current individual with rank _rank
-    // The individual rank is individual position index in the population vector
-//    virtual eoPop<const EOT*> neighbours(const eoPop<EOT> & _pop, int _rank) const override {
-    virtual std::vector<boost::shared_ptr<EOT> > neighbours(
-            const std::vector<boost::shared_ptr<EOT> > &_pop, int _rank) const override {
-        // Matrix cGA
-        int row, col;
-        row = _rank / this->ncols; // Integer division
-        col = _rank % this->ncols;
-
-/// TODO
-/// GENERIC NEIGHBOURHOOD
-///
-///
-        // 4-Neighbourhood
-        int leftCoords[2]  = { row, col-1 < 0 ? this->ncols-1 : col-1 };
-        int rightCoords[2] = { row, col+1 > this->ncols-1 ? 0 : col+1 };
-        int northCoords[2] = { row-1 < 0 ? this->nrows-1 : row-1, col };
-        int southCoords[2] = { row+1 > this->nrows-1 ? 0 : row+1, col };
-
-//        cout << "rank = " << _rank << ", row = " << row << ", col = " << col << endl;
-//        cout << "nrows = " << nrows << ", ncols = " << ncols << endl;
-//        cout << "leftCoords[0]*ncols  + leftCoords[1] = " << (leftCoords[0]*ncols  + leftCoords[1]) << endl;
-
-//        cin.get();
-
-        boost::shared_ptr<EOT> const& leftNeigh  = _pop[leftCoords[0]*this->ncols  + leftCoords[1]];
-        boost::shared_ptr<EOT> const& rightNeigh = _pop[rightCoords[0]*this->ncols + rightCoords[1]];
-        boost::shared_ptr<EOT> const& northNeigh = _pop[northCoords[0]*this->ncols + northCoords[1]];
-        boost::shared_ptr<EOT> const& southNeigh = _pop[southCoords[0]*this->ncols + southCoords[1]];
-
-        // Neighbours pointers vector
-        std::vector<boost::shared_ptr<EOT> > neighs;
-        neighs.push_back(leftNeigh);
-        neighs.push_back(rightNeigh);
-        neighs.push_back(northNeigh);
-        neighs.push_back(southNeigh);
-
-        return neighs;
-    }
-
 };
 
 
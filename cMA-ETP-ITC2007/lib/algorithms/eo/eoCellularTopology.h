@@ -0,0 +1,153 @@
+#ifndef EOCELLULARTOPOLOGY_H
+#define EOCELLULARTOPOLOGY_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+
+//#define EOCELLULARTOPOLOGY_DEBUG
+
+
+/**
+ * @brief The CellularTopology enum Neighbourhood of a cell in the cEA population
+ *   - Ring: the two adjacent cells in a ring with the population cells in row-major order
+ *   - L5: North, South, East and West cells in the toroidal grid (Von Neumann)
+ *   - L9: L5 plus the cells at distance 2 in the North, South, East and West directions
+ *   - C9: the 8 surrounding cells in the toroidal grid (Moore)
+ *   - C13: C9 plus the cells at distance 2 in the North, South, East and West directions
+ * The centre cell is not included in its own neighbourhood. Larger neighbourhoods
+ * increase the selection pressure and speed up convergence
+ */
+enum class CellularTopology { Ring, L5, L9, C9, C13 };
+
+/**
+ * @brief getCellularTopologyName
+ * @param _topology
+ * @return The topology name
+ */
+inline std::string getCellularTopologyName(CellularTopology _topology) {
+    switch (_topology) {
+    case CellularTopology::Ring: return "Ring";
+    case CellularTopology::L9: return "L9";
+    case CellularTopology::C9: return "C9";
+    case CellularTopology::C13: return "C13";
+    default: return "L5";
+    }
+}
+
+
+/**
+ * @brief The eoCellularTopology class Precomputed neighbour index tables of a toroidal cEA grid
+ *
+ * The neighbours of all the cells are stored in a single index vector, with the
+ * neighbours of cell i in positions [offsets[i], offsets[i+1]), so a neighbourhood
+ * lookup is an array slice. Cells repeated in small grids are stored once.
+ */
+class eoCellularTopology {
+
+public:
+
+    /**
+     * @brief eoCellularTopology Ctor
+     * @param _nrows # grid rows
+     * @param _ncols # grid columns
+     * @param _topology Neighbourhood of each cell
+     */
+    eoCellularTopology(int _nrows, int _ncols, CellularTopology _topology)
+        : nrows(_nrows), ncols(_ncols), topology(_topology) {
+        // Get (row, col) offsets of the neighbourhood
+        std::vector<std::pair<int, int> > shape;
+        if (topology != CellularTopology::Ring) {
+            // L5
+            shape = { {-1, 0}, {1, 0}, {0, 1}, {0, -1} };
+            // Diagonal cells
+            if (topology == CellularTopology::C9 || topology == CellularTopology::C13)
+                shape.insert(shape.end(), { {-1, -1}, {-1, 1}, {1, -1}, {1, 1} });
+            // Cells at distance 2
+            if (topology == CellularTopology::L9 || topology == CellularTopology::C13)
+                shape.insert(shape.end(), { {-2, 0}, {2, 0}, {0, 2}, {0, -2} });
+        }
+        int popSize = nrows*ncols;
+        offsets.push_back(0);
+        for (int i = 0; i < popSize; ++i) {
+            std::vector<int> neighs;
+            if (topology == CellularTopology::Ring) {
+                neighs.push_back((i-1+popSize) % popSize);
+                neighs.push_back((i+1) % popSize);
+            }
+            else {
+                int row = i / ncols; // Integer division
+                int col = i % ncols;
+                for (auto const &rowCol : shape) {
+                    int neighRow = ((row + rowCol.first) % nrows + nrows) % nrows;
+                    int neighCol = ((col + rowCol.second) % ncols + ncols) % ncols;
+                    neighs.push_back(neighRow*ncols + neighCol);
+                }
+            }
+            // Remove the centre cell and repeated cells, keeping the neighbourhood order
+            for (int neigh : neighs) {
+                if (neigh != i && std::find(neighbourIndexes.begin() + offsets.back(), neighbourIndexes.end(), neigh)
+                        == neighbourIndexes.end())
+                    neighbourIndexes.push_back(neigh);
+            }
+            // A single cell population is its own neighbour
+            if ((int)neighbourIndexes.size() == offsets.back())
+                neighbourIndexes.push_back(i);
+            offsets.push_back(neighbourIndexes.size());
+        }
+
+#ifdef EOCELLULARTOPOLOGY_DEBUG
+        for (int i = 0; i < popSize; ++i) {
+            std::cout << "Cell " << i << " neighbours:";
+            for (int const *it = begin(i); it != end(i); ++it)
+                std::cout << " " << *it;
+            std::cout << std::endl;
+        }
+#endif
+    }
+
+    /**
+     * @brief begin
+     * @param _i
+     * @return Pointer to the first neighbour index of cell _i
+     */
+    int const *begin(int _i) const { return neighbourIndexes.data() + offsets[_i]; }
+
+    /**
+     * @brief end
+     * @param _i
+     * @return Pointer past the last neighbour index of cell _i
+     */
+    int const *end(int _i) const { return neighbourIndexes.data() + offsets[_i+1]; }
+
+    /**
+     * @brief getNumNeighbours
+     * @param _i
+     * @return The # neighbours of cell _i
+     */
+    int getNumNeighbours(int _i) const { return offsets[_i+1] - offsets[_i]; }
+
+    /**
+     * @brief getTopology
+     * @return
+     */
+    CellularTopology getTopology() const { return topology; }
+
+protected:
+
+    // # grid rows
+    int nrows;
+    // # grid columns
+    int ncols;
+    // Neighbourhood of each cell
+    CellularTopology topology;
+    // Neighbour indexes of all the cells
+    std::vector<int> neighbourIndexes;
+    // Position of the first neighbour of each cell in neighbourIndexes, plus the total size
+    std::vector<int> offsets;
+};
+
+
+#endif // EOCELLULARTOPOLOGY_H
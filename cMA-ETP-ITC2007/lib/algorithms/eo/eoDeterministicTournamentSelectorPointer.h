@@ -56,6 +56,31 @@ boost::shared_ptr<EOT>& deterministic_tournament_shared_ptr(
 
 
 
+/**
+ * Deterministic tournament among the individuals of _pop whose indexes are in [_begin, _end)
+ */
+template <class EOT>
+const boost::shared_ptr<EOT>& deterministic_tournament_shared_ptr(
+        const std::vector<boost::shared_ptr<EOT> >& _pop, const int *_begin, const int *_end,
+        unsigned _t_size, eoRng& _gen = rng)
+{
+    const int *best = _begin + _gen.random(_end - _begin);
+
+    for (unsigned i = 0; i < _t_size - 1; ++i)
+    {
+        const int *competitor = _begin + _gen.random(_end - _begin);
+
+        if (*_pop[*best].get() < *_pop[*competitor].get())
+        {
+            best = competitor;
+        }
+    }
+
+    return _pop[*best];
+}
+
+
+
 /** eoDetTournamentSelect: a selection method that selects ONE individual by
  deterministic tournament
 
@@ -86,6 +111,15 @@ class eoDetTournamentSelectSharedPtr: public eoUF<const std::vector<boost::share
       return deterministic_tournament_shared_ptr(_pop, tSize);
   }
 
+  /* Perform deterministic tournament among the individuals of _pop whose
+     indexes are in [_begin, _end), e.g., a cell neighbourhood
+  */
+  virtual const boost::shared_ptr<EOT>& operator()(const std::vector<boost::shared_ptr<EOT> >& _pop,
+                                                   const int *_begin, const int *_end)
+  {
+      return deterministic_tournament_shared_ptr(_pop, _begin, _end, tSize);
+  }
+
 private:
     unsigned tSize;
 };
@@ -8,8 +8,7 @@
 #include <string>
 
 #include <boost/shared_ptr.hpp>
-
-extern volatile bool keepRunning;
+#include "utils/BinaryStream.h"
 
 
 //#define EOGENERATIONCONTINUEPOPVECTOR_DEBUG
@@ -18,8 +17,9 @@ extern volatile bool keepRunning;
 /**
   Code based on ParadisEO eoGenContinue class
 
-  Generational or keyboard continuator:
-    continues until a number of generations is reached or a key is pressed
+  Generational continuator:
+    continues until a number of generations is reached. Stop signals (SIGINT,
+    SIGTERM) are handled by the algorithm, see SignalHandler
 
   @ingroup Continuators
 */
@@ -55,21 +55,6 @@ public:
                     << thisGeneration << "/" << repTotalGenerations << "]\n" << std::endl;
             return false;
         }
-
-        if (!keepRunning) {
-            std::cout << std::endl << "Ctrl+C pressed! Do you really want to quit? [y/n] " << std::endl;
-            char c;
-            std::cin >> c;
-            if (c == 'y' || c == 'Y') {
-                std::cout << "Quitting application now..." << std::endl;
-                return false;
-            }
-            else {
-                keepRunning = true;
-                std::cout << "Resuming application now..." << std::endl;
-                return true;
-            }
-        }
         return true;
     }
 
@@ -89,6 +74,22 @@ public:
         return repTotalGenerations;
     }
 
+    /**
+     * @brief saveState Save the continuator state into an evolution checkpoint
+     * @param _writer
+     */
+    virtual void saveState(BinaryWriter &_writer) const {
+        _writer.put<std::uint64_t>(thisGeneration);
+    }
+
+    /**
+     * @brief loadState Restore the continuator state from an evolution checkpoint
+     * @param _reader
+     */
+    virtual void loadState(BinaryReader &_reader) {
+        thisGeneration = _reader.get<std::uint64_t>();
+    }
+
 private:
     unsigned long repTotalGenerations;
     unsigned long thisGeneration;
@@ -0,0 +1,123 @@
+#ifndef EOPOPULATIONDIVERSITY_H
+#define EOPOPULATIONDIVERSITY_H
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+
+//#define EOPOPULATIONDIVERSITY_DEBUG
+
+
+/**
+ * @brief The eoPopulationDiversity class Assignment distance between the individuals of a population
+ *
+ * The distance between two timetables is the Hamming distance between their exam -> period
+ * arrays, i.e., the # exams scheduled in different periods. The exam -> period arrays of
+ * the population are extracted once per generation into a contiguous matrix, so each
+ * distance is a branch-free loop over two int arrays which the compiler vectorises.
+ */
+template <typename EOT>
+class eoPopulationDiversity {
+
+public:
+
+    /**
+     * @brief eoPopulationDiversity Default ctor
+     */
+    eoPopulationDiversity() : numExams(0), popSize(0) { }
+
+    /**
+     * @brief update Extract the exam -> period arrays of population _pop
+     * @param _pop
+     */
+    void update(std::vector<boost::shared_ptr<EOT> > const &_pop) {
+        popSize = _pop.size();
+        numExams = popSize > 0 ? (*_pop[0].get()).getNumExams() : 0;
+        periods.resize(popSize*numExams);
+        for (int i = 0; i < popSize; ++i)
+            getExamPeriods(*_pop[i].get(), &periods[i*numExams]);
+    }
+
+    /**
+     * @brief getExamPeriods Copy the exam -> period array of solution _sol into _periods
+     * @param _sol
+     * @param _periods Array with at least # exams positions
+     */
+    static void getExamPeriods(EOT const &_sol, int *_periods) {
+        auto const &scheduledExams = _sol.getScheduledExamsVector();
+        for (int ei = 0; ei < (int)scheduledExams.size(); ++ei)
+            _periods[ei] = scheduledExams[ei].getPeriod();
+    }
+
+    /**
+     * @brief hammingDistance # positions where arrays _a and _b differ
+     * @param _a
+     * @param _b
+     * @param _n Arrays size
+     * @return
+     */
+    static int hammingDistance(int const *_a, int const *_b, int _n) {
+        int dist = 0;
+        // Branch-free, so it is vectorised
+        for (int i = 0; i < _n; ++i)
+            dist += (_a[i] != _b[i]);
+        return dist;
+    }
+
+    /**
+     * @brief distance Distance between individuals _i and _j of the last updated population
+     * @param _i
+     * @param _j
+     * @return The # exams scheduled in different periods
+     */
+    int distance(int _i, int _j) const {
+        return hammingDistance(&periods[_i*numExams], &periods[_j*numExams], numExams);
+    }
+
+    /**
+     * @brief distance Distance between solution _sol and individual _j of the last updated population
+     * @param _sol
+     * @param _j
+     * @return The # exams scheduled in different periods
+     */
+    int distance(EOT const &_sol, int _j) {
+        solPeriods.resize(numExams);
+        getExamPeriods(_sol, &solPeriods[0]);
+        return hammingDistance(&solPeriods[0], &periods[_j*numExams], numExams);
+    }
+
+    /**
+     * @brief getMeanDistance Mean pairwise distance of the last updated population,
+     * as a fraction of the # exams
+     * @return
+     */
+    double getMeanDistance() const {
+        if (popSize < 2 || numExams == 0)
+            return 0;
+        long sum = 0;
+        for (int i = 0; i < popSize; ++i)
+            for (int j = i+1; j < popSize; ++j)
+                sum += distance(i, j);
+        return (double)sum / ((long)popSize*(popSize-1)/2) / numExams;
+    }
+
+    /**
+     * @brief getNumExams
+     * @return
+     */
+    int getNumExams() const { return numExams; }
+
+protected:
+
+    // # exams
+    int numExams;
+    // # individuals
+    int popSize;
+    // Exam -> period arrays of the population, one row per individual
+    std::vector<int> periods;
+    // Exam -> period array of a solution outside the population
+    std::vector<int> solPeriods;
+};
+
+
+#endif // EOPOPULATIONDIVERSITY_H
@@ -0,0 +1,210 @@
+#ifndef EOTIMEBUDGETCONTINUEPOPVECTOR_H
+#define EOTIMEBUDGETCONTINUEPOPVECTOR_H
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include "algorithms/eo/eoGenerationContinuePopVector.h"
+#include "algorithms/mo/moSimpleCoolingSchedule.h"
+#include "eval/eoNumberEvalsCounter.h"
+
+
+//#define EOTIMEBUDGETCONTINUEPOPVECTOR_DEBUG
+
+
+/**
+  Wall-clock time budget continuator
+
+  Continues until the time budget is spent or a number of generations is reached. The time is measured from the continuator construction.
+
+  The budget is the time limit multiplied by a machine speed factor, so that the
+  ITC2007 time limit can be calibrated against the competition benchmark machine:
+  speed factor = (local benchmark program time) / (ITC2007 benchmark machine time).
+
+  After the first calibration seconds, the measured generation time is used to
+  plan the number of generations that fit in the remaining budget. If the plan
+  falls outside [minGenerations, maxGenerations], the TA cooling schedule is
+  rescaled so that the plan fits: the TA length is proportional to 1/alpha, so
+  alpha is multiplied by the ratio between the target and the planned number
+  of generations. The run stops when the remaining time is shorter than the
+  estimated time of one generation, so the budget is used without overrunning it.
+
+  @ingroup Continuators
+*/
+template <class EOT>
+class eoTimeBudgetContinuePopVector: public eoGenerationContinuePopVector<EOT>
+{
+public:
+
+    /**
+     * @brief eoTimeBudgetContinuePopVector Constructor
+     * @param _timeLimit Time limit (in seconds)
+     * @param _coolSchedule TA cooling schedule. It is rescaled in the calibration
+     * @param _numEvalsCounter # evaluations counter, used to report the evaluation throughput
+     * @param _totalGens Maximum number of generations
+     * @param _machineSpeedFactor Time limit multiplier
+     * @param _calibrationTime Calibration time (in seconds)
+     * @param _minGenerations Minimum number of generations of the plan
+     * @param _maxGenerations Maximum number of generations of the plan
+     */
+    eoTimeBudgetContinuePopVector(double _timeLimit, moSimpleCoolingSchedule<EOT> &_coolSchedule,
+                                  eoNumberEvalsCounter const &_numEvalsCounter, unsigned long _totalGens,
+                                  double _machineSpeedFactor = 1.0, double _calibrationTime = 5.0,
+                                  unsigned long _minGenerations = 100, unsigned long _maxGenerations = 10000)
+        : eoGenerationContinuePopVector<EOT>(_totalGens),
+          timeBudget(_timeLimit*_machineSpeedFactor), calibrationTime(_calibrationTime),
+          minGenerations(_minGenerations), maxGenerations(_maxGenerations),
+          coolSchedule(_coolSchedule), numEvalsCounter(_numEvalsCounter),
+          startTime(std::chrono::steady_clock::now()), measureStartTime(startTime),
+          measureGenerations(0), generationTime(0), started(false), calibrated(false)
+    { }
+
+    virtual std::string className(void) const override { return "eoTimeBudgetContinuePopVector"; }
+
+    /** Returns false when the time budget is spent or a certain number of generations is reached
+     */
+    virtual bool operator() (const std::vector<boost::shared_ptr<EOT> >&_pop) override {
+        // Generations limit
+        if (!eoGenerationContinuePopVector<EOT>::operator()(_pop))
+            return false;
+        double elapsed = getElapsedTime();
+        double remaining = timeBudget - elapsed;
+        // Estimate the time of one generation. The first generation also includes
+        // the time spent before the evolution, so it is only a first upper bound
+        if (!started) {
+            generationTime = elapsed;
+            measureStartTime = std::chrono::steady_clock::now();
+            started = true;
+        }
+        else {
+            ++measureGenerations;
+            generationTime = secondsSince(measureStartTime)/measureGenerations;
+        }
+
+        if (!calibrated && elapsed >= calibrationTime)
+            calibrate(elapsed, remaining);
+
+#ifdef EOTIMEBUDGETCONTINUEPOPVECTOR_DEBUG
+        std::cout << "eoTimeBudgetContinuePopVector: elapsed = " << elapsed << " s, remaining = " << remaining
+                  << " s, generation time = " << generationTime << " s" << std::endl;
+#endif
+
+        if (remaining < generationTime || remaining <= 0) {
+            std::cout << "STOP in eoTimeBudgetContinuePopVector: Time budget spent ["
+                      << elapsed << "/" << timeBudget << " s]\n" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /** Returns the time budget (in seconds) */
+    double getTimeBudget() const {
+        return timeBudget;
+    }
+
+    /** Returns the time elapsed since the construction (in seconds) */
+    double getElapsedTime() const {
+        return secondsSince(startTime);
+    }
+
+    /**
+     * @brief saveState Save the continuator state into an evolution checkpoint. Times are
+     * saved as durations, so the budget spent before a resume is not spent again.
+     * The calibrated cooling schedule is saved by the algorithm
+     * @param _writer
+     */
+    virtual void saveState(BinaryWriter &_writer) const override {
+        eoGenerationContinuePopVector<EOT>::saveState(_writer);
+        _writer.put<double>(getElapsedTime());
+        _writer.put<double>(secondsSince(measureStartTime));
+        _writer.put<std::uint64_t>(measureGenerations);
+        _writer.put<double>(generationTime);
+        _writer.put<std::uint8_t>(started);
+        _writer.put<std::uint8_t>(calibrated);
+    }
+
+    /**
+     * @brief loadState Restore the continuator state from an evolution checkpoint
+     * @param _reader
+     */
+    virtual void loadState(BinaryReader &_reader) override {
+        eoGenerationContinuePopVector<EOT>::loadState(_reader);
+        auto now = std::chrono::steady_clock::now();
+        startTime = now - toDuration(_reader.get<double>());
+        measureStartTime = now - toDuration(_reader.get<double>());
+        measureGenerations = _reader.get<std::uint64_t>();
+        generationTime = _reader.get<double>();
+        started = _reader.get<std::uint8_t>() != 0;
+        calibrated = _reader.get<std::uint8_t>() != 0;
+    }
+
+private:
+
+    /**
+     * @brief calibrate Plan the number of generations that fit in the remaining
+     * time and rescale the TA cooling schedule if needed
+     * @param _elapsed Elapsed time
+     * @param _remaining Remaining time
+     */
+    void calibrate(double _elapsed, double _remaining) {
+        calibrated = true;
+        double throughput = numEvalsCounter.getTotalNumEvals()/_elapsed;
+        double plannedGenerations = (generationTime > 0) ? _remaining/generationTime : maxGenerations;
+        // Rescale the TA length if the plan is out of bounds
+        double scale = 1;
+        if (plannedGenerations < minGenerations)
+            scale = plannedGenerations/minGenerations;
+        else if (plannedGenerations > maxGenerations)
+            scale = plannedGenerations/maxGenerations;
+        if (scale != 1) {
+            // TA length is proportional to 1/alpha
+            coolSchedule.alpha /= scale;
+            // The generation time is dominated by the TA
+            generationTime *= scale;
+            plannedGenerations /= scale;
+            // Measure the generation time again with the new schedule
+            measureStartTime = std::chrono::steady_clock::now();
+            measureGenerations = 0;
+        }
+        std::cout << "Time budget calibration: " << throughput << " evaluations/s, "
+                  << "generation time = " << generationTime << " s, "
+                  << "planned # generations = " << std::floor(plannedGenerations) << std::endl
+                  << "TA cooling schedule: " << coolSchedule.initT << ", " << coolSchedule.alpha << ", "
+                  << coolSchedule.span << ", " << coolSchedule.finalT << std::endl;
+    }
+
+    /**
+     * @brief secondsSince
+     * @param _time
+     * @return Seconds elapsed since _time
+     */
+    static double secondsSince(std::chrono::steady_clock::time_point const &_time) {
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - _time;
+        return duration.count();
+    }
+
+    /**
+     * @brief toDuration
+     * @param _seconds
+     * @return Clock duration of _seconds
+     */
+    static std::chrono::steady_clock::duration toDuration(double _seconds) {
+        return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(_seconds));
+    }
+
+    double timeBudget; // Time budget (in seconds)
+    double calibrationTime; // Calibration time (in seconds)
+    unsigned long minGenerations, maxGenerations; // Bounds of the planned # generations
+    moSimpleCoolingSchedule<EOT> &coolSchedule; // TA cooling schedule
+    eoNumberEvalsCounter const &numEvalsCounter; // # evaluations counter
+    std::chrono::steady_clock::time_point startTime; // Start time
+    std::chrono::steady_clock::time_point measureStartTime; // Start time of the generation time measure
+    unsigned long measureGenerations; // # generations since measureStartTime
+    double generationTime; // Estimated time of one generation (in seconds)
+    bool started; // True after the first generation
+    bool calibrated; // True after the calibration
+};
+
+
+
+#endif // EOTIMEBUDGETCONTINUEPOPVECTOR_H
@@ -0,0 +1,185 @@
+#ifndef MOADAPTIVECOOLINGSCHEDULE_H
+#define MOADAPTIVECOOLINGSCHEDULE_H
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include "algorithms/mo/moSimpleCoolingSchedule.h"
+
+
+//#define MOADAPTIVECOOLINGSCHEDULE_DEBUG
+
+
+/**
+ * Adaptive threshold schedule driven by the acceptance rate
+ *
+ * The threshold follows the moSimpleCoolingSchedule law Q(t) = initT*exp(-alpha*t),
+ * but the rate variable t is advanced according to the ratio of accepted moves
+ * over a sliding window of the last windowSize moves. At the end of each span:
+ *   - ratio > highAcceptance: nearly every move is accepted, so the threshold is
+ *     ineffective. Cooling is sped up and t is advanced by speedUp steps.
+ *     The skipped steps are saved as hold credit;
+ *   - lowAcceptance <= ratio <= highAcceptance: the search is productive. The
+ *     threshold is held while there is hold credit, otherwise t is advanced by one step;
+ *   - ratio < lowAcceptance: the search stagnates. The threshold is reheated by
+ *     reheatFactor (without exceeding initT), at most maxReheats times per run.
+ *
+ * The TA length is at most the length of the simple schedule plus the reheats,
+ * because the spans held at productive thresholds are paid by the spans saved
+ * at ineffective ones.
+ */
+template< class EOT >
+class moAdaptiveCoolingSchedule : public moSimpleCoolingSchedule<EOT>
+{
+public:
+    using moSimpleCoolingSchedule<EOT>::initT;
+    using moSimpleCoolingSchedule<EOT>::alpha;
+    using moSimpleCoolingSchedule<EOT>::span;
+    using moSimpleCoolingSchedule<EOT>::step;
+    using moSimpleCoolingSchedule<EOT>::t;
+    using moSimpleCoolingSchedule<EOT>::Temp;
+
+    /**
+     * Constructor
+     * @param _initT initial temperature
+     * @param _alpha factor of decreasing
+     * @param _span number of iteration with equal temperature
+     * @param _finalT final temperature, threshold of the stopping criteria
+     * @param _windowSize number of moves of the acceptance ratio sliding window
+     * @param _lowAcceptance acceptance ratio below which the search is stagnating
+     * @param _highAcceptance acceptance ratio above which cooling is sped up
+     * @param _speedUp number of rate steps per span when cooling is sped up
+     * @param _reheatFactor threshold multiplier on reheat
+     * @param _maxReheats maximum number of reheats per run
+     */
+    moAdaptiveCoolingSchedule(double _initT, double _alpha, unsigned _span, double _finalT,
+                              unsigned _windowSize = 100, double _lowAcceptance = 0.02, double _highAcceptance = 0.9,
+                              unsigned _speedUp = 4, double _reheatFactor = 2, unsigned _maxReheats = 3)
+        : moSimpleCoolingSchedule<EOT>(_initT, _alpha, _span, _finalT),
+          windowSize(std::max(_windowSize, 1u)), lowAcceptance(_lowAcceptance), highAcceptance(_highAcceptance),
+          speedUp(std::max(_speedUp, 1u)), reheatFactor(_reheatFactor), maxReheats(_maxReheats),
+          window(windowSize, 0), windowPos(0), windowCount(0), numAccepted(0), holdCredit(0), numReheats(0) {}
+
+    /**
+     * @brief clone Polymorphic copy, used to give each TA run its own schedule
+     * @return a copy of the schedule
+     */
+    virtual moSimpleCoolingSchedule<EOT>* clone() const override {
+        return new moAdaptiveCoolingSchedule<EOT>(*this);
+    }
+
+    /**
+     * @brief className
+     * @return the schedule name
+     */
+    virtual std::string className() const override {
+        return "moAdaptiveCoolingSchedule";
+    }
+
+    /**
+     * Getter on the initial temperature
+     * @param _solution initial solution
+     * @return the initial temperature
+     */
+    virtual double init(EOT & _solution) override {
+        std::fill(window.begin(), window.end(), 0);
+        windowPos = 0;
+        windowCount = 0;
+        numAccepted = 0;
+        holdCredit = 0;
+        numReheats = 0;
+        return moSimpleCoolingSchedule<EOT>::init(_solution);
+    }
+
+    /**
+     * update the temperature according to the acceptance ratio
+     * @param _temp current temperature to update
+     * @param _acceptedMove true when the move is accepted, false otherwise
+     */
+    virtual void update(double& _temp, bool _acceptedMove) override {
+        // Slide the acceptance window
+        numAccepted += (int)_acceptedMove - window[windowPos];
+        window[windowPos] = _acceptedMove;
+        windowPos = (windowPos+1) % windowSize;
+        if (windowCount < windowSize)
+            ++windowCount;
+
+        if (step < span) {
+            step++;
+            return;
+        }
+        // Set step = 1, not to zero because we are counting the current iteration
+        step = 1;
+        // Until the window is full, follow the simple schedule
+        double ratio = (windowCount < windowSize) ? -1 : (double)numAccepted/windowSize;
+        if (ratio > highAcceptance) {
+            // Ineffective threshold. Speed up cooling
+            t += speedUp;
+            holdCredit += speedUp-1;
+        }
+        else if (ratio >= 0 && ratio < lowAcceptance && numReheats < maxReheats) {
+            // Stagnation. Reheat, going back on the rate variable
+            int reheatSteps = (int)std::ceil(std::log(reheatFactor)/alpha);
+            t = std::max(0, t-reheatSteps);
+            ++numReheats;
+            // Measure the acceptance ratio at the new threshold
+            std::fill(window.begin(), window.end(), 0);
+            windowCount = 0;
+            numAccepted = 0;
+        }
+        else if (ratio >= lowAcceptance && holdCredit > 0) {
+            // Productive threshold. Hold it
+            --holdCredit;
+        }
+        else
+            t = t+1; // Increment rate variable
+        _temp = Temp(t, initT, alpha);
+
+#ifdef MOADAPTIVECOOLINGSCHEDULE_DEBUG
+        std::cout << "[moAdaptiveCoolingSchedule] acceptance ratio = " << ratio << ", t = " << t
+                  << ", temp = " << _temp << ", hold credit = " << holdCredit
+                  << ", # reheats = " << numReheats << std::endl;
+#endif
+    }
+
+    /**
+     * @brief getNumReheats
+     * @return # reheats of the current run
+     */
+    unsigned getNumReheats() const {
+        return numReheats;
+    }
+
+//private:
+    // number of moves of the acceptance ratio sliding window
+    unsigned windowSize;
+    // acceptance ratio below which the search is stagnating
+    double lowAcceptance;
+    // acceptance ratio above which cooling is sped up
+    double highAcceptance;
+    // number of rate steps per span when cooling is sped up
+    unsigned speedUp;
+    // threshold multiplier on reheat
+    double reheatFactor;
+    // maximum number of reheats per run
+    unsigned maxReheats;
+
+private:
+    // Acceptance of the last windowSize moves (circular buffer)
+    std::vector<int> window;
+    // Next position in the window
+    unsigned windowPos;
+    // # moves in the window
+    unsigned windowCount;
+    // # accepted moves in the window
+    int numAccepted;
+    // # spans the threshold can be held
+    long holdCredit;
+    // # reheats of the current run
+    unsigned numReheats;
+};
+
+
+
+#endif // MOADAPTIVECOOLINGSCHEDULE_H
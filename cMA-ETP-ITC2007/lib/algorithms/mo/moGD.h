@@ -0,0 +1,45 @@
+#ifndef MOGD_H
+#define MOGD_H
+
+#include <algo/moLocalSearch.h>
+#include "algorithms/mo/moGDexplorer.h"
+#include <continuator/moTrueContinuator.h>
+#include <eval/moEval.h>
+#include <eoEvalFunc.h>
+
+
+/**
+ * Great Deluge algorithm
+ */
+template<class Neighbor>
+class moGD: public moLocalSearch<Neighbor>
+{
+public:
+
+    typedef typename Neighbor::EOT EOT;
+    typedef moNeighborhood<Neighbor> Neighborhood ;
+
+
+    /**
+     * Simple constructor for a great deluge
+     * @param _neighborhood the neighborhood
+     * @param _fullEval the full evaluation function
+     * @param _eval neighbor's evaluation function
+     * @param _maxIterations # iterations of the search
+     * @param _targetRatio target cost, as a fraction of the initial cost
+     */
+    moGD(Neighborhood& _neighborhood, eoEvalFunc<EOT>& _fullEval, moEval<Neighbor>& _eval,
+         long _maxIterations, double _targetRatio):
+            moLocalSearch<Neighbor>(explorer, trueCont, _fullEval),
+            explorer(_neighborhood, _eval, _maxIterations, _targetRatio)
+    {}
+
+
+private:
+    moTrueContinuator<Neighbor> trueCont;
+    moGDexplorer<Neighbor> explorer;
+};
+
+
+
+#endif // MOGD_H
@@ -0,0 +1,162 @@
+#ifndef MOGDEXPLORER_H
+#define MOGDEXPLORER_H
+
+
+#include <neighborhood/moNeighborhood.h>
+#include "neighbourhood/ETTPNeighborhoodExplorer.h"
+#include "neighbourhood/ETTPneighbor.h"
+
+
+//#define MOGDEXPLORER_DEBUG
+
+
+/**
+ * Explorer for the Great Deluge algorithm (Dueck), as applied to exam timetabling by Burke et al.
+ *
+ * A random neighbour is accepted if it is not worse than the current solution
+ * or than the current level B. The level starts at the initial cost and is
+ * lowered linearly, in the given number of iterations, down to the target cost
+ * (the initial cost multiplied by the target ratio).
+ * Fitness must be > 0
+ *
+ */
+template <class Neighbor>
+class moGDexplorer : public ETTPNeighborhoodExplorer<Neighbor>
+{
+public:
+    typedef typename Neighbor::EOT EOT;
+    typedef moNeighborhood<Neighbor> Neighborhood;
+
+    using moNeighborhoodExplorer<Neighbor>::neighborhood;
+    using moNeighborhoodExplorer<Neighbor>::eval;
+    using moNeighborhoodExplorer<Neighbor>::selectedNeighbor;
+
+    /**
+     * Constructor
+     * @param _neighborhood the neighborhood
+     * @param _eval the evaluation function
+     * @param _maxIterations # iterations of the search
+     * @param _targetRatio target cost, as a fraction of the initial cost
+     */
+    moGDexplorer(Neighborhood& _neighborhood, moEval<Neighbor>& _eval, long _maxIterations, double _targetRatio)
+        : ETTPNeighborhoodExplorer<Neighbor>(_neighborhood, _eval),
+          maxIterations(_maxIterations), targetRatio(_targetRatio), iteration(0), level(0), decayRate(0), isAccept(false) {
+
+        if (!neighborhood.isRandom()) {
+            std::cout << "moGDexplorer::Warning -> the neighborhood used is not random" << std::endl;
+        }
+    }
+
+    /**
+     * Destructor
+     */
+    ~moGDexplorer() { }
+
+    /**
+     * initialization of the level and of its decay rate
+     * @param _solution the solution
+     */
+    virtual void initParam(EOT & _solution) {
+        level = _solution.fitness();
+        decayRate = (maxIterations > 0) ? level*(1-targetRatio)/maxIterations : 0;
+        iteration = 0;
+        isAccept = false;
+    }
+
+    /**
+     * lower the level
+     * @param _solution unused solution
+     */
+    virtual void updateParam(EOT & _solution) {
+        level -= decayRate;
+        ++iteration;
+    }
+
+    /**
+     * terminate: NOTHING TO DO
+     * @param _solution unused solution
+     */
+    virtual void terminate(EOT & _solution) {
+#ifdef MOGDEXPLORER_DEBUG
+        std::cout << "In [moGDexplorer::terminate(sol)] method: # iterations = " << iteration
+                  << ", level = " << level << ", final solution: " << _solution.fitness() << std::endl;
+#endif
+    }
+
+    /**
+     * Explore one random solution in the neighborhood
+     * @param _solution the solution
+     */
+    virtual void operator()(EOT & _solution) {
+        // Test if _solution has a Neighbor
+        if (neighborhood.hasNeighbor(_solution)) {
+            // Init on the first neighbor: supposed to be random solution in the neighborhood
+            neighborhood.init(_solution, selectedNeighbor);
+            // Eval the _solution moved with the neighbor and stock the result in the neighbor
+            eval(_solution, selectedNeighbor);
+        }
+        else {
+            // If _solution hasn't neighbor,
+            isAccept = false;
+        }
+    }
+
+    /**
+     * continue until the number of iterations is reached
+     * @param _solution the solution
+     * @return true if there are iterations left
+     */
+    virtual bool isContinue(EOT & _solution) {
+        return iteration < maxIterations;
+    }
+
+    /**
+     * acceptance criterion of Great Deluge
+     * @param _solution the solution
+     * @return true if the neighbour is feasible and f(s') <= f(s) or f(s') <= B
+     */
+    virtual bool accept(EOT & _solution) {
+        // Test if _solution has a Neighbor
+        if (neighborhood.hasNeighbor(_solution)) {
+            // Downcast selectedNeighbor to ETTPneigbor
+            Neighbor *selectedNeighborPtr = &selectedNeighbor;
+            ETTPneighbor<EOT> *neighbourPtr = (ETTPneighbor<EOT> *)selectedNeighborPtr;
+            if (neighbourPtr != nullptr && !neighbourPtr->isFeasible())
+                isAccept = false;
+            else {
+                double neighbourFitness = selectedNeighbor.fitness();
+                isAccept = neighbourFitness <= _solution.fitness() || neighbourFitness <= level; // Minimization problem
+            }
+            // Credit the operator which built the neighbour
+            if (neighbourPtr != nullptr)
+                neighbourPtr->recordMoveOutcome(isAccept, _solution.fitness());
+
+#ifdef MOGDEXPLORER_DEBUG
+            std::cout << "In [moGDexplorer::accept(sol)] method:" << std::endl;
+            std::cout << "solution: " << _solution.fitness() << " neighbour: " << selectedNeighbor.fitness()
+                      << ", level = " << level << std::endl;
+            std::cout << "Accept solution? " << isAccept << std::endl;
+#endif
+        }
+        return isAccept;
+    }
+
+
+protected:
+
+    // # iterations of the search
+    long maxIterations;
+    // Target cost, as a fraction of the initial cost
+    double targetRatio;
+    // Current iteration
+    long iteration;
+    // Current level B
+    double level;
+    // Level decrease per iteration
+    double decayRate;
+    // true if the move is accepted
+    bool isAccept;
+};
+
+
+#endif // MOGDEXPLORER_H
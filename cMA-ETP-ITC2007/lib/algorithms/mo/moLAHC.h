@@ -0,0 +1,45 @@
+#ifndef MOLAHC_H
+#define MOLAHC_H
+
+#include <algo/moLocalSearch.h>
+#include "algorithms/mo/moLAHCexplorer.h"
+#include <continuator/moTrueContinuator.h>
+#include <eval/moEval.h>
+#include <eoEvalFunc.h>
+
+
+/**
+ * Late Acceptance Hill Climbing algorithm
+ */
+template<class Neighbor>
+class moLAHC: public moLocalSearch<Neighbor>
+{
+public:
+
+    typedef typename Neighbor::EOT EOT;
+    typedef moNeighborhood<Neighbor> Neighborhood ;
+
+
+    /**
+     * Simple constructor for a late acceptance hill climbing
+     * @param _neighborhood the neighborhood
+     * @param _fullEval the full evaluation function
+     * @param _eval neighbor's evaluation function
+     * @param _historyLength length L of the cost history list
+     * @param _maxIterations # iterations of the search
+     */
+    moLAHC(Neighborhood& _neighborhood, eoEvalFunc<EOT>& _fullEval, moEval<Neighbor>& _eval,
+           int _historyLength, long _maxIterations):
+            moLocalSearch<Neighbor>(explorer, trueCont, _fullEval),
+            explorer(_neighborhood, _eval, _historyLength, _maxIterations)
+    {}
+
+
+private:
+    moTrueContinuator<Neighbor> trueCont;
+    moLAHCexplorer<Neighbor> explorer;
+};
+
+
+
+#endif // MOLAHC_H
@@ -0,0 +1,160 @@
+#ifndef MOLAHCEXPLORER_H
+#define MOLAHCEXPLORER_H
+
+
+#include <neighborhood/moNeighborhood.h>
+#include "neighbourhood/ETTPNeighborhoodExplorer.h"
+#include "neighbourhood/ETTPneighbor.h"
+#include <vector>
+#include <algorithm>
+
+
+//#define MOLAHCEXPLORER_DEBUG
+
+
+/**
+ * Explorer for the Late Acceptance Hill Climbing algorithm (Burke and Bykov)
+ *
+ * A random neighbour is accepted if it is not worse than the current solution
+ * or than the solution of L iterations ago. The costs of the last L iterations
+ * are kept in a circular history list, initialised with the initial cost.
+ * The search runs for a fixed number of iterations.
+ * Fitness must be > 0
+ *
+ */
+template <class Neighbor>
+class moLAHCexplorer : public ETTPNeighborhoodExplorer<Neighbor>
+{
+public:
+    typedef typename Neighbor::EOT EOT;
+    typedef moNeighborhood<Neighbor> Neighborhood;
+
+    using moNeighborhoodExplorer<Neighbor>::neighborhood;
+    using moNeighborhoodExplorer<Neighbor>::eval;
+    using moNeighborhoodExplorer<Neighbor>::selectedNeighbor;
+
+    /**
+     * Constructor
+     * @param _neighborhood the neighborhood
+     * @param _eval the evaluation function
+     * @param _historyLength length L of the cost history list
+     * @param _maxIterations # iterations of the search
+     */
+    moLAHCexplorer(Neighborhood& _neighborhood, moEval<Neighbor>& _eval, int _historyLength, long _maxIterations)
+        : ETTPNeighborhoodExplorer<Neighbor>(_neighborhood, _eval),
+          history(std::max(_historyLength, 1)), maxIterations(_maxIterations), iteration(0), isAccept(false) {
+
+        if (!neighborhood.isRandom()) {
+            std::cout << "moLAHCexplorer::Warning -> the neighborhood used is not random" << std::endl;
+        }
+    }
+
+    /**
+     * Destructor
+     */
+    ~moLAHCexplorer() { }
+
+    /**
+     * initialization of the cost history list with the initial cost
+     * @param _solution the solution
+     */
+    virtual void initParam(EOT & _solution) {
+        std::fill(history.begin(), history.end(), _solution.fitness());
+        iteration = 0;
+        isAccept = false;
+    }
+
+    /**
+     * replace the oldest cost of the history list by the current cost
+     * @param _solution the solution
+     */
+    virtual void updateParam(EOT & _solution) {
+        history[iteration % history.size()] = _solution.fitness();
+        ++iteration;
+    }
+
+    /**
+     * terminate: NOTHING TO DO
+     * @param _solution unused solution
+     */
+    virtual void terminate(EOT & _solution) {
+#ifdef MOLAHCEXPLORER_DEBUG
+        std::cout << "In [moLAHCexplorer::terminate(sol)] method: # iterations = " << iteration
+                  << ", final solution: " << _solution.fitness() << std::endl;
+#endif
+    }
+
+    /**
+     * Explore one random solution in the neighborhood
+     * @param _solution the solution
+     */
+    virtual void operator()(EOT & _solution) {
+        // Test if _solution has a Neighbor
+        if (neighborhood.hasNeighbor(_solution)) {
+            // Init on the first neighbor: supposed to be random solution in the neighborhood
+            neighborhood.init(_solution, selectedNeighbor);
+            // Eval the _solution moved with the neighbor and stock the result in the neighbor
+            eval(_solution, selectedNeighbor);
+        }
+        else {
+            // If _solution hasn't neighbor,
+            isAccept = false;
+        }
+    }
+
+    /**
+     * continue until the number of iterations is reached
+     * @param _solution the solution
+     * @return true if there are iterations left
+     */
+    virtual bool isContinue(EOT & _solution) {
+        return iteration < maxIterations;
+    }
+
+    /**
+     * acceptance criterion of Late Acceptance Hill Climbing
+     * @param _solution the solution
+     * @return true if the neighbour is feasible and f(s') <= f(s) or f(s') <= f(s L iterations ago)
+     */
+    virtual bool accept(EOT & _solution) {
+        // Test if _solution has a Neighbor
+        if (neighborhood.hasNeighbor(_solution)) {
+            // Downcast selectedNeighbor to ETTPneigbor
+            Neighbor *selectedNeighborPtr = &selectedNeighbor;
+            ETTPneighbor<EOT> *neighbourPtr = (ETTPneighbor<EOT> *)selectedNeighborPtr;
+            if (neighbourPtr != nullptr && !neighbourPtr->isFeasible())
+                isAccept = false;
+            else {
+                double neighbourFitness = selectedNeighbor.fitness();
+                isAccept = neighbourFitness <= _solution.fitness() ||
+                           neighbourFitness <= history[iteration % history.size()]; // Minimization problem
+            }
+            // Credit the operator which built the neighbour
+            if (neighbourPtr != nullptr)
+                neighbourPtr->recordMoveOutcome(isAccept, _solution.fitness());
+
+#ifdef MOLAHCEXPLORER_DEBUG
+            std::cout << "In [moLAHCexplorer::accept(sol)] method:" << std::endl;
+            std::cout << "solution: " << _solution.fitness() << " neighbour: " << selectedNeighbor.fitness()
+                      << ", late cost = " << history[iteration % history.size()] << std::endl;
+            std::cout << "Accept solution? " << isAccept << std::endl;
+#endif
+        }
+        return isAccept;
+    }
+
+
+protected:
+
+    // Costs of the last L iterations
+    std::vector<double> history;
+    // # iterations of the search
+    long maxIterations;
+    // Current iteration
+    long iteration;
+    // true if the move is accepted
+    bool isAccept;
+};
+
+
+#endif // MOLAHCEXPLORER_H
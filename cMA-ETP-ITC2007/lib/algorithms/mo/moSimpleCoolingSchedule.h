@@ -3,6 +3,8 @@
 
 
 #include <cmath>
+#include <algorithm>
+#include <string>
 
 /*
   <moSimpleCoolingSchedule.h>
@@ -59,6 +61,27 @@ public:
     moSimpleCoolingSchedule(double _initT, double _alpha, unsigned _span, double _finalT)
         : initT(_initT), alpha(_alpha), span(_span), finalT(_finalT), step(0), t(0) {}
 
+    /**
+     * Destructor
+     */
+    virtual ~moSimpleCoolingSchedule() {}
+
+    /**
+     * @brief clone Polymorphic copy, used to give each TA run its own schedule
+     * @return a copy of the schedule
+     */
+    virtual moSimpleCoolingSchedule<EOT>* clone() const {
+        return new moSimpleCoolingSchedule<EOT>(*this);
+    }
+
+    /**
+     * @brief className
+     * @return the schedule name
+     */
+    virtual std::string className() const {
+        return "moSimpleCoolingSchedule";
+    }
+
     /**
      * Getter on the initial temperature
      * @param _solution initial solution
@@ -88,6 +111,16 @@ public:
             step++;
     }
 
+    /**
+     * @brief getNumIterations
+     * @return Nominal # iterations of the schedule: span iterations at each temperature
+     * initT*exp(-alpha*t) above finalT, as counted by getSANumberEvaluations
+     */
+    long getNumIterations() const {
+        long numTemperatures = std::max(1L, (long)std::ceil(std::log(initT/finalT)/alpha));
+        return numTemperatures*span;
+    }
+
     // Acrescentei
     // Temperature actualization
     double Temp(double t, double Tmax, double R) {
@@ -0,0 +1,50 @@
+#ifndef MOTABATCH_H
+#define MOTABATCH_H
+
+#include <algo/moLocalSearch.h>
+#include "algorithms/mo/moTAbatchExplorer.h"
+#include <continuator/moTrueContinuator.h>
+#include <eval/moEval.h>
+#include <eoEvalFunc.h>
+#include "algorithms/mo/moSimpleCoolingSchedule.h"
+
+
+/**
+ * Threshold Accepting algorithm evaluating a batch of K neighbours per iteration
+ */
+template<class EOT>
+class moTAbatch: public moLocalSearch<ETTPneighbor<EOT> >
+{
+public:
+
+    typedef ETTPneighbor<EOT> Neighbor;
+    typedef moNeighborhood<Neighbor> Neighborhood ;
+
+
+    /**
+     * Simple constructor for a batched threshold accepting
+     * @param _neighborhood the neighborhood
+     * @param _fullEval the full evaluation function
+     * @param _eval neighbor's evaluation function
+     * @param _cool a cooling schedule
+     * @param _kempeChainHeuristics One Kempe chain heuristic per candidate. The batch size K is the vector size
+     * @param _batchAcceptance Rule for selecting the candidate submitted to the threshold test
+     */
+    moTAbatch(Neighborhood& _neighborhood, eoEvalFunc<EOT>& _fullEval, moEval<Neighbor>& _eval,
+              moCoolingSchedule<EOT>& _cool,
+              std::vector<boost::shared_ptr<ETTPKempeChainHeuristic<EOT> > > const &_kempeChainHeuristics,
+              BatchAcceptance _batchAcceptance = BatchAcceptance::BestCandidate):
+            moLocalSearch<Neighbor>(explorer, trueCont, _fullEval),
+            explorer(_neighborhood, _eval, defaultSolNeighborComp, _cool, _kempeChainHeuristics, _batchAcceptance)
+    {}
+
+
+private:
+    moTrueContinuator<Neighbor> trueCont;
+    moSolNeighborComparator<Neighbor> defaultSolNeighborComp;
+    moTAbatchExplorer<EOT> explorer;
+};
+
+
+
+#endif // MOTABATCH_H
@@ -0,0 +1,146 @@
+#ifndef MOTABATCHEXPLORER_H
+#define MOTABATCHEXPLORER_H
+
+
+#include "algorithms/mo/moTAexplorer.h"
+#include "kempeChain/ETTPKempeChainHeuristic.h"
+#include "neighbourhood/ETTPneighbor.h"
+#include <boost/shared_ptr.hpp>
+#include <vector>
+#include <stdexcept>
+
+
+//#define MOTABATCHEXPLORER_DEBUG
+
+
+/**
+ * @brief The BatchAcceptance enum Rule for selecting the candidate submitted to the threshold test
+ *   - BestCandidate: all K candidates are evaluated and the best feasible one is selected
+ *   - FirstAcceptable: candidates are evaluated in order until one is accepted by the threshold rule
+ */
+enum class BatchAcceptance { BestCandidate, FirstAcceptable };
+
+
+
+/**
+ * Batched explorer for the Threshold Accepting algorithm
+ *
+ * In each iteration, K neighbours of the current solution are built and
+ * evaluated, and one of them is selected according to the batch acceptance
+ * rule. The selected neighbour is then submitted to the threshold test of
+ * moTAexplorer. Each candidate has its own Kempe chain heuristic, because the
+ * Kempe chain of the selected neighbour is used to move the solution.
+ *
+ * The candidates are evaluated one after the other, because the incremental
+ * evaluation temporarily moves the solution to the neighbour and undoes the move.
+ * The per-iteration overhead of the moLocalSearch machinery is spread over K evaluations.
+ * Fitness must be > 0
+ *
+ */
+template <class EOT>
+class moTAbatchExplorer : public moTAexplorer<ETTPneighbor<EOT> >
+{
+public:
+    typedef ETTPneighbor<EOT> Neighbor;
+    typedef moNeighborhood<Neighbor> Neighborhood;
+
+    using moNeighborhoodExplorer<Neighbor>::neighborhood;
+    using moNeighborhoodExplorer<Neighbor>::eval;
+    using moNeighborhoodExplorer<Neighbor>::selectedNeighbor;
+    using moTAexplorer<Neighbor>::isAccept;
+    using moTAexplorer<Neighbor>::q;
+
+    /**
+     * Constructor
+     * @param _neighborhood the neighborhood
+     * @param _eval the evaluation function
+     * @param _solNeighborComparator a solution vs neighbor comparator
+     * @param _coolingSchedule the cooling schedule
+     * @param _kempeChainHeuristics One Kempe chain heuristic per candidate. The batch size K is the vector size
+     * @param _batchAcceptance Rule for selecting the candidate submitted to the threshold test
+     */
+    moTAbatchExplorer(Neighborhood& _neighborhood, moEval<Neighbor>& _eval,
+                      moSolNeighborComparator<Neighbor>& _solNeighborComparator, moCoolingSchedule<EOT>& _coolingSchedule,
+                      std::vector<boost::shared_ptr<ETTPKempeChainHeuristic<EOT> > > const &_kempeChainHeuristics,
+                      BatchAcceptance _batchAcceptance = BatchAcceptance::BestCandidate)
+        : moTAexplorer<Neighbor>(_neighborhood, _eval, _solNeighborComparator, _coolingSchedule),
+          candidates(_kempeChainHeuristics.size()), batchAcceptance(_batchAcceptance) {
+
+        if (_kempeChainHeuristics.empty())
+            throw std::runtime_error("In [moTAbatchExplorer]: the batch size must be at least 1");
+        // Each candidate uses its own Kempe chain heuristic
+        for (int k = 0; k < candidates.size(); ++k)
+            candidates[k].setKempeChainHeuristic(_kempeChainHeuristics[k]);
+    }
+
+    /**
+     * Destructor
+     */
+    ~moTAbatchExplorer() { }
+
+    /**
+     * Build and evaluate a batch of random neighbours and select one of them
+     * @param _solution the solution
+     */
+    virtual void operator()(EOT & _solution) override {
+        // Test if _solution has a Neighbor
+        if (!neighborhood.hasNeighbor(_solution)) {
+            // If _solution hasn't neighbor,
+            isAccept = false;
+            return;
+        }
+        int selected = -1;
+        int numEvaluated = 0;
+        for (int k = 0; k < candidates.size(); ++k) {
+            // Build a random neighbour and evaluate it
+            numEvaluated = k+1;
+            candidates[k].build(_solution);
+            eval(_solution, candidates[k]);
+            if (!candidates[k].isFeasible())
+                continue;
+            if (selected < 0 || candidates[k].fitness() < candidates[selected].fitness())
+                selected = k;
+            // Stop on the first candidate accepted by the threshold rule
+            if (batchAcceptance == BatchAcceptance::FirstAcceptable &&
+                    candidates[k].fitness() - _solution.fitness() <= q) {
+                selected = k;
+                break;
+            }
+        }
+        // If all candidates are infeasible, the last one is selected and will be rejected
+        if (selected < 0)
+            selected = numEvaluated-1;
+        // Credit the operators of the discarded candidates
+        for (int k = 0; k < numEvaluated; ++k) {
+            if (k != selected)
+                candidates[k].recordMoveOutcome(false, _solution.fitness());
+        }
+        // The selected neighbour keeps the Kempe chain used to move the solution
+        selectedNeighbor = candidates[selected];
+
+#ifdef MOTABATCHEXPLORER_DEBUG
+        std::cout << "In [moTAbatchExplorer::operator()(sol)] method:" << std::endl;
+        std::cout << "solution: " << _solution.fitness() << ", # evaluated candidates: " << numEvaluated
+                  << ", selected candidate: " << selected << " (" << selectedNeighbor.fitness() << ")" << std::endl;
+#endif
+    }
+
+    /**
+     * @brief getBatchSize
+     * @return # candidates evaluated per iteration
+     */
+    int getBatchSize() const {
+        return candidates.size();
+    }
+
+
+protected:
+
+    // Candidate neighbours
+    std::vector<Neighbor> candidates;
+    // Rule for selecting the candidate submitted to the threshold test
+    BatchAcceptance batchAcceptance;
+};
+
+
+#endif // MOTABATCHEXPLORER_H
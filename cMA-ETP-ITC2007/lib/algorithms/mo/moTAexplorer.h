@@ -151,6 +151,8 @@ public:
             ETTPneighbor<EOT> *neighbourPtr = (ETTPneighbor<EOT> *)selectedNeighborPtr;
             if (neighbourPtr != nullptr && !neighbourPtr->isFeasible()) {
                 isAccept = false;
+                // Credit the operator which built the neighbour
+                neighbourPtr->recordMoveOutcome(isAccept, _solution.fitness());
 #ifdef MOTAEXPLORER_DEBUG
             std::cout << "In [moTAexplorer::accept(sol)] method:" << std::endl;
             std::cout << "Infeasible solution, it will not be accepted. Generating a new one..." << std::endl;
@@ -165,6 +167,9 @@ public:
             else {
                 isAccept = false;
             }
+            // Credit the operator which built the neighbour
+            if (neighbourPtr != nullptr)
+                neighbourPtr->recordMoveOutcome(isAccept, _solution.fitness());
 
 #ifdef MOTAEXPLORER_DEBUG
             std::cout << "In [moTAexplorer::accept(sol)] method:" << std::endl;
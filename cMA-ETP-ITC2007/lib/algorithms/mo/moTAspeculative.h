@@ -0,0 +1,51 @@
+#ifndef MOTASPECULATIVE_H
+#define MOTASPECULATIVE_H
+
+#include <algo/moLocalSearch.h>
+#include "algorithms/mo/moTAspeculativeExplorer.h"
+#include <continuator/moTrueContinuator.h>
+#include <eval/moEval.h>
+#include <eoEvalFunc.h>
+#include "algorithms/mo/moSimpleCoolingSchedule.h"
+
+
+/**
+ * Threshold Accepting algorithm evaluating W neighbours in parallel per iteration (speculative moves)
+ */
+template<class EOT>
+class moTAspeculative: public moLocalSearch<ETTPneighbor<EOT> >
+{
+public:
+
+    typedef ETTPneighbor<EOT> Neighbor;
+    typedef moNeighborhood<Neighbor> Neighborhood ;
+
+
+    /**
+     * Simple constructor for a speculative threshold accepting
+     * @param _neighborhood the neighborhood
+     * @param _fullEval the full evaluation function
+     * @param _eval neighbor's evaluation function
+     * @param _cool a cooling schedule
+     * @param _kempeChainHeuristics One Kempe chain heuristic per thread. The # threads W is the vector size
+     * @param _numEvalsCounter # evaluations counter
+     * @param _workerPool Worker threads, with at least W-1 workers
+     */
+    moTAspeculative(Neighborhood& _neighborhood, eoEvalFunc<EOT>& _fullEval, moEval<Neighbor>& _eval,
+                    moCoolingSchedule<EOT>& _cool,
+                    std::vector<boost::shared_ptr<ETTPKempeChainHeuristic<EOT> > > const &_kempeChainHeuristics,
+                    eoNumberEvalsCounter &_numEvalsCounter, WorkerPool &_workerPool):
+            moLocalSearch<Neighbor>(explorer, trueCont, _fullEval),
+            explorer(_neighborhood, _eval, defaultSolNeighborComp, _cool, _kempeChainHeuristics, _numEvalsCounter, _workerPool)
+    {}
+
+
+private:
+    moTrueContinuator<Neighbor> trueCont;
+    moSolNeighborComparator<Neighbor> defaultSolNeighborComp;
+    moTAspeculativeExplorer<EOT> explorer;
+};
+
+
+
+#endif // MOTASPECULATIVE_H
@@ -0,0 +1,293 @@
+#ifndef MOTASPECULATIVEEXPLORER_H
+#define MOTASPECULATIVEEXPLORER_H
+
+
+#include "algorithms/mo/moTAexplorer.h"
+#include "kempeChain/ETTPKempeChainHeuristic.h"
+#include "neighbourhood/ETTPneighbor.h"
+#include "eval/eoNumberEvalsCounter.h"
+#include "utils/WorkerPool.h"
+#include <utils/eoRNG.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <vector>
+#include <functional>
+#include <stdexcept>
+
+
+//#define MOTASPECULATIVEEXPLORER_DEBUG
+
+
+/**
+ * Speculative parallel explorer for the Threshold Accepting algorithm
+ *
+ * In each round, each of the W threads builds and evaluates one Kempe chain move
+ * on its own snapshot of the current solution. The snapshots are copies of the
+ * solution, because the evaluation temporarily moves the solution to the neighbour.
+ * Each thread has its own Kempe chain heuristic and random number generator. The
+ * threads belong to a worker pool shared by the local search runs of an evolution, so
+ * no thread is created per run, and they are parked while the moves are committed.
+ *
+ * The moves are then committed in thread order by the calling thread:
+ *   - the first move accepted by the threshold rule is the selected neighbour,
+ *     which is applied to the solution by the local search;
+ *   - each subsequent move accepted against the snapshot is re-checked against the
+ *     current solution before being applied. All the exams touched by a Kempe chain
+ *     lie in its periods ti and tj, so if these periods were not touched by the
+ *     moves already committed in the round, the chain is still valid and it is only
+ *     re-evaluated. Otherwise, the move conflicts with a committed move and its
+ *     chain is rebuilt on the current solution. The move is applied if the
+ *     re-checked neighbour passes the threshold test.
+ * Finally, the committed moves are replayed on the snapshots.
+ *
+ * The threshold is updated once per evaluated move, so the cooling schedule has
+ * the same length in evaluations as in the sequential algorithm.
+ * Fitness must be > 0
+ *
+ */
+template <class EOT>
+class moTAspeculativeExplorer : public moTAexplorer<ETTPneighbor<EOT> >
+{
+public:
+    typedef ETTPneighbor<EOT> Neighbor;
+    typedef moNeighborhood<Neighbor> Neighborhood;
+
+    using moNeighborhoodExplorer<Neighbor>::neighborhood;
+    using moNeighborhoodExplorer<Neighbor>::selectedNeighbor;
+    using moTAexplorer<Neighbor>::isAccept;
+    using moTAexplorer<Neighbor>::q;
+    using moTAexplorer<Neighbor>::coolingSchedule;
+
+    /**
+     * Constructor
+     * @param _neighborhood the neighborhood
+     * @param _eval the evaluation function
+     * @param _solNeighborComparator a solution vs neighbor comparator
+     * @param _coolingSchedule the cooling schedule
+     * @param _kempeChainHeuristics One Kempe chain heuristic per thread. The # threads W is the vector size
+     * @param _numEvalsCounter # evaluations counter. The threads don't use _eval, so the evaluations are counted here
+     * @param _workerPool Worker threads. Candidate 0 is built by the calling thread and the others by W-1 workers
+     */
+    moTAspeculativeExplorer(Neighborhood& _neighborhood, moEval<Neighbor>& _eval,
+                            moSolNeighborComparator<Neighbor>& _solNeighborComparator, moCoolingSchedule<EOT>& _coolingSchedule,
+                            std::vector<boost::shared_ptr<ETTPKempeChainHeuristic<EOT> > > const &_kempeChainHeuristics,
+                            eoNumberEvalsCounter &_numEvalsCounter, WorkerPool &_workerPool)
+        : moTAexplorer<Neighbor>(_neighborhood, _eval, _solNeighborComparator, _coolingSchedule),
+          numThreads(_kempeChainHeuristics.size()), candidates(numThreads), snapshots(numThreads),
+          numEvalsCounter(_numEvalsCounter), selectedCandidate(0), roundFitness(0),
+          numRounds(0), numCommitted(0), numReevaluated(0), numRebuilt(0),
+          workerPool(_workerPool), buildTask([this](int _k) { buildCandidate(_k); }) {
+
+        if (_kempeChainHeuristics.empty())
+            throw std::runtime_error("In [moTAspeculativeExplorer]: the # threads must be at least 1");
+        if (numThreads-1 > workerPool.getNumWorkers())
+            throw std::runtime_error("In [moTAspeculativeExplorer]: the worker pool has fewer than W-1 workers");
+        for (int k = 0; k < numThreads; ++k) {
+            // Each thread has its own random number generator, seeded from the global one
+            randomGenerators.push_back(boost::make_shared<eoRng>(rng.rand()));
+            _kempeChainHeuristics[k]->setRandomGenerator(*randomGenerators[k].get());
+            candidates[k].setKempeChainHeuristic(_kempeChainHeuristics[k]);
+        }
+    }
+
+    /**
+     * initialization of the initial temperature and of the solution snapshots
+     * @param _solution the solution
+     */
+    virtual void initParam(EOT & _solution) override {
+        moTAexplorer<Neighbor>::initParam(_solution);
+        for (int k = 0; k < numThreads; ++k)
+            snapshots[k] = boost::make_shared<EOT>(_solution); // Invoke the copy ctor
+    }
+
+    /**
+     * decrease the temperature once per evaluated move. The committed
+     * moves are reported as accepted and the other ones as rejected
+     * @param _solution unused solution
+     */
+    virtual void updateParam(EOT & _solution) override {
+        int numAccepted = this->moveApplied() ? committedCandidates.size() : 0;
+        for (int k = 0; k < numThreads; ++k)
+            coolingSchedule.update(q, k < numAccepted);
+    }
+
+    /**
+     * terminate
+     * @param _solution unused solution
+     */
+    virtual void terminate(EOT & _solution) override {
+#ifdef MOTASPECULATIVEEXPLORER_DEBUG
+        std::cout << "In [moTAspeculativeExplorer::terminate(sol)] method:" << std::endl;
+        std::cout << "# rounds = " << numRounds << ", # committed = " << numCommitted
+                  << ", # re-evaluated = " << numReevaluated << ", # rebuilt = " << numRebuilt << std::endl;
+#endif
+    }
+
+    /**
+     * Build and evaluate one neighbour per thread and select the first accepted one
+     * @param _solution the solution
+     */
+    virtual void operator()(EOT & _solution) override {
+        // Test if _solution has a Neighbor
+        if (!neighborhood.hasNeighbor(_solution)) {
+            // If _solution hasn't neighbor,
+            isAccept = false;
+            return;
+        }
+        // Build the candidates in parallel. The calling thread builds candidate 0
+        workerPool.run(buildTask, numThreads);
+        ++numRounds;
+        // # evals statistics computation. Add W to # evals
+        numEvalsCounter.addNumEvalsToGenerationTotal(numThreads);
+
+        // Select the first candidate accepted by the threshold rule.
+        // If there is none, candidate 0 is selected and will be rejected
+        roundFitness = _solution.fitness();
+        selectedCandidate = 0;
+        while (selectedCandidate < numThreads && !isAcceptable(candidates[selectedCandidate], roundFitness))
+            ++selectedCandidate;
+        if (selectedCandidate == numThreads) {
+            selectedCandidate = 0;
+            // Credit the operators of the remaining rejected candidates
+            for (int k = 1; k < numThreads; ++k)
+                candidates[k].recordMoveOutcome(false, roundFitness);
+        }
+        else {
+            // Credit the operators of the rejected candidates preceding the selected one.
+            // The ones following it are committed or rejected in move()
+            for (int k = 0; k < selectedCandidate; ++k)
+                candidates[k].recordMoveOutcome(false, roundFitness);
+        }
+        selectedNeighbor = candidates[selectedCandidate];
+
+#ifdef MOTASPECULATIVEEXPLORER_DEBUG
+        std::cout << "In [moTAspeculativeExplorer::operator()(sol)] method:" << std::endl;
+        std::cout << "solution: " << roundFitness << ", selected candidate: " << selectedCandidate
+                  << " (" << selectedNeighbor.fitness() << ")" << std::endl;
+#endif
+    }
+
+    /**
+     * Move the solution on the selected neighbour, commit the subsequent accepted
+     * candidates and replay the committed moves on the snapshots
+     * @param _solution the solution
+     */
+    virtual void move(EOT & _solution) override {
+        // Move the solution on the selected neighbour
+        ETTPNeighborhoodExplorer<Neighbor>::move(_solution);
+        committedCandidates.clear();
+        committedCandidates.push_back(selectedCandidate);
+        for (int k = selectedCandidate+1; k < numThreads; ++k) {
+            Neighbor &candidate = candidates[k];
+            bool accepted = false;
+            // Only the candidates accepted against the snapshot are re-checked
+            if (isAcceptable(candidate, roundFitness)) {
+                double solutionFitness = _solution.fitness();
+                if (touchesCommittedPeriods(candidate)) {
+                    // Conflicting move. Rebuild its Kempe chain on the current solution
+                    candidate.rebuildMove(_solution);
+                    ++numRebuilt;
+                }
+                else {
+                    // Independent move. Its Kempe chain is still valid
+                    candidate.reevaluateMove(_solution);
+                    ++numReevaluated;
+                }
+                numEvalsCounter.addNumEvalsToGenerationTotal(1);
+                if (isAcceptable(candidate, solutionFitness)) {
+                    // Commit the move
+                    candidate.move(_solution);
+                    _solution.setSolutionCost(candidate.getSolutionCost());
+                    _solution.fitness(_solution.getSolutionCost());
+                    committedCandidates.push_back(k);
+                    accepted = true;
+                }
+                candidate.recordMoveOutcome(accepted, solutionFitness);
+            }
+            else
+                candidate.recordMoveOutcome(false, roundFitness);
+        }
+        numCommitted += committedCandidates.size();
+        // Replay the committed moves on the snapshots
+        for (int k = 0; k < numThreads; ++k) {
+            EOT &snapshot = *snapshots[k].get();
+            for (int c : committedCandidates)
+                candidates[c].move(snapshot);
+            snapshot.setSolutionCost(_solution.getSolutionCost());
+            snapshot.fitness(_solution.fitness());
+        }
+    }
+
+    /**
+     * @brief getNumThreads
+     * @return # threads
+     */
+    int getNumThreads() const {
+        return numThreads;
+    }
+
+
+protected:
+
+    /**
+     * @brief buildCandidate Build and evaluate candidate _k on snapshot _k
+     * @param _k
+     */
+    void buildCandidate(int _k) {
+        EOT &snapshot = *snapshots[_k].get();
+        candidates[_k].build(snapshot);
+        candidates[_k].evaluateMove(snapshot);
+    }
+
+    /**
+     * @brief isAcceptable
+     * @param _candidate
+     * @param _solutionFitness
+     * @return true if _candidate is feasible and f(candidate) - f(s) <= Q
+     */
+    bool isAcceptable(Neighbor &_candidate, double _solutionFitness) const {
+        return _candidate.isFeasible() && _candidate.fitness() - _solutionFitness <= q;
+    }
+
+    /**
+     * @brief touchesCommittedPeriods
+     * @param _candidate
+     * @return true if the Kempe chain of _candidate touches a period touched by a committed move of the round
+     */
+    bool touchesCommittedPeriods(Neighbor &_candidate) {
+        auto const &kempeChain = _candidate.getKempeChain();
+        for (int c : committedCandidates) {
+            auto const &committedChain = candidates[c].getKempeChain();
+            if (kempeChain.getTi() == committedChain.getTi() || kempeChain.getTi() == committedChain.getTj() ||
+                kempeChain.getTj() == committedChain.getTi() || kempeChain.getTj() == committedChain.getTj())
+                return true;
+        }
+        return false;
+    }
+
+    // # threads
+    int numThreads;
+    // Candidate neighbours, one per thread
+    std::vector<Neighbor> candidates;
+    // Solution snapshots, one per thread
+    std::vector<boost::shared_ptr<EOT> > snapshots;
+    // Random number generators, one per thread
+    std::vector<boost::shared_ptr<eoRng> > randomGenerators;
+    // # evaluations counter
+    eoNumberEvalsCounter &numEvalsCounter;
+    // Index of the selected candidate in the current round
+    int selectedCandidate;
+    // Solution fitness at the beginning of the current round
+    double roundFitness;
+    // Candidates committed in the current round
+    std::vector<int> committedCandidates;
+    // Statistics
+    long numRounds, numCommitted, numReevaluated, numRebuilt;
+    // Worker threads
+    WorkerPool &workerPool;
+    // Task run by thread k in each round: build candidate k
+    std::function<void(int)> buildTask;
+};
+
+
+#endif // MOTASPECULATIVEEXPLORER_H
@@ -488,9 +488,10 @@ void eoChromosome::computeFitness() {
 
 #ifdef IMPL2
 /**
- * @brief computeCost
+ * @brief eoChromosome::computeSoftConstraintCosts Compute the cost of each soft constraint from scratch
+ * @return
  */
-void eoChromosome::computeCost() {
+SoftConstraintCosts eoChromosome::computeSoftConstraintCosts() {
     int two_exams_in_a_row = 0;
     int two_exams_in_a_day = 0;
     int period_spread = 0;
@@ -819,8 +820,25 @@ void eoChromosome::computeCost() {
     cout << "Room penalty: " << room_penalty << endl;
     cout << "Period penalty: " << period_penalty << endl;
 #endif
-    solutionCost = two_exams_in_a_row + two_exams_in_a_day + period_spread + mixed_durations
-            + front_load + room_penalty + period_penalty;
+    SoftConstraintCosts costs;
+    costs.twoInARow = two_exams_in_a_row;
+    costs.twoInADay = two_exams_in_a_day;
+    costs.periodSpread = period_spread;
+    costs.mixedDurations = mixed_durations;
+    costs.frontLoad = front_load;
+    costs.roomPenalty = room_penalty;
+    costs.periodPenalty = period_penalty;
+    return costs;
+}
+
+
+/**
+ * @brief computeCost
+ */
+void eoChromosome::computeCost() {
+    SoftConstraintCosts costs = computeSoftConstraintCosts();
+    solutionCost = costs.twoInARow + costs.twoInADay + costs.periodSpread + costs.mixedDurations
+            + costs.frontLoad + costs.roomPenalty + costs.periodPenalty;
 }
 
 #endif
@@ -935,12 +953,6 @@ void eoChromosome::init(TimetableProblemData const* _timetableProblemData) {
  * @param _kempeChain
  */
 void eoChromosome::computeSolutionCostIncremental(const ETTPKempeChain<eoChromosome> &_kempeChain) {
-    // Source Ti and Tj exams
-    std::vector<typename ETTPKempeChain<eoChromosome>::ExamRoomTuple> const &srcTiExams = _kempeChain.getOriginalTiPeriodExams();
-    std::vector<typename ETTPKempeChain<eoChromosome>::ExamRoomTuple> const &srcTjExams = _kempeChain.getOriginalTjPeriodExams();
-    // Dest Ti and Tj exams
-    std::vector<typename ETTPKempeChain<eoChromosome>::ExamRoomTuple> const &destTiExams = _kempeChain.getFinalTiPeriodExams();
-    std::vector<typename ETTPKempeChain<eoChromosome>::ExamRoomTuple> const &destTjExams = _kempeChain.getFinalTjPeriodExams();
     // The timetable container
     TimetableContainer &timetableCont = getTimetableContainer();
 
@@ -979,17 +991,10 @@ void eoChromosome::computeSolutionCostIncremental(const ETTPKempeChain<eoChromos
 
     // Get exams that belong to the Kempe chain in Ti, that is,
     // those which will be moved to time slot Tj
-    std::vector<std::tuple<int, int, int>> examsToBeMovedFromTi;
-    int tSource = _kempeChain.getTi();
-    int tDest = _kempeChain.getTj();
-    int roomSource = _kempeChain.getRi();
-    int roomDest = _kempeChain.getRj();
-
-    getExamsToBeMoved(srcTiExams, destTjExams, tSource, tDest, roomSource, examsToBeMovedFromTi); // Last is an out parameter
+    auto const &examsToBeMovedFromTi = _kempeChain.getMovedExamsFromTi();
     // Get exams that belong to the Kempe chain in Tj, that is,
     // those which will be moved to time slot Ti
-    std::vector<std::tuple<int, int, int>> examsToBeMovedFromTj;
-    getExamsToBeMoved(srcTjExams, destTiExams, tDest, tSource, roomDest, examsToBeMovedFromTj); // Last is an out parameter
+    auto const &examsToBeMovedFromTj = _kempeChain.getMovedExamsFromTj();
 
     // Institutional model weightings
     InstitutionalModelWeightings const &model_weightings = timetableProblemData->getInstitutionalModelWeightings();
@@ -1014,7 +1019,7 @@ void eoChromosome::computeSolutionCostIncremental(const ETTPKempeChain<eoChromos
     //
     // Move all *source* kempe chain exams and determine corresponding removal and insertion exam proximity costs
     //
-    // O(number exams)
+    // O(Kempe chain size)
     for (auto const &examSrcDestRoomTuple : examsToBeMovedFromTi) {
         // Get exam id
         int exam_id = std::get<0>(examSrcDestRoomTuple);
@@ -1098,7 +1103,7 @@ void eoChromosome::computeSolutionCostIncremental(const ETTPKempeChain<eoChromos
     //
     // Move all *dest* kempe chain exams and determine corresponding removal and insertion exam proximity costs
     //
-    // O(number exams)
+    // O(Kempe chain size)
     for (auto const &examSrcDestRoomTuple : examsToBeMovedFromTj) {
         // Get exam id
         int exam_id = std::get<0>(examSrcDestRoomTuple);
@@ -1240,59 +1245,79 @@ void eoChromosome::computeSolutionCostIncremental(const ETTPKempeChain<eoChromos
 
 
 
+/**
+ * @brief eoChromosome::scheduleExamIncremental Schedule exam _ei in period _tj and room _rk and
+ * update the solution cost incrementally. Pre-condition: _ei is not scheduled
+ * @param _ei
+ * @param _tj
+ * @param _rk
+ */
+void eoChromosome::scheduleExamIncremental(int _ei, int _tj, int _rk) {
+    // The mixed durations cost of the room-period before and after the insertion
+    solutionCost -= getConflictMixedDurationsFromPeriodAndRoom(_tj, _rk);
+    getTimetableContainer().scheduleExam(_ei, _tj, _rk);
+    solutionCost += getConflictMixedDurationsFromPeriodAndRoom(_tj, _rk);
+    // Add the cost of the soft constraints involving the exam
+    solutionCost += getExamCost(_ei, _tj, _rk);
+}
+
 
 
 /**
- * @brief eoChromosome::getExamsToBeMoved
- * @param _srcPeriodExams
- * @param _destPeriodExams
- * @param _tSource
- * @param _tDest
- * @param _sourceRoom
- * @param _examsToBeMovedFromSourcePeriod
+ * @brief eoChromosome::unscheduleExamIncremental Unschedule exam _ei and update the solution
+ * cost incrementally. Pre-condition: _ei is scheduled
+ * @param _ei
  */
-void eoChromosome::getExamsToBeMoved(std::vector<typename ETTPKempeChain<eoChromosome>::ExamRoomTuple> const &_srcPeriodExams,
-                                     std::vector<typename ETTPKempeChain<eoChromosome>::ExamRoomTuple> const &_destPeriodExams,
-                                     int _tSource, int _tDest, int _sourceRoom,
-                                     std::vector<std::tuple<int, int, int>> &_examsToBeMovedFromSourcePeriod) {
-
-    // Vector of exams to be moved. The first value is true if the exam is to be moved (initially all false).
-    // The second value is the source room.
-    std::vector<std::pair<bool, int>> examsToBeMoved(getNumExams());
-    // Mark exams in s
-    // O(number exams)
-    for (auto const &examRoomTuple : _srcPeriodExams) {
-        // Get exam id
-        int exam_id = std::get<0>(examRoomTuple);
-        // Get room id
-        int room_id = std::get<1>(examRoomTuple);
-        examsToBeMoved[exam_id].first = true;
-        examsToBeMoved[exam_id].second = room_id;
-    }
+void eoChromosome::unscheduleExamIncremental(int _ei) {
+    // Get exam period and room
+    ScheduledExam const &scheduledExam = getScheduledExamsVector()[_ei];
+    int tj = scheduledExam.getPeriod();
+    int rk = scheduledExam.getRoom();
+    // Subtract the cost of the soft constraints involving the exam
+    solutionCost -= getExamCost(_ei, tj, rk);
+    // The mixed durations cost of the room-period before and after the removal
+    solutionCost -= getConflictMixedDurationsFromPeriodAndRoom(tj, rk);
+    getTimetableContainer().unscheduleExam(_ei, tj);
+    solutionCost += getConflictMixedDurationsFromPeriodAndRoom(tj, rk);
+}
+
 
-    // O(number exams)
-    for (auto const &examRoomTuple : _destPeriodExams) {
-        // Get exam id
-        int exam_id = std::get<0>(examRoomTuple);
 
-        // If exam_id belongs to the Kempe chain in source period and in the dest period,
-        // then it is to be moved to dest time slot
-        if (examsToBeMoved[exam_id].first == true) {
-            // Get source room
-            int sourceRoom = examsToBeMoved[exam_id].second;
-            if (_tSource != _tDest || _tSource == _tDest  && _sourceRoom == sourceRoom) {
-                // Get dest room
-                int destRoom = std::get<1>(examRoomTuple);
-                // Associate the dest room to the tuple to return
-                _examsToBeMovedFromSourcePeriod.push_back(std::make_tuple(exam_id, sourceRoom, destRoom));
+/**
+ * @brief eoChromosome::getExamCost Cost of the soft constraints involving exam _ei scheduled in
+ * period _tj and room _rk, except No Mixed Durations which depends on the whole room-period
+ * @param _ei
+ * @param _tj
+ * @param _rk
+ * @return
+ */
+long eoChromosome::getExamCost(int _ei, int _tj, int _rk) {
+    // Institutional model weightings
+    InstitutionalModelWeightings const &model_weightings = timetableProblemData->getInstitutionalModelWeightings();
+    // 1. and 2. Two exams in a row/day
+    long cost = getConflictInADayAndRowFromDay(_ei, _tj);
+    // 3. Period spread
+    cost += getConflictPeriodSpreadBeforeAndAfterPeriod(_ei, _tj);
+    // 5. Front load
+    if (_tj >= getNumPeriods() - model_weightings.front_load[1]) {
+        // Obtain course student counts sorted in decreasing order by student counts
+        auto const &sortedExamsCountsPairs = getSortedCourseClassSize();
+        for (int i = 0; i < model_weightings.front_load[0]; ++i) {
+            if (sortedExamsCountsPairs[i].first == _ei) {
+                cost += model_weightings.front_load[2];
+                break;
             }
         }
     }
+    // 6. Room penalty and 7. Period penalty
+    cost += getRoomVector()[_rk]->getPenalty() + timetableProblemData->getPeriodVector()[_tj]->getPenalty();
+    return cost;
 }
 
 
 
 
+
 /**
  * @brief eoChromosome::getConflictInADayAndRowFromDay
  * @param _examination
@@ -2236,9 +2261,10 @@ bool eoChromosome::verifyRoomOccupancyConstraint(int _ei, int _tj, int _rk) cons
 * @param _ei
 * @param _tj
 * @param _rk
+* @param _rng Random number generator used to select the room
 * @return
 */
-bool eoChromosome::getFeasibleRoom(int _ei, int _tj, int &_rk) {
+bool eoChromosome::getFeasibleRoom(int _ei, int _tj, int &_rk, eoRng &_rng) {
     //
     // A set containing the feasible rooms is formed, and a random room is selected.
     //
@@ -2279,7 +2305,7 @@ bool eoChromosome::getFeasibleRoom(int _ei, int _tj, int &_rk) {
     //
     // Otherwise, a feasible room exists
     // Generate random room index
-    int idx = rng.uniform(feasibleRooms.size());
+    int idx = _rng.uniform(feasibleRooms.size());
     _rk = feasibleRooms[idx];
 
 #ifdef EOCHROMOSOME_DEBUG_ROOM
@@ -3,6 +3,7 @@
 
 
 #include <EO.h>
+#include <utils/eoRNG.h>
 
 #include "containers/Matrix.h"
 #include "containers/TimetableContainer.h"
@@ -33,6 +34,20 @@
 // the timetable matrix has dimensions of (# exams x # periods) where the
 // values 0/1 represent, respectively, absence/presence of exam in the period.
 
+/**
+ * @brief The SoftConstraintCosts struct Cost of each ITC2007 soft constraint of a solution
+ */
+struct SoftConstraintCosts {
+    long twoInARow;
+    long twoInADay;
+    long periodSpread;
+    long mixedDurations;
+    long frontLoad;
+    long roomPenalty;
+    long periodPenalty;
+};
+
+
 /**
  * @brief The eoChromosome class
  */
@@ -236,6 +251,12 @@ public:
      * @return
      */
     inline TimetableContainer const &getTimetableContainer() const;
+    /**
+     * @brief getHash Return the Zobrist hash of the timetable. Solutions with the same
+     * (exam, period, room) assignment have the same hash
+     * @return
+     */
+    inline unsigned long long getHash() const;
 
 
     ////////// Chromosome cost and feasibility manipulation methods //////////////////////////////
@@ -244,6 +265,12 @@ public:
      * @brief computeCost
      */
     void computeCost();
+    /**
+     * @brief computeSoftConstraintCosts Compute the cost of each soft constraint from scratch.
+     * Their sum is the solution cost
+     * @return
+     */
+    SoftConstraintCosts computeSoftConstraintCosts();
     /**
      * @brief getSolutionCost
      * @return
@@ -314,19 +341,30 @@ public:
     void computeSolutionCostIncremental(const ETTPKempeChain<eoChromosome> &_kempeChain);
 
     /**
-     * @brief getExamsToBeMoved
-     * @param _srcPeriodExams
-     * @param _destPeriodExams
-     * @param _tSource
-     * @param _tDest
-     * @param _sourceRoom
-     * @param _examsToBeMovedFromSourcePeriod
+     * @brief scheduleExamIncremental Schedule exam _ei in period _tj and room _rk and
+     * update the solution cost incrementally. Pre-condition: _ei is not scheduled
+     * @param _ei
+     * @param _tj
+     * @param _rk
+     */
+    void scheduleExamIncremental(int _ei, int _tj, int _rk);
+
+    /**
+     * @brief unscheduleExamIncremental Unschedule exam _ei and update the solution
+     * cost incrementally. Pre-condition: _ei is scheduled
+     * @param _ei
      */
-    void getExamsToBeMoved(std::vector<typename ETTPKempeChain<eoChromosome>::ExamRoomTuple> const &_srcPeriodExams,
-                           std::vector<typename ETTPKempeChain<eoChromosome>::ExamRoomTuple> const &_destPeriodExams,
-                           int _tSource, int _tDest, int _sourceRoom,
-                           std::vector<std::tuple<int, int, int> > &_examsToBeMovedFromSourcePeriod);
+    void unscheduleExamIncremental(int _ei);
 
+    /**
+     * @brief getExamCost Cost of the soft constraints involving exam _ei scheduled in period _tj
+     * and room _rk, except No Mixed Durations which depends on the whole room-period
+     * @param _ei
+     * @param _tj
+     * @param _rk
+     * @return
+     */
+    long getExamCost(int _ei, int _tj, int _rk);
 
     /**
      * @brief validate Validate a chromosome solution
@@ -426,9 +464,10 @@ public:
      * @param _ei
      * @param _tj
      * @param _rk
+     * @param _rng Random number generator used to select the room
      * @return
      */
-    bool getFeasibleRoom(int _ei, int _tj, int &_rk);
+    bool getFeasibleRoom(int _ei, int _tj, int &_rk, eoRng &_rng = rng);
 
     /**
      * @brief verifyRoomCapacityConstraint Verify Room capacity constraint
@@ -653,6 +692,13 @@ TimetableContainer &eoChromosome::getTimetableContainer() {
 TimetableContainer const &eoChromosome::getTimetableContainer() const {
     return *timetableContainer.get();
 }
+/**
+ * @brief getHash
+ * @return
+ */
+unsigned long long eoChromosome::getHash() const {
+    return timetableContainer->getHash();
+}
 
 
 
@@ -74,6 +74,11 @@ public:
      * @return
      */
     virtual int getRoom(int _ei, int _tj) const = 0;
+    /**
+     * @brief getHash Return the Zobrist hash of the (exam, period, room) assignment
+     * @return
+     */
+    virtual unsigned long long getHash() const = 0;
 
     /**
      * @brief insertExam Insert exam _ei into period _tj and room _rk
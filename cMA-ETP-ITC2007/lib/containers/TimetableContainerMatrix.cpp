@@ -16,21 +16,23 @@ using namespace  std;
  * @param _ti
  */
 void TimetableContainerMatrix::removeAllPeriodExams(int _ti) {
-/// TODO - OPTIMIZED + UNSCHEDULE EXAM FROM ROOM
-///
-    // OPTIMIZED
-//    for (int ei = 0; ei < timetableContainer.getNumLines(); ++ei) {
-//        timetableContainer.setVal(ei, _ti, REMOVE_EXAM);
-//    }
-//    periodsSizes[_ti] = 0;
-//    // Remove all exams from periodsExams in period _ti
-//    periodsExams[_ti].clear();
-
-    for (int ei = 0; ei < timetableContainer.getNumLines(); ++ei) {
-        if (isExamScheduled(ei, _ti))
-            unscheduleExam(ei, _ti);
+    // Unschedule only the exams of period _ti, instead of scanning all exams
+    for (auto const &examRoomTuple : periodsExams[_ti]) {
+        // Get exam and room
+        int ei = std::get<0>(examRoomTuple);
+        int rk = std::get<1>(examRoomTuple);
+        // Remove exam _ei from period _ti
+        timetableContainer.setVal(ei, _ti, REMOVE_EXAM);
+        // Remove assignment key from the hash
+        hash ^= getAssignmentKey(ei, _ti, rk);
+        // Unset period and room in scheduleExamsVector
+        scheduledExamsVector[ei].unschedule();
+        // Update room occupancy
+        removeExamFromRoom(ei, _ti, rk);
     }
-
+    periodsSizes[_ti] = 0;
+    // Remove all exams from periodsExams in period _ti. The vector keeps its capacity
+    periodsExams[_ti].clear();
 }
 
 
@@ -88,6 +88,13 @@ public:
      * @return
      */
     inline virtual int getRoom(int _ei, int _tj) const override;
+    /**
+     * @brief getHash Return the Zobrist hash of the (exam, period, room) assignment.
+     *        The hash is updated incrementally on every exam insertion and removal
+     *        Complexity: O(1)
+     * @return
+     */
+    inline virtual unsigned long long getHash() const override;
 
     /**
      * @brief getScheduledExamsVector
@@ -121,7 +128,7 @@ public:
 
     /**
      * @brief removeAllPeriodExams Remove all period exams
-     *        Complexity: O(NumExams)
+     *        Complexity: O(period size)
      * @param _ti
      */
     virtual void removeAllPeriodExams(int _ti) override;
@@ -191,6 +198,15 @@ protected:
      * @brief init
      */
     inline void init();
+    /**
+     * @brief getAssignmentKey Return the Zobrist key of exam _ei scheduled in period _tj and room _rk.
+     *        The key is computed on the fly by mixing the assignment index with splitmix64
+     * @param _ei
+     * @param _tj
+     * @param _rk
+     * @return
+     */
+    inline unsigned long long getAssignmentKey(int _ei, int _tj, int _rk) const;
 
     /**
      * @brief timetableContainer The timetable container based on a matrix
@@ -222,6 +238,10 @@ protected:
      * @brief timetableProblemData The problem data
      */
     TimetableProblemData const *timetableProblemData;
+    /**
+     * @brief hash Zobrist hash of the (exam, period, room) assignment
+     */
+    unsigned long long hash;
 };
 
 
@@ -237,7 +257,8 @@ TimetableContainerMatrix::TimetableContainerMatrix()
       periodsSizes(0),
       numRooms(0),
       scheduledExamsVector(0),
-      scheduledRoomsVector(0)
+      scheduledRoomsVector(0),
+      hash(0)
 {
     // Set timetableProblemData static field
     timetableProblemData = nullptr;
@@ -268,7 +289,9 @@ TimetableContainerMatrix::TimetableContainerMatrix(int _numExams, int _numPeriod
       // Scheduled rooms vector
       scheduledRoomsVector(_numRooms),
       // Set timetableProblemData field
-      timetableProblemData(_timetableProblemData)
+      timetableProblemData(_timetableProblemData),
+      // Empty timetable hash
+      hash(0)
 {
 
 #ifdef TIMETABLECONTAINERMATRIX_CTOR
@@ -300,6 +323,8 @@ void TimetableContainerMatrix::init() {
         scheduledRoomsVector[rk].setId(rk);
         scheduledRoomsVector[rk].setNumPeriods(timetableContainer.getNumCols());
     }
+    // Empty timetable hash
+    hash = 0;
 
 //    for (int rk = 0; rk < numRooms; ++rk) {
 //        std::cout << "Room " << scheduledRoomsVector[rk].getId() << ":" << std::endl;
@@ -371,6 +396,31 @@ int TimetableContainerMatrix::getRoom(int _ei, int _tj) const {
     return timetableContainer.getVal(_ei, _tj);
 }
 
+/**
+ * @brief getHash Return the Zobrist hash of the (exam, period, room) assignment
+ * @return
+ */
+unsigned long long TimetableContainerMatrix::getHash() const {
+    return hash;
+}
+
+/**
+ * @brief getAssignmentKey Return the Zobrist key of exam _ei scheduled in period _tj and room _rk
+ * @param _ei
+ * @param _tj
+ * @param _rk
+ * @return
+ */
+unsigned long long TimetableContainerMatrix::getAssignmentKey(int _ei, int _tj, int _rk) const {
+    // Assignment index
+    unsigned long long z = ((unsigned long long)_ei*timetableContainer.getNumCols() + _tj)*(numRooms+1) + _rk + 1;
+    // splitmix64 finaliser
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
 /**
  * @brief getScheduledExamsVector
  * @return The scheduled exams vector
@@ -396,6 +446,8 @@ std::vector<ScheduledRoom> const &TimetableContainerMatrix::getScheduledRoomsVec
 void TimetableContainerMatrix::insertExam(int _ei, int _tj, int _rk) {
     // Insert exam _ei into period _tj
     timetableContainer.setVal(_ei, _tj, _rk);
+    // Add assignment key to the hash
+    hash ^= getAssignmentKey(_ei, _tj, _rk);
     // Increment period size
     ++periodsSizes[_tj];
     // Insert (exam _ei, room _rk) tuple into period _tj in periodsExams
@@ -429,6 +481,8 @@ void TimetableContainerMatrix::setTimetableProblemData(const TimetableProblemDat
  * @param _tj
  */
 void TimetableContainerMatrix::removeExam(int _ei, int _tj) {
+    // Remove assignment key from the hash
+    hash ^= getAssignmentKey(_ei, _tj, getRoom(_ei, _tj));
     // Remove exam _ei from period _tj
     timetableContainer.setVal(_ei, _tj, REMOVE_EXAM);
     // Decrement period size
@@ -58,6 +58,8 @@ public:
 
     const IntMatrix &getConflictMatrix() const;
     void setConflictMatrix(const boost::shared_ptr<IntMatrix > &value);
+    // Set conflict matrix with a precomputed density
+    void setConflictMatrix(const boost::shared_ptr<IntMatrix > &value, double _conflictMatrixDensity);
 
     const AdjacencyList &getExamGraph() const;
     void setExamGraph(const boost::shared_ptr<AdjacencyList> &value);
@@ -221,6 +223,12 @@ inline void TimetableProblemData::setConflictMatrix(const boost::shared_ptr<IntM
     // Compute conflict matrix density
     computeConflictMatrixDensity();
 }
+inline void TimetableProblemData::setConflictMatrix(const boost::shared_ptr<IntMatrix > &value,
+                                                    double _conflictMatrixDensity)
+{
+    conflictMatrix = value;
+    conflictMatrixDensity = _conflictMatrixDensity;
+}
 
 inline AdjacencyList const& TimetableProblemData::getExamGraph() const
 {
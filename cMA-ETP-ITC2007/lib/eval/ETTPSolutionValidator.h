@@ -0,0 +1,262 @@
+#ifndef ETTPSOLUTIONVALIDATOR_H
+#define ETTPSOLUTIONVALIDATOR_H
+
+#include "chromosome/eoChromosome.h"
+#include "data/ITC2007Constraints.hpp"
+#include <boost/shared_ptr.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+
+
+/**
+ * @brief The HardConstraintViolation struct A hard constraint violated by a solution
+ */
+struct HardConstraintViolation {
+    /**
+     * @brief type CONFLICT, PERIOD_UTILISATION, ROOM_OCCUPANCY, AFTER, EXAM_COINCIDENCE,
+     * EXCLUSION or ROOM_EXCLUSIVE
+     */
+    std::string type;
+    /**
+     * @brief description Exams, period and room involved
+     */
+    std::string description;
+};
+
+
+/**
+ * @brief The SolutionReport struct Validation result of a solution file
+ */
+struct SolutionReport {
+    SolutionReport() : cost(0), costs() { }
+    std::string filename;
+    /**
+     * @brief error Reason why the file couldn't be read. Empty if it was read
+     */
+    std::string error;
+    /**
+     * @brief cost Soft constraint cost
+     */
+    long cost;
+    /**
+     * @brief costs Cost of each soft constraint
+     */
+    SoftConstraintCosts costs;
+    /**
+     * @brief violations Violated hard constraints
+     */
+    std::vector<HardConstraintViolation> violations;
+
+    bool isFeasible() const { return error.empty() && violations.empty(); }
+};
+
+
+
+/**
+ * @brief The ETTPSolutionValidator class Reads ITC2007 solution files (one "period, room" line
+ * per exam, as written by operator<<), scores them and checks the hard constraints.
+ *
+ * A validator is built once per problem instance, and may validate many files in parallel.
+ * Infeasible timetables are still scored, and all their violations are reported
+ */
+template <typename EOT>
+class ETTPSolutionValidator {
+
+public:
+    ETTPSolutionValidator(TimetableProblemData const *_timetableProblemData)
+        : timetableProblemData(_timetableProblemData) { }
+
+    /**
+     * @brief readAssignment Read ITC2007 solution file _filename. Throws std::runtime_error,
+     * naming the file and line, if it is malformed or has a wrong # exams
+     * @param _filename
+     * @return The (period, room) of each exam
+     */
+    std::vector<std::pair<int, int> > readAssignment(std::string const &_filename) const;
+
+    /**
+     * @brief buildSolution Schedule the exams of _assignment in a new solution, through the
+     * timetable container, computing the cost incrementally
+     * @param _assignment (period, room) of each exam
+     * @param _violations Violated hard constraints
+     * @return The solution, with its cost and fitness set
+     */
+    boost::shared_ptr<EOT> buildSolution(std::vector<std::pair<int, int> > const &_assignment,
+                                         std::vector<HardConstraintViolation> &_violations) const;
+
+    /**
+     * @brief validate Read, score and check solution file _filename
+     * @param _filename
+     * @return The report. Errors are reported in it instead of thrown
+     */
+    SolutionReport validate(std::string const &_filename) const;
+
+    /**
+     * @brief validate Validate solution files _filenames using _numThreads threads
+     * @param _filenames
+     * @param _numThreads
+     * @return The reports, in the order of _filenames
+     */
+    std::vector<SolutionReport> validate(std::vector<std::string> const &_filenames, int _numThreads) const;
+
+private:
+    // Get the type name of hard constraint _constraint
+    static std::string getConstraintType(Constraint const &_constraint);
+
+    // Instance fields
+    TimetableProblemData const *timetableProblemData;
+};
+
+
+
+template <typename EOT>
+std::vector<std::pair<int, int> > ETTPSolutionValidator<EOT>::readAssignment(std::string const &_filename) const {
+    std::ifstream in(_filename.c_str());
+    if (!in)
+        throw std::runtime_error("couldn't open solution file " + _filename);
+    std::vector<std::pair<int, int> > assignment;
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        // Blank lines (as produced by "\r\n" line ends read on other systems) are skipped
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+        char const *cur = line.c_str();
+        char *end;
+        errno = 0;
+        long tj = std::strtol(cur, &end, 10);
+        bool valid = end != cur && errno == 0;
+        cur = end + std::strspn(end, " \t");
+        valid = valid && *cur == ',';
+        if (valid) {
+            ++cur;
+            long rk = std::strtol(cur, &end, 10);
+            valid = end != cur && errno == 0 && end[std::strspn(end, " \t\r")] == '\0';
+            if (valid && (tj < 0 || tj >= timetableProblemData->getNumPeriods() ||
+                          rk < 0 || rk >= timetableProblemData->getNumRooms()))
+                throw std::runtime_error(_filename + ":" + std::to_string(lineNumber) + ": period or room out of range");
+            assignment.push_back(std::make_pair((int)tj, (int)rk));
+        }
+        if (!valid)
+            throw std::runtime_error(_filename + ":" + std::to_string(lineNumber) + ": expected 'period, room'");
+    }
+    if ((int)assignment.size() != timetableProblemData->getNumExams())
+        throw std::runtime_error(_filename + ": " + std::to_string(assignment.size()) + " exams, expected "
+                                 + std::to_string(timetableProblemData->getNumExams()));
+    return assignment;
+}
+
+
+template <typename EOT>
+boost::shared_ptr<EOT> ETTPSolutionValidator<EOT>::buildSolution(std::vector<std::pair<int, int> > const &_assignment,
+                                                               std::vector<HardConstraintViolation> &_violations) const {
+    boost::shared_ptr<EOT> sol(new EOT(timetableProblemData));
+    EOT &chrom = *sol.get();
+    IntMatrix const &conflictMatrix = chrom.getConflictMatrix();
+    TimetableContainer const &timetableCont = chrom.getTimetableContainer();
+    auto const &scheduledRoomsVector = chrom.getScheduledRoomsVector();
+    auto const &roomVector = chrom.getRoomVector();
+    int numExams = _assignment.size();
+    chrom.setSolutionCost(0);
+    for (int ei = 0; ei < numExams; ++ei) {
+        int tj = _assignment[ei].first;
+        int rk = _assignment[ei].second;
+        // Conflicts with the exams scheduled so far, so each pair is reported once
+        for (auto const &examRoomTuple : timetableCont.getPeriodExams(tj)) {
+            int ej = std::get<0>(examRoomTuple);
+            if (conflictMatrix.getVal(ei, ej) > 0)
+                _violations.push_back({ "CONFLICT", "exams " + std::to_string(ej) + " and " + std::to_string(ei)
+                                        + " in period " + std::to_string(tj) });
+        }
+        if (!chrom.verifyPeriodUtilisationConstraint(ei, tj))
+            _violations.push_back({ "PERIOD_UTILISATION", "exam " + std::to_string(ei) + " in period " + std::to_string(tj) });
+        chrom.scheduleExamIncremental(ei, tj, rk);
+    }
+    // Room capacity of each period and room
+    for (int tj = 0; tj < chrom.getNumPeriods(); ++tj) {
+        for (int rk = 0; rk < chrom.getNumRooms(); ++rk) {
+            if (scheduledRoomsVector[rk].getNumOccupiedSeats(tj) > roomVector[rk]->getCapacity())
+                _violations.push_back({ "ROOM_OCCUPANCY", "room " + std::to_string(rk) + " in period " + std::to_string(tj) });
+        }
+    }
+    // Period-related and room-related hard constraints
+    for (auto const &ptrConstraint : timetableProblemData->getHardConstraints()) {
+        Constraint const &constraint = *ptrConstraint.get();
+        if (constraint(chrom) == 0)
+            continue;
+        std::string exams;
+        if (BinaryConstraint const *binConstraint = dynamic_cast<BinaryConstraint const *>(&constraint))
+            exams = "exams " + std::to_string(binConstraint->getE1()) + " and " + std::to_string(binConstraint->getE2());
+        else if (UnaryConstraint const *unaConstraint = dynamic_cast<UnaryConstraint const *>(&constraint))
+            exams = "exam " + std::to_string(unaConstraint->getE());
+        _violations.push_back({ getConstraintType(constraint), exams });
+    }
+    chrom.setFeasible(_violations.empty());
+    chrom.fitness(chrom.getSolutionCost());
+    return sol;
+}
+
+
+template <typename EOT>
+SolutionReport ETTPSolutionValidator<EOT>::validate(std::string const &_filename) const {
+    SolutionReport report;
+    report.filename = _filename;
+    try {
+        boost::shared_ptr<EOT> sol = buildSolution(readAssignment(_filename), report.violations);
+        // Full evaluation, giving the cost of each soft constraint
+        report.costs = (*sol.get()).computeSoftConstraintCosts();
+        report.cost = report.costs.twoInARow + report.costs.twoInADay + report.costs.periodSpread + report.costs.mixedDurations
+                + report.costs.frontLoad + report.costs.roomPenalty + report.costs.periodPenalty;
+    }
+    catch (std::runtime_error const &e) {
+        report.error = e.what();
+    }
+    return report;
+}
+
+
+template <typename EOT>
+std::vector<SolutionReport> ETTPSolutionValidator<EOT>::validate(std::vector<std::string> const &_filenames, int _numThreads) const {
+    std::vector<SolutionReport> reports(_filenames.size());
+    // Each thread takes the next file
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (std::size_t i; (i = next.fetch_add(1)) < _filenames.size(); )
+            reports[i] = validate(_filenames[i]);
+    };
+    int numThreads = std::max(1, std::min(_numThreads, (int)_filenames.size()));
+    std::vector<std::thread> threads;
+    for (int k = 1; k < numThreads; ++k)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (auto &t : threads)
+        t.join();
+    return reports;
+}
+
+
+template <typename EOT>
+std::string ETTPSolutionValidator<EOT>::getConstraintType(Constraint const &_constraint) {
+    if (dynamic_cast<AfterConstraint const *>(&_constraint))
+        return "AFTER";
+    if (dynamic_cast<ExamCoincidenceConstraint const *>(&_constraint))
+        return "EXAM_COINCIDENCE";
+    if (dynamic_cast<ExamExclusionConstraint const *>(&_constraint))
+        return "EXCLUSION";
+    if (dynamic_cast<RoomExclusiveConstraint const *>(&_constraint))
+        return "ROOM_EXCLUSIVE";
+    return "HARD_CONSTRAINT";
+}
+
+
+
+#endif // ETTPSOLUTIONVALIDATOR_H
@@ -135,6 +135,15 @@ public:
     static std::vector<VariableValueTuple> hardConflictsWithoutAfterConstraint(EOT &_chrom, int _A, const i2tuple &_a);
 
 
+    /**
+     * @brief buildPeriodRelatedExclusionHardConflicts
+     * @param _ei
+     * @param _tj
+     * @param _variables
+     */
+    static void buildPeriodRelatedExclusionHardConflicts(EOT &_chrom, int _ei, int _tj, std::vector<VariableValueTuple> &_variables);
+
+
 
 
 private:
@@ -224,15 +233,6 @@ private:
     static void buildPeriodRelatedHardConflicts(EOT &_chrom, int _ei, int _tj, std::vector<VariableValueTuple> &_variables);
 
 
-    /**
-     * @brief buildPeriodRelatedExclusionHardConflicts
-     * @param _ei
-     * @param _tj
-     * @param _variables
-     */
-    static void buildPeriodRelatedExclusionHardConflicts(EOT &_chrom, int _ei, int _tj, std::vector<VariableValueTuple> &_variables);
-
-
     /**
      * @brief buildRoomRelatedConflicts
      * @param _ei
@@ -1385,10 +1385,10 @@ void GCHeuristics<EOT>::init(const TimetableProblemData *_timetableProblemData,
 //    // Register timetable problem data
 //    timetableProblemData = &_timetableProblemData;
     //
-    // We use the ParadisEO random generator eoRng which is reseed on initialization.
+    // We use the ParadisEO random generator eoRng, which is seeded once per run (see runITC2007Datasets).
+    // Reseeding it here would build identical solutions within the same clock second and break
+    // the replay of resumed runs
     //
-    // Initialise EO random generator
-    rng.reseed(static_cast<uint32_t>(time(0)));
 #ifdef GRAPH_COLOURING_HEURISTIC_DEBUG
     cout << "numExams = " << numExams << endl;
     cout << "numPeriods = " << numPeriods << endl;
@@ -1418,12 +1418,9 @@ void GCHeuristics<EOT>::initialiseVertexPriorityQueue(VertexPriorityQueue &_pq,
         exams[ei] = ei;
     // Shuffle exams
 
-/// TODO:
-///
-/// USING RANDOM SEED GENERATE THE SAME SOLUTION FOR ALL INDIVIDUALS OF THE POPULATION
-///
 //    std::srand(std::time(0)); // Seed random generator used in random_shuffle
-    std::random_shuffle(exams.begin(), exams.end());
+    // The shuffle uses the EO random generator, whose state is saved in the evolution checkpoints
+    std::random_shuffle(exams.begin(), exams.end(), [](int _n) { return (int)rng.random(_n); });
 
 #ifdef GRAPH_COLOURING_HEURISTIC_DEBUG
     cout << "Random exams to insert into the priority queue: " << endl;
@@ -0,0 +1,126 @@
+#ifndef ETTPWARMSTARTINIT_H
+#define ETTPWARMSTARTINIT_H
+
+#include <eoInit.h>
+#include <eoOp.h>
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "eval/ETTPSolutionValidator.h"
+
+
+// For debugging purposes
+//#define ETTPWARMSTARTINIT_DEBUG
+
+
+
+/**
+ * @brief The ETTPWarmStartInit class Initialises the population from existing ITC2007 solutions.
+ *
+ * The solution files (one "period, room" line per exam, as written by operator<<) are read
+ * and validated when the initialiser is built. Successive calls initialise successive cells:
+ * the seeds are spread evenly over the population, a fraction of the other cells are copies
+ * of the seeds perturbed by random moves, and the remaining cells are built by the fallback
+ * initialiser. The perturbations and the fallback initialiser draw from the run's rng stream,
+ * so the perturbed copies and the fresh cells are all different timetables
+ */
+template <typename EOT>
+class ETTPWarmStartInit : public eoInit<EOT> {
+
+public:
+    /**
+     * @brief ETTPWarmStartInit Read the seed solutions. Throws std::runtime_error if a file is invalid
+     * @param _timetableProblemData
+     * @param _filenames ITC2007 solution files
+     * @param _init Initialiser of the cells which are neither seeds nor perturbed copies
+     * @param _perturb Move applied to the perturbed copies
+     * @param _popSize # cells. If there are more seeds, the best ones are kept
+     * @param _perturbedFraction Fraction of the non-seed cells which are perturbed copies of the seeds
+     * @param _numPerturbations # moves applied to each perturbed copy
+     */
+    ETTPWarmStartInit(TimetableProblemData const *_timetableProblemData, std::vector<std::string> const &_filenames,
+                      eoInit<EOT> &_init, eoMonOp<EOT> &_perturb, int _popSize,
+                      double _perturbedFraction = 0.5, int _numPerturbations = 20)
+        : init(_init), perturb(_perturb), popSize(_popSize), perturbedFraction(_perturbedFraction),
+          numPerturbations(_numPerturbations), cell(0), numOtherCells(0) {
+        for (auto const &filename : _filenames)
+            seeds.push_back(readSolution(filename, _timetableProblemData));
+        // Keep the best seeds
+        std::stable_sort(seeds.begin(), seeds.end(), [](boost::shared_ptr<EOT> const &_a, boost::shared_ptr<EOT> const &_b) {
+            return (*_a.get()).fitness() < (*_b.get()).fitness(); });
+        if ((int)seeds.size() > popSize)
+            seeds.resize(popSize);
+    }
+
+
+    virtual void operator()(EOT &_chrom) {
+        int numSeeds = seeds.size();
+        // Seed j is placed in cell floor(j*popSize/numSeeds)
+        int seed = (int)(((long)cell*numSeeds + popSize - 1) / popSize);
+        bool isSeedCell = numSeeds > 0 && seed < numSeeds && (long)seed*popSize/numSeeds == cell;
+        ++cell;
+        if (isSeedCell) {
+            _chrom = *seeds[seed].get();
+#ifdef ETTPWARMSTARTINIT_DEBUG
+            std::cout << "ETTPWarmStartInit: seed " << seed << ", cost = " << _chrom.fitness() << std::endl;
+#endif
+            return;
+        }
+        // The perturbed copies are spread evenly over the other cells
+        int k = numOtherCells++;
+        if (numSeeds > 0 && (int)((k+1)*perturbedFraction) > (int)(k*perturbedFraction)) {
+            _chrom = *seeds[k % numSeeds].get();
+            for (int i = 0; i < numPerturbations; ++i)
+                perturb(_chrom);
+#ifdef ETTPWARMSTARTINIT_DEBUG
+            std::cout << "ETTPWarmStartInit: perturbed copy of seed " << k % numSeeds << ", cost = " << _chrom.fitness()
+                      << ", hash = " << _chrom.getTimetableContainer().getHash() << std::endl;
+#endif
+        }
+        else {
+            init(_chrom);
+#ifdef ETTPWARMSTARTINIT_DEBUG
+            std::cout << "ETTPWarmStartInit: fresh cell, hash = " << _chrom.getTimetableContainer().getHash() << std::endl;
+#endif
+        }
+    }
+
+    // Get # seed solutions
+    int getNumSeeds() const { return seeds.size(); }
+
+    /**
+     * @brief readSolution Read ITC2007 solution file _filename. The exams are scheduled through
+     * the timetable container and the cost is computed incrementally as they are inserted.
+     * Throws std::runtime_error if the file is malformed or the timetable violates a hard constraint
+     * @param _filename
+     * @param _timetableProblemData
+     * @return The solution, evaluated
+     */
+    static boost::shared_ptr<EOT> readSolution(std::string const &_filename, TimetableProblemData const *_timetableProblemData) {
+        ETTPSolutionValidator<EOT> validator(_timetableProblemData);
+        std::vector<HardConstraintViolation> violations;
+        boost::shared_ptr<EOT> sol = validator.buildSolution(validator.readAssignment(_filename), violations);
+        if (!violations.empty())
+            throw std::runtime_error(_filename + ": " + violations[0].type + " hard constraint violated ("
+                                     + violations[0].description + ")");
+        return sol;
+    }
+
+private:
+
+    // Instance fields
+    eoInit<EOT> &init;
+    eoMonOp<EOT> &perturb;
+    int popSize;
+    double perturbedFraction;
+    int numPerturbations;
+    std::vector<boost::shared_ptr<EOT> > seeds; // Seed solutions, by increasing cost
+    int cell; // Index of the next cell
+    int numOtherCells; // # initialised cells which are not seed cells
+};
+
+
+
+#endif // ETTPWARMSTARTINIT_H
@@ -1,7 +1,8 @@
 #ifndef KEMPECHAIN_H
 #define KEMPECHAIN_H
 
-#include <boost/unordered_set.hpp>
+#include <vector>
+#include <tuple>
 
 /**
  * @brief The ETTPKempeChain class
@@ -16,6 +17,7 @@ class ETTPKempeChain {
 public:
 
     typedef std::tuple<int, int> ExamRoomTuple;
+    typedef std::tuple<int, int, int> ExamMoveTuple; // (exam, source room, dest room)
 
     /**
      * @brief ETTPKempeChain Default constructor
@@ -135,6 +137,39 @@ public:
      */
     void setFinalTjPeriodExams(const std::vector<ExamRoomTuple> &_value);
 
+    /**
+     * @brief getMovedExamsFromTi Get the exams moved from Ti to Tj
+     * @return Vector of (exam, source room, dest room) tuples
+     */
+    const std::vector<ExamMoveTuple> &getMovedExamsFromTi() const;
+
+    /**
+     * @brief getMovedExamsFromTj Get the exams moved from Tj to Ti
+     * @return Vector of (exam, source room, dest room) tuples
+     */
+    const std::vector<ExamMoveTuple> &getMovedExamsFromTj() const;
+
+    /**
+     * @brief addMovedExamFromTi Record exam _ei as moved from room _sourceRoom in Ti to room _destRoom in Tj
+     * @param _ei
+     * @param _sourceRoom
+     * @param _destRoom
+     */
+    void addMovedExamFromTi(int _ei, int _sourceRoom, int _destRoom);
+
+    /**
+     * @brief addMovedExamFromTj Record exam _ei as moved from room _sourceRoom in Tj to room _destRoom in Ti
+     * @param _ei
+     * @param _sourceRoom
+     * @param _destRoom
+     */
+    void addMovedExamFromTj(int _ei, int _sourceRoom, int _destRoom);
+
+    /**
+     * @brief clearMovedExams Clear the moved exams. The vectors keep their capacity
+     */
+    void clearMovedExams();
+
 private:
     /**
      * @brief chrom The solution where the Kempe chain information is associated
@@ -180,6 +215,14 @@ private:
      * (period contents after moving the solution)
      */
     std::vector<ExamRoomTuple> finalTjPeriodExams;
+    /**
+     * @brief movedExamsFromTi Kempe chain exams moved from Ti to Tj
+     */
+    std::vector<ExamMoveTuple> movedExamsFromTi;
+    /**
+     * @brief movedExamsFromTj Kempe chain exams moved from Tj to Ti
+     */
+    std::vector<ExamMoveTuple> movedExamsFromTj;
 };
 
 
@@ -298,6 +341,37 @@ void ETTPKempeChain<EOT>::setFinalTjPeriodExams(const std::vector<ExamRoomTuple>
     finalTjPeriodExams = _value;
 }
 
+template <typename EOT>
+const std::vector<typename ETTPKempeChain<EOT>::ExamMoveTuple> &ETTPKempeChain<EOT>::getMovedExamsFromTi() const
+{
+    return movedExamsFromTi;
+}
+
+template <typename EOT>
+const std::vector<typename ETTPKempeChain<EOT>::ExamMoveTuple> &ETTPKempeChain<EOT>::getMovedExamsFromTj() const
+{
+    return movedExamsFromTj;
+}
+
+template <typename EOT>
+void ETTPKempeChain<EOT>::addMovedExamFromTi(int _ei, int _sourceRoom, int _destRoom)
+{
+    movedExamsFromTi.push_back(std::make_tuple(_ei, _sourceRoom, _destRoom));
+}
+
+template <typename EOT>
+void ETTPKempeChain<EOT>::addMovedExamFromTj(int _ei, int _sourceRoom, int _destRoom)
+{
+    movedExamsFromTj.push_back(std::make_tuple(_ei, _sourceRoom, _destRoom));
+}
+
+template <typename EOT>
+void ETTPKempeChain<EOT>::clearMovedExams()
+{
+    movedExamsFromTi.clear();
+    movedExamsFromTj.clear();
+}
+
 
 #endif // KEMPECHAIN_H
 
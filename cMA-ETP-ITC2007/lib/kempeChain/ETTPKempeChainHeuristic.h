@@ -3,13 +3,19 @@
 
 #include "eoFunctor.h"
 #include "kempeChain/ETTPKempeChain.h"
-#include <boost/unordered_set.hpp>
+#include "kempeChain/ETTPOperatorSelector.h"
+#include "kempeChain/ETTPMoveFilter.h"
+#include "kempeChain/ETTPPeriodScorer.h"
 #include <utils/eoRNG.h>
 #include "utils/Common.h"
 #include "containers/Matrix.h"
 #include "graphColouring/GraphColouringHeuristics.h"
 #include <vector>
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
+#include <chrono>
+#include <boost/shared_ptr.hpp>
 #include "containers/TimetableContainerMatrix.h" /// BECAUSE OF REMOVE_EXAM
 
 
@@ -66,6 +72,27 @@ public:
      */
     ETTPKempeChainHeuristic();
 
+    /**
+     * @brief ETTPKempeChainHeuristic Constructor
+     * @param _operatorSelector Adaptive operator selector shared between the heuristic instances of a run
+     * @param _moveFilter Quick-reject move filter shared between the heuristic instances of a run. If null, moves are not filtered
+     */
+    ETTPKempeChainHeuristic(boost::shared_ptr<ETTPOperatorSelector> const &_operatorSelector,
+                            boost::shared_ptr<ETTPMoveFilter<EOT> > const &_moveFilter = boost::shared_ptr<ETTPMoveFilter<EOT> >());
+
+    /**
+     * @brief getOperatorNames
+     * @return The names of the operators selectable in build(), indexed by operator selector index
+     */
+    static std::vector<std::string> getOperatorNames();
+
+    /**
+     * @brief setRandomGenerator Set the random number generator used to build and apply moves.
+     * By default, the global rng is used
+     * @param _rng
+     */
+    void setRandomGenerator(eoRng &_rng);
+
     /**
      * @brief build Create a Kempe chain for a random move
      * @param _sol
@@ -83,6 +110,20 @@ public:
      */
     void evaluateSolutionMove(EOT &_sol);
 
+    /**
+     * @brief reevaluateSolutionMove Evaluate the last built move on solution _sol, reusing its Kempe chain.
+     * Pre-condition: periods ti and tj of _sol have the same contents as in the solution where the move was evaluated
+     * @param _sol
+     */
+    void reevaluateSolutionMove(EOT &_sol);
+
+    /**
+     * @brief rebuildSolutionMove Rebuild the Kempe chain of the last built move (same exam, ti and tj)
+     * on solution _sol and evaluate it. The neighbour is infeasible if the exam is no longer in ti
+     * @param _sol
+     */
+    void rebuildSolutionMove(EOT &_sol);
+
     /**
      * @brief getKempeChain Return Kempe chain object
      * @return
@@ -107,6 +148,13 @@ public:
      */
     bool isFeasibleNeighbour() const;
 
+    /**
+     * @brief recordMoveOutcome Feed back the outcome of the last built move to the operator selector
+     * @param _accepted True if the neighbour was accepted
+     * @param _solutionFitness Fitness of the solution the neighbour was built from
+     */
+    void recordMoveOutcome(bool _accepted, double _solutionFitness);
+
 
     /**
      * @brief operator () Apply Kempe chain move to solution _sol
@@ -128,6 +176,15 @@ public:
     void undoSolutionMove(EOT &_sol);
 
 protected:
+    /**
+     * @brief verifyAndEvaluateSolutionMove Verify the Period-utilisation and Period-related constraints of
+     * the moved solution, evaluate the neighbour incrementally and undo the solution move.
+     * Pre-condition: _sol was moved to the neighbour and its final ti and tj exams were recorded
+     * @param _sol
+     * @param _solutionOriginalCost Solution cost prior moving the solution
+     */
+    void verifyAndEvaluateSolutionMove(EOT &_sol, long _solutionOriginalCost);
+
     /**
      * @brief apply
      */
@@ -144,7 +201,9 @@ protected:
                    int _tDest, std::vector<typename GCHeuristics<EOT>::VariableValueTuple> &_conflictingExamsTdest);
 
     /**
-     * @brief getSourceExamHardConflictsDestPeriod
+     * @brief getSourceExamHardConflictsDestPeriod Append to _conflictingExamsTdest the exams scheduled in
+     * (_tDest, _roomDest) which conflict with _examSource and were not yet visited by the current Kempe chain.
+     * Conflicts are found through the exam graph adjacency, so the cost depends only on the chain size.
      * @param _examSource
      * @param _examGraph
      * @param _tDest
@@ -153,7 +212,23 @@ protected:
      */
     void getSourceExamHardConflictsDestPeriod(int _examSource, AdjacencyList const &_examGraph,
                                           int _tDest, int _roomDest,
-                                          std::vector<typename GCHeuristics<EOT>::VariableValueTuple> &_conflictingExamsTdest) const;
+                                          std::vector<typename GCHeuristics<EOT>::VariableValueTuple> &_conflictingExamsTdest);
+
+    /**
+     * @brief startVisitGeneration Start a new Kempe chain visit generation. All exams become unvisited
+     * @param _numExams
+     */
+    void startVisitGeneration(int _numExams);
+
+    /**
+     * @brief visitExam Mark exam _ei as belonging to the current Kempe chain and push it into the _frontier.
+     * Exams already visited by the current chain are ignored
+     * @param _ei
+     * @param _tj Period where the exam is scheduled
+     * @param _rk Room where the exam is scheduled
+     * @param _frontier
+     */
+    inline void visitExam(int _ei, int _tj, int _rk, std::vector<typename GCHeuristics<EOT>::VariableValueTuple> &_frontier);
 
     /**
      * @brief initialiseKempeChain
@@ -223,6 +298,12 @@ protected:
      */
     void setNeighbourFeasibility(bool _value);
 
+    /**
+     * @brief rejectMove Set the neighbour as infeasible and count the rejection
+     * @param _reason
+     */
+    void rejectMove(typename ETTPMoveFilter<EOT>::RejectionReason _reason);
+
 
     /**
      * @brief shiftMove
@@ -238,6 +319,26 @@ protected:
     void roomMove(EOT &_sol);
 
 
+    /**
+     * @brief guidedShiftMove Shift move where tj is sampled among the feasible periods
+     * which improve the cost of the selected exam
+     * @param _sol
+     */
+    void guidedShiftMove(EOT &_sol);
+
+
+    /**
+     * @brief initialiseShiftMove Filter the shift move of exam _exami from _ti to _tj
+     * and initialise the Kempe chain
+     * @param _sol
+     * @param _ti
+     * @param _exami
+     * @param _roomi
+     * @param _tj
+     */
+    void initialiseShiftMove(EOT &_sol, int _ti, int _exami, int _roomi, int _tj);
+
+
     //
     // Fields
     //
@@ -257,6 +358,67 @@ protected:
      * @brief feasibleNeighbour
      */
     bool feasibleNeighbour;
+    /**
+     * @brief operatorSelector Adaptive operator selector. If null, operators are selected uniformly
+     */
+    boost::shared_ptr<ETTPOperatorSelector> operatorSelector;
+    /**
+     * @brief selectedOperatorIndex Operator selector index of the last built move
+     */
+    int selectedOperatorIndex;
+    /**
+     * @brief buildStartTime Time at which the last move started being built
+     */
+    std::chrono::steady_clock::time_point buildStartTime;
+    /**
+     * @brief moveFilter Quick-reject move filter. If null, moves are not filtered
+     */
+    boost::shared_ptr<ETTPMoveFilter<EOT> > moveFilter;
+    /**
+     * @brief periodScorer Period scorer used by the guided shift move
+     */
+    ETTPPeriodScorer<EOT> periodScorer;
+    /**
+     * @brief randomGenerator Random number generator used to build and apply moves
+     */
+    eoRng *randomGenerator;
+    //
+    // Kempe chain construction buffers. They are sized on the first chain and then reused,
+    // so that building a chain does no allocation.
+    //
+    /**
+     * @brief examVisitGeneration Generation in which each exam was last visited
+     */
+    std::vector<int> examVisitGeneration;
+    /**
+     * @brief visitGeneration Current visit generation. Exam ei belongs to the current chain
+     * iff examVisitGeneration[ei] == visitGeneration
+     */
+    int visitGeneration;
+    /**
+     * @brief examSourceRoom Room where each chain exam was scheduled before the move
+     */
+    std::vector<int> examSourceRoom;
+    /**
+     * @brief conflictingExamsTi Chain frontier in time slot ti
+     */
+    std::vector<typename GCHeuristics<EOT>::VariableValueTuple> conflictingExamsTi;
+    /**
+     * @brief conflictingExamsTj Chain frontier in time slot tj
+     */
+    std::vector<typename GCHeuristics<EOT>::VariableValueTuple> conflictingExamsTj;
+    /**
+     * @brief finalExamsTi Chain exams to be inserted in time slot ti
+     */
+    std::vector<typename GCHeuristics<EOT>::VariableValueTuple> finalExamsTi;
+    /**
+     * @brief finalExamsTj Chain exams to be inserted in time slot tj
+     */
+    std::vector<typename GCHeuristics<EOT>::VariableValueTuple> finalExamsTj;
+    /**
+     * @brief periodRelatedConflicts Scratch buffer for the exclusion conflicts of an exam
+     */
+    std::vector<typename GCHeuristics<EOT>::VariableValueTuple> periodRelatedConflicts;
 };
 
 
@@ -274,11 +436,51 @@ protected:
  */
 template <typename EOT>
 ETTPKempeChainHeuristic<EOT>::ETTPKempeChainHeuristic()
-    : neighborFitness(0), neighborSolutionCost(0), feasibleNeighbour(false)
+    : neighborFitness(0), neighborSolutionCost(0), feasibleNeighbour(false),
+      selectedOperatorIndex(0), randomGenerator(&rng), visitGeneration(0)
+{ }
+
+
+
+/**
+ * @brief ETTPKempeChainHeuristic Constructor
+ * @param _operatorSelector Adaptive operator selector shared between the heuristic instances of a run
+ * @param _moveFilter Quick-reject move filter shared between the heuristic instances of a run. If null, moves are not filtered
+ */
+template <typename EOT>
+ETTPKempeChainHeuristic<EOT>::ETTPKempeChainHeuristic(boost::shared_ptr<ETTPOperatorSelector> const &_operatorSelector,
+                                                      boost::shared_ptr<ETTPMoveFilter<EOT> > const &_moveFilter)
+    : neighborFitness(0), neighborSolutionCost(0), feasibleNeighbour(false),
+      operatorSelector(_operatorSelector), selectedOperatorIndex(0), moveFilter(_moveFilter),
+      randomGenerator(&rng), visitGeneration(0)
 { }
 
 
 
+/**
+ * @brief getOperatorNames
+ * @return The names of the operators selectable in build(), indexed by operator selector index
+ */
+template <typename EOT>
+std::vector<std::string> ETTPKempeChainHeuristic<EOT>::getOperatorNames() {
+    // Index 0 - Shift move, index 1 - Room move, index 2 - Guided shift move
+    return { "ShiftMove", "RoomMove", "GuidedShiftMove" };
+}
+
+
+
+/**
+ * @brief setRandomGenerator Set the random number generator used to build and apply moves.
+ * By default, the global rng is used
+ * @param _rng
+ */
+template <typename EOT>
+void ETTPKempeChainHeuristic<EOT>::setRandomGenerator(eoRng &_rng) {
+    randomGenerator = &_rng;
+}
+
+
+
 
 /**
  * @brief build Create a Kempe chain for a random move
@@ -292,7 +494,7 @@ void ETTPKempeChainHeuristic<EOT>::build(EOT &_sol)
     //
     // In all operators, feasibility is checked and Kempe Chain heuristic is
     // used to repair the infeasibilities. The four operators are selected randomly
-    // in equal proportions.
+    // in equal proportions, unless an adaptive operator selector is used.
     //
     // 1. Room move - Here a random exam is just moved into a different
     // (randomly chosen) room within the same timeslot.
@@ -307,16 +509,33 @@ void ETTPKempeChainHeuristic<EOT>::build(EOT &_sol)
     // including all their exams and rooms.
     //
 
-    if (rng.flip() < 0.5) {
+    if (operatorSelector.get() != nullptr) {
+        // Record build start time for crediting the operator per unit of evaluation time
+        buildStartTime = std::chrono::steady_clock::now();
+        // Select operator index (see getOperatorNames)
+        selectedOperatorIndex = operatorSelector->selectOperator(*randomGenerator);
+    }
+    else
+        selectedOperatorIndex = randomGenerator->flip() ? 1 : 0;
+
+    if (moveFilter.get() != nullptr)
+        moveFilter->recordMove();
+
+    if (selectedOperatorIndex == 0) {
          // Apply operator 2. Shift move - Here a random exam is moved into different
          // (randomly chosen) timeslot and room.
         shiftMove(_sol);
     }
-    else {
+    else if (selectedOperatorIndex == 1) {
         // Apply operator 1. Room move - Here a random exam is just moved into a different
         // (randomly chosen) room within the same timeslot.
         roomMove(_sol);
     }
+    else {
+        // Apply guided shift move - Here a random exam is moved into the timeslot
+        // sampled among the feasible periods which improve its cost.
+        guidedShiftMove(_sol);
+    }
 
 /// TODO: OTHER OPERATORS
 ///
@@ -355,8 +574,6 @@ void ETTPKempeChainHeuristic<EOT>::evaluateSolutionMove(EOT &_sol) {
         return;
     }
 
-    // Get TimetableContainer object
-    TimetableContainer &timetableCont = _sol.getTimetableContainer();
     // Get original solution cost prior moving the solution
     long solutionOriginalCost = _sol.getSolutionCost();
 
@@ -386,6 +603,75 @@ void ETTPKempeChainHeuristic<EOT>::evaluateSolutionMove(EOT &_sol) {
 
     // Record ti and tj final time slots
     recordFinalPeriodExams(kempeChain.getTi(), kempeChain.getTj());
+    // Verify the constraints, evaluate the neighbour and undo the solution move
+    verifyAndEvaluateSolutionMove(_sol, solutionOriginalCost);
+}
+
+
+
+
+
+/**
+ * @brief reevaluateSolutionMove Evaluate the last built move on solution _sol, reusing its Kempe chain.
+ * Pre-condition: periods ti and tj of _sol have the same contents as in the solution where the move was evaluated
+ * @param _sol
+ */
+template <typename EOT>
+void ETTPKempeChainHeuristic<EOT>::reevaluateSolutionMove(EOT &_sol) {
+    if (!isFeasibleNeighbour())
+        return;
+    // The original and final ti and tj exams recorded in the Kempe chain are still valid for _sol
+    kempeChain.setSolution(&_sol);
+    // Get original solution cost prior moving the solution
+    long solutionOriginalCost = _sol.getSolutionCost();
+    // Move, temporarily, the solution to the neighbour
+    doSolutionMove(_sol);
+    // Verify the constraints, evaluate the neighbour and undo the solution move
+    verifyAndEvaluateSolutionMove(_sol, solutionOriginalCost);
+}
+
+
+
+
+
+/**
+ * @brief rebuildSolutionMove Rebuild the Kempe chain of the last built move (same exam, ti and tj)
+ * on solution _sol and evaluate it. The neighbour is infeasible if the exam is no longer in ti
+ * @param _sol
+ */
+template <typename EOT>
+void ETTPKempeChainHeuristic<EOT>::rebuildSolutionMove(EOT &_sol) {
+    int exami = kempeChain.getEi();
+    int ti = kempeChain.getTi();
+    // Initially assume that neigbour solution is feasible
+    setNeighbourFeasibility(true);
+    if (!_sol.getTimetableContainer().isExamScheduled(exami, ti)) {
+        setNeighbourFeasibility(false);
+        return;
+    }
+    // The exam may have been moved to another room
+    int roomi = _sol.getScheduledExamsVector()[exami].getRoom();
+    // Initialise Kempe chain object
+    initialiseKempeChain(_sol, ti, exami, roomi, kempeChain.getTj());
+    // Evaluate move of solution to the neighbour
+    evaluateSolutionMove(_sol);
+}
+
+
+
+
+
+/**
+ * @brief verifyAndEvaluateSolutionMove Verify the Period-utilisation and Period-related constraints of
+ * the moved solution, evaluate the neighbour incrementally and undo the solution move.
+ * Pre-condition: _sol was moved to the neighbour and its final ti and tj exams were recorded
+ * @param _sol
+ * @param _solutionOriginalCost Solution cost prior moving the solution
+ */
+template <typename EOT>
+void ETTPKempeChainHeuristic<EOT>::verifyAndEvaluateSolutionMove(EOT &_sol, long _solutionOriginalCost) {
+    // Get TimetableContainer object
+    TimetableContainer &timetableCont = _sol.getTimetableContainer();
 
     /////////////////////////////////////////////////////////////////////
     /// NON-OPTIMIZED AND NON INCREMENTAL
@@ -407,15 +693,17 @@ void ETTPKempeChainHeuristic<EOT>::evaluateSolutionMove(EOT &_sol) {
         // In order to verify the constraints, is necessary to unschedule the exam
         timetableCont.unscheduleExam(exam, kempeChain.getTi());
         // Verify constraints
-        if (!(_sol.verifyPeriodUtilisationConstraint(exam, kempeChain.getTi())
-               && _sol.verifyPeriodRelatedConstraints(exam, kempeChain.getTi()) )) {
+        bool periodUtilisation = _sol.verifyPeriodUtilisationConstraint(exam, kempeChain.getTi());
+        bool periodRelated = periodUtilisation && _sol.verifyPeriodRelatedConstraints(exam, kempeChain.getTi());
+        // Schedule the exam again
+        timetableCont.scheduleExam(exam, kempeChain.getTi(), room);
+        if (!(periodUtilisation && periodRelated)) {
 #ifdef DEBUG_MODE
             cout << "Period-utilisation and After constraints were not verified" << endl;
 #endif
-            setNeighbourFeasibility(false);
+            rejectMove(!periodUtilisation ? ETTPMoveFilter<EOT>::PeriodUtilisation : ETTPMoveFilter<EOT>::PeriodRelated);
+            break;
         }
-        // Schedule the exam again
-        timetableCont.scheduleExam(exam, kempeChain.getTi(), room);
     }
     if (isFeasibleNeighbour()) {
         // Verify period Tj Period-utilisation and After constraints after the move
@@ -431,15 +719,17 @@ void ETTPKempeChainHeuristic<EOT>::evaluateSolutionMove(EOT &_sol) {
             // In order to verify the constraints, is necessary to unschedule the exam
             timetableCont.unscheduleExam(exam, kempeChain.getTj());
             // Verify constraints
-            if (!( _sol.verifyPeriodUtilisationConstraint(exam, kempeChain.getTj())
-                   && _sol.verifyPeriodRelatedConstraints(exam, kempeChain.getTj()) )) {
+            bool periodUtilisation = _sol.verifyPeriodUtilisationConstraint(exam, kempeChain.getTj());
+            bool periodRelated = periodUtilisation && _sol.verifyPeriodRelatedConstraints(exam, kempeChain.getTj());
+            // Schedule the exam again
+            timetableCont.scheduleExam(exam, kempeChain.getTj(), room);
+            if (!(periodUtilisation && periodRelated)) {
     #ifdef DEBUG_MODE
                 cout << "Period-utilisation and After constraints were not verified" << endl;
     #endif
-                setNeighbourFeasibility(false);
+                rejectMove(!periodUtilisation ? ETTPMoveFilter<EOT>::PeriodUtilisation : ETTPMoveFilter<EOT>::PeriodRelated);
+                break;
             }
-            // Schedule the exam again
-            timetableCont.scheduleExam(exam, kempeChain.getTj(), room);
         }
     }
 /*
@@ -464,7 +754,7 @@ void ETTPKempeChainHeuristic<EOT>::evaluateSolutionMove(EOT &_sol) {
     //
     // Undo solution move before computeExamProximityConflictsIncremental() - pre-condition
     undoSolutionMove(_sol);
-    _sol.setSolutionCost(solutionOriginalCost);
+    _sol.setSolutionCost(_solutionOriginalCost);
 */
 
     if (isFeasibleNeighbour()) {
@@ -475,7 +765,7 @@ void ETTPKempeChainHeuristic<EOT>::evaluateSolutionMove(EOT &_sol) {
         //
         // Undo solution move before computeExamProximityConflictsIncremental() - pre-condition
         undoSolutionMove(_sol);
-        _sol.setSolutionCost(solutionOriginalCost);
+        _sol.setSolutionCost(_solutionOriginalCost);
         // Compute new solution exam proximity conflicts considering the move to the neighbor.
         // Perform an incremental evaluation
         _sol.computeSolutionCostIncremental(kempeChain);
@@ -491,7 +781,7 @@ void ETTPKempeChainHeuristic<EOT>::evaluateSolutionMove(EOT &_sol) {
     // Undo solution move
     undoSolutionMove(_sol);
     // Reset exam proximity conflicts
-    _sol.setSolutionCost(solutionOriginalCost);
+    _sol.setSolutionCost(_solutionOriginalCost);
 
     // Could not show fitness here, eval wasn't invoked yet
 //    cout << "sol fitness = " << _sol.fitness() << endl;
@@ -555,6 +845,26 @@ bool ETTPKempeChainHeuristic<EOT>::isFeasibleNeighbour() const {
 
 
 
+/**
+ * @brief recordMoveOutcome Feed back the outcome of the last built move to the operator selector
+ * @param _accepted True if the neighbour was accepted
+ * @param _solutionFitness Fitness of the solution the neighbour was built from
+ */
+template <typename EOT>
+void ETTPKempeChainHeuristic<EOT>::recordMoveOutcome(bool _accepted, double _solutionFitness) {
+    if (operatorSelector.get() == nullptr)
+        return;
+    // Time spent building and evaluating the move
+    std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - buildStartTime;
+    // Cost decrease (minimization problem)
+    double improvement = isFeasibleNeighbour() ? _solutionFitness - neighborFitness : 0;
+    operatorSelector->recordMove(selectedOperatorIndex, isFeasibleNeighbour(), _accepted,
+                                 improvement, elapsedTime.count());
+}
+
+
+
+
 /**
  * @brief operator() Move current solution _sol to this neighbour using
  * information maintained in the KempeChain structure
@@ -688,12 +998,18 @@ void ETTPKempeChainHeuristic<EOT>::apply() {
     // ej, ek, ..., to time slot ti. This process is repeated until all the
     // exams that have students in common are assigned to different time slots.
     //
-    // Vector containing conflicting exams in time slot ti
-    std::vector<typename GCHeuristics<EOT>::VariableValueTuple> conflictingExamsTi;
-    // Vector containing conflicting exams in time slot tj
-    std::vector<typename GCHeuristics<EOT>::VariableValueTuple> conflictingExamsTj;
+    // The chain is built breadth-first over the exam graph. Exams are marked as visited
+    // in a generation-stamped array, so no exam enters the chain twice.
+    //
+    // Start a new chain
+    startVisitGeneration(kempeChain.getSolution().getNumExams());
+    conflictingExamsTi.clear();
+    conflictingExamsTj.clear();
+    finalExamsTi.clear();
+    finalExamsTj.clear();
+    kempeChain.clearMovedExams();
     // Push tuple (exami, ti, roomi) into the conflictingExamsTi vector
-    conflictingExamsTi.push_back(std::make_tuple(kempeChain.getEi(), kempeChain.getTi(), kempeChain.getRi()));
+    visitExam(kempeChain.getEi(), kempeChain.getTi(), kempeChain.getRi(), conflictingExamsTi);
     // Move exams between time slots in order to maintain feasibility
     doFeasibleExamMove(kempeChain.getTi(), conflictingExamsTi,
                        kempeChain.getTj(), conflictingExamsTj);
@@ -729,7 +1045,9 @@ void ETTPKempeChainHeuristic<EOT>::doFeasibleExamMove(
     // Get source exam from conflict vector
     int examSource = std::get<0>(_conflictingExamsTsource.back());
 
-    std::vector<typename GCHeuristics<EOT>::VariableValueTuple> finalExamsTsource, finalExamsTdest;
+    // Chain exams to be inserted in the source (ti) and dest (tj) time slots
+    auto &finalExamsTsource = finalExamsTi;
+    auto &finalExamsTdest = finalExamsTj;
 
 
     std::vector<TimetableContainer::ExamRoomTuple> periodTiExams, periodTjExams;
@@ -765,7 +1083,7 @@ void ETTPKempeChainHeuristic<EOT>::doFeasibleExamMove(
 #endif
 
             // Generate random room index
-            randomDestRoom = rng.uniform(sol.getNumRooms());
+            randomDestRoom = randomGenerator->uniform(sol.getNumRooms());
 
             // Dest room capacity
             capacityDestRoom = roomVector[randomDestRoom]->getCapacity();
@@ -777,7 +1095,7 @@ void ETTPKempeChainHeuristic<EOT>::doFeasibleExamMove(
                 cout << "\tNo feasible room found." << endl;
 #endif
                 // Set solution to be unfeasible
-                setNeighbourFeasibility(false);
+                rejectMove(ETTPMoveFilter<EOT>::NoFeasibleRoom);
                 return;
             }
         }
@@ -842,12 +1160,14 @@ void ETTPKempeChainHeuristic<EOT>::doFeasibleExamMove(
                 int examSource = std::get<0>(_conflictingExamsTsource.back());
 
                 ////////////////////////////////////////////////////////////////////////////////
+                // Get # exams already in the chain frontier
+                int numConflictingExams = _conflictingExamsTdest.size();
                 // 1. Get source exam adjacent vertices that are scheduled in tDest time slot
                 getSourceExamHardConflictsDestPeriod(examSource, examGraph, _tDest, destRoom, _conflictingExamsTdest);
                 //
-                // Unschedule all conflicting exams
+                // Unschedule the new conflicting exams
                 //
-                for (int i = 0; i < _conflictingExamsTdest.size(); ++i) {
+                for (int i = numConflictingExams; i < _conflictingExamsTdest.size(); ++i) {
                     // Get exam variable
                     auto const &variable = _conflictingExamsTdest[i];
                     // Get exam
@@ -882,12 +1202,14 @@ void ETTPKempeChainHeuristic<EOT>::doFeasibleExamMove(
                 int examSource = std::get<0>(_conflictingExamsTdest.back());
 
                 ////////////////////////////////////////////////////////////////////////////////
+                // Get # exams already in the chain frontier
+                int numConflictingExams = _conflictingExamsTsource.size();
                 // 1. Get source exam adjacent vertices that are scheduled in tDest time slot
                 getSourceExamHardConflictsDestPeriod(examSource, examGraph, _tSource, sourceRoom, _conflictingExamsTsource);
                 //
-                // Unschedule all conflicting exams
+                // Unschedule the new conflicting exams
                 //
-                for (int i = 0; i < _conflictingExamsTsource.size(); ++i) {
+                for (int i = numConflictingExams; i < _conflictingExamsTsource.size(); ++i) {
                     // Get exam variable
                     auto const &variable = _conflictingExamsTsource[i];
                     // Get exam
@@ -964,12 +1286,14 @@ void ETTPKempeChainHeuristic<EOT>::doFeasibleExamMove(
                 }
 
                 ////////////////////////////////////////////////////////////////////////////////
+                // Get # exams already in the chain frontier
+                int numConflictingExams = _conflictingExamsTdest.size();
                 // 1. Get source exam adjacent vertices that are scheduled in tDest time slot
                 getSourceExamHardConflictsDestPeriod(examSource, examGraph, _tDest, roomDest, _conflictingExamsTdest);
                 //
-                // Unschedule all conflicting exams
+                // Unschedule the new conflicting exams
                 //
-                for (int i = 0; i < _conflictingExamsTdest.size(); ++i) {
+                for (int i = numConflictingExams; i < _conflictingExamsTdest.size(); ++i) {
                     // Get exam variable
                     auto const &variable = _conflictingExamsTdest[i];
                     // Get exam
@@ -1007,12 +1331,14 @@ void ETTPKempeChainHeuristic<EOT>::doFeasibleExamMove(
                 int roomDest;
                 roomDest = std::get<2>(_conflictingExamsTdest.back());
                 ////////////////////////////////////////////////////////////////////////////////
+                // Get # exams already in the chain frontier
+                int numConflictingExams = _conflictingExamsTsource.size();
                 // 1. Get source exam adjacent vertices that are scheduled in tDest time slot
                 getSourceExamHardConflictsDestPeriod(examSource, examGraph, _tSource, roomDest, _conflictingExamsTsource);
                 //
-                // Unschedule all conflicting exams
+                // Unschedule the new conflicting exams
                 //
-                for (int i = 0; i < _conflictingExamsTsource.size(); ++i) {
+                for (int i = numConflictingExams; i < _conflictingExamsTsource.size(); ++i) {
                     // Get exam variable
                     auto const &variable = _conflictingExamsTsource[i];
                     // Get exam
@@ -1062,6 +1388,8 @@ void ETTPKempeChainHeuristic<EOT>::doFeasibleExamMove(
         ////////////////////
         // Schedule exam
         timetableCont.scheduleExam(examSource, _tSource, roomDest);
+        // Record move in the Kempe chain
+        kempeChain.addMovedExamFromTj(examSource, examSourceRoom[examSource], roomDest);
         // Pop exam
         finalExamsTsource.pop_back();
     }
@@ -1082,6 +1410,8 @@ void ETTPKempeChainHeuristic<EOT>::doFeasibleExamMove(
         ////////////////////
         // Schedule exam
         timetableCont.scheduleExam(examSource, _tDest, roomDest);
+        // Record move in the Kempe chain
+        kempeChain.addMovedExamFromTi(examSource, examSourceRoom[examSource], roomDest);
         // Pop exam
         finalExamsTdest.pop_back();
     }
@@ -1137,7 +1467,9 @@ void ETTPKempeChainHeuristic<EOT>::doFeasibleExamMove(
 
 
 /**
- * @brief getSourceExamHardConflictsDestPeriod
+ * @brief getSourceExamHardConflictsDestPeriod Append to _conflictingExamsTdest the exams scheduled in
+ * (_tDest, _roomDest) which conflict with _examSource and were not yet visited by the current Kempe chain.
+ * Pre-condition: _examSource is not scheduled
  * @param _examSource
  * @param _examGraph
  * @param _tDest
@@ -1148,91 +1480,163 @@ template <typename EOT>
 void ETTPKempeChainHeuristic<EOT>
     ::getSourceExamHardConflictsDestPeriod(int _examSource, AdjacencyList const &_examGraph,
                                        int _tDest, int _roomDest,
-                                       std::vector<typename GCHeuristics<EOT>::VariableValueTuple> &_conflictingExamsTdest) const {
-
+                                       std::vector<typename GCHeuristics<EOT>::VariableValueTuple> &_conflictingExamsTdest) {
+    //
+    // The hard conflicts are the ones determined by GCHeuristics<EOT>::hardConflictsWithoutAfterConstraint,
+    // but they are obtained without scanning all the exams and without allocating memory:
+    //   - No-Conflicts are found through the exam graph adjacency of _examSource;
+    //   - Room-Occupancy and Room-Related conflicts are found by scanning the _tDest period exams;
+    //   - Exclusion conflicts are only verified if _examSource has Period-Related constraints.
+    // Exams already visited by the current chain are skipped, so there is no need to sort and remove
+    // duplicates afterwards.
+    //
     // Get solution
     auto &sol = this->kempeChain.getSolution();
     // Get timetable container
     TimetableContainer &timetableCont = sol.getTimetableContainer();
-    // Get scheduled exams vector
-    auto const &scheduledExamsVector = sol.getScheduledExamsVector();
-
-    //////////////////////////////////////////////////////////////////////////////////////////////////
-    // Pre-condition for verifying the hard constraints: examSource must not be scheduled
-    //
-    // We have first to unschedule the _examSource from its current period and room in order to find
-    // the hard conflicts of _examSource in the (_tDest, _roomDest) period-room pair.
-    // This is because the hardConflicts method schedules the exam (if necessary) in order to verify the constraints.
-    //
+    // Get _tDest period exams
+    auto const &periodExams = timetableCont.getPeriodExams(_tDest);
+    // Exam vector
+    auto const &examVector = sol.getExamVector();
 
 #ifdef DEBUG_MODE
-    // Get ScheduledExam object
-    ScheduledExam const &scheduledExam = scheduledExamsVector[_examSource];
-    // Source time slot
-    int sourceTimeslot = scheduledExam.getPeriod();
-    // Source room
-    int sourceRoom = scheduledExam.getRoom();
     cout << endl << "In [ETTPKempeChainHeuristic<EOT>::getSourceExamHardConflictsDestPeriod] method:" << endl;
-    bool examScheduled = scheduledExam.isScheduled();
-    cout << "_examSource = " << _examSource << ", sourceTimeslot = " << sourceTimeslot << ", sourceRoom = " << sourceRoom
-         << ", isScheduled() = " << (examScheduled ? "Yes" : "No") << endl;
-//    if (!examScheduled)
-//        throw runtime_error("In method [ETTPKempeChainHeuristic<EOT>::getSourceExamHardConflictsDestPeriod]: Exam should be scheduled");
     cout << "Determine hardConflicts for _examSource " << _examSource << " in (_tDest, _roomDest) = ("
          << _tDest << ", " << _roomDest << ")" << endl;
+    int numConflictingExams = _conflictingExamsTdest.size();
 #endif
 
-    // Unschedule exam
-//    timetableCont.unscheduleExam(_examSource, sourceTimeslot);
-    //////////////////////////////////////////////////////////////////////////////////////////////////
-    // Get conflicting exams
-//    auto hardConflicts = GCHeuristics<EOT>::hardConflicts(_examSource, std::make_tuple(_tDest, _roomDest));
-
-    auto hardConflicts = GCHeuristics<EOT>::hardConflictsWithoutAfterConstraint(sol, _examSource, std::make_tuple(_tDest, _roomDest));
-
-
+    //-
+    // Room-Occupancy: For every room and period no more seats are used than are available
+    //   for that room.
+    //-
+    if (!sol.verifyRoomOccupancyConstraint(_examSource, _tDest, _roomDest)) {
+        // Get number of students for exam _examSource
+        int thisExamNumStudents = examVector[_examSource]->getNumStudents();
+        // Get number of currently occupied seats for room _roomDest
+        int numOccupiedSeats = sol.getScheduledRoomsVector()[_roomDest].getNumOccupiedSeats(_tDest);
+        // Get seat capacity for room _roomDest
+        int roomSeatCapacity = sol.getRoomVector()[_roomDest]->getCapacity();
+        // Remove the last exams allocated to room _roomDest until _examSource fits in
+        for (auto it = periodExams.rbegin(); it != periodExams.rend() &&
+             numOccupiedSeats + thisExamNumStudents > roomSeatCapacity; ++it) {
+            if (std::get<1>(*it) == _roomDest) {
+                int exam = std::get<0>(*it);
+                visitExam(exam, _tDest, _roomDest, _conflictingExamsTdest);
+                // Decrement # occupied seats
+                numOccupiedSeats -= examVector[exam]->getNumStudents();
+            }
+        }
+    }
 
-    //////////////////////////////////////////////////////////////////////////////////////////////////
-    // Schedule exam again
-//    timetableCont.scheduleExam(_examSource, sourceTimeslot, sourceRoom);
-    //////////////////////////////////////////////////////////////////////////////////////////////////
+    //-
+    // No-Conflicts: Conflicting exams cannot be assigned to the same period.
+    //-
+    boost::property_map<AdjacencyList, boost::vertex_index_t>::type index_map = get(boost::vertex_index, _examGraph);
+    boost::graph_traits<AdjacencyList>::adjacency_iterator ai, a_end;
+    for (boost::tie(ai, a_end) = adjacent_vertices(_examSource, _examGraph); ai != a_end; ++ai) {
+        // Get adjacent exam
+        int ej = get(index_map, *ai);
+        if (timetableCont.isExamScheduled(ej, _tDest))
+            visitExam(ej, _tDest, timetableCont.getRoom(ej, _tDest), _conflictingExamsTdest);
+    }
 
-    // Add hard conflicts to _conflictingExamsTdest  vector
-    for (auto const &conflict : hardConflicts) {
-        _conflictingExamsTdest.push_back(conflict);
+    //-
+    // Period-Related: EXCLUSION constraints
+    //-
+    if (!examVector[_examSource]->getPeriodRelatedHardConstraints().empty()) {
+        periodRelatedConflicts.clear();
+        GCHeuristics<EOT>::buildPeriodRelatedExclusionHardConflicts(sol, _examSource, _tDest, periodRelatedConflicts);
+        for (auto const &conflict : periodRelatedConflicts)
+            visitExam(std::get<0>(conflict), std::get<1>(conflict), std::get<2>(conflict), _conflictingExamsTdest);
     }
 
-    // Apply unique to variable vector to find the new end without duplicate.
-    // Then remove duplicates
-    std::sort(_conflictingExamsTdest.begin(), _conflictingExamsTdest.end());
-    auto it = std::unique(_conflictingExamsTdest.begin(), _conflictingExamsTdest.end());
-    _conflictingExamsTdest.resize(it-_conflictingExamsTdest.begin());
+    //-
+    // Room-Related: ROOM_EXCLUSIVE constraints
+    //-
+    // 1. _examSource has ROOM_EXCLUSIVE constraint itself. All the exams in the room are conflicting.
+    auto const &roomRelatedHardConstraintsVector = examVector[_examSource]->getRoomRelatedHardConstraints();
+    if (!roomRelatedHardConstraintsVector.empty()) {
+        // Schedule temporarily _examSource in order to verify the constraint
+        timetableCont.scheduleExam(_examSource, _tDest, _roomDest);
+        bool satisfied = roomRelatedHardConstraintsVector.front()->operator()(sol) == 0;
+        timetableCont.unscheduleExam(_examSource, _tDest);
+        if (!satisfied) {
+            for (auto const &examRoomTuple : periodExams) {
+                if (std::get<1>(examRoomTuple) == _roomDest)
+                    visitExam(std::get<0>(examRoomTuple), _tDest, _roomDest, _conflictingExamsTdest);
+            }
+        }
+    }
+    // 2. The room has one other exam, which has ROOM_EXCLUSIVE constraint. That exam is conflicting.
+    int numRoomExams = 0, roomExam = -1;
+    for (auto const &examRoomTuple : periodExams) {
+        if (std::get<1>(examRoomTuple) == _roomDest) {
+            roomExam = std::get<0>(examRoomTuple);
+            if (++numRoomExams > 1)
+                break;
+        }
+    }
+    if (numRoomExams == 1 && !examVector[roomExam]->getRoomRelatedHardConstraints().empty()) {
+        // Schedule temporarily _examSource in order to verify the constraint
+        timetableCont.scheduleExam(_examSource, _tDest, _roomDest);
+        bool satisfied = examVector[roomExam]->getRoomRelatedHardConstraints().front()->operator()(sol) == 0;
+        timetableCont.unscheduleExam(_examSource, _tDest);
+        if (!satisfied)
+            visitExam(roomExam, _tDest, _roomDest, _conflictingExamsTdest);
+    }
 
 #ifdef DEBUG_MODE
     cout << "Hard conflicts: " << endl;
-    for (auto const &conflict : _conflictingExamsTdest) {
-        // Get exam
-        int exam = std::get<0>(conflict);
-        // Get timeslot
-        int timeslot = std::get<1>(conflict);
-        // Get room
-        int room = std::get<2>(conflict);
-        // Get ScheduledExam object
-        ScheduledExam const &scheduledExam = scheduledExamsVector[exam];
-        // Source time slot
-        int scheduledTimeslot = scheduledExam.getPeriod();
-        // Source room
-        int scheduledRoom = scheduledExam.getRoom();
-        // Exam scheduled?
-        bool examScheduled = scheduledExam.isScheduled();
-        cout << "exam = " << exam << ", timeslot = " << timeslot << ", room = " << room << endl
-             << "scheduledExam = " << scheduledExam.getId() << ", scheduledTimeslot = " << scheduledTimeslot
-             << ", scheduledRoom = " << scheduledRoom
-             << ", isScheduled() = " << (examScheduled ? "Yes" : "No") << endl;
+    for (int i = numConflictingExams; i < _conflictingExamsTdest.size(); ++i) {
+        auto const &conflict = _conflictingExamsTdest[i];
+        cout << "exam = " << std::get<0>(conflict) << ", timeslot = " << std::get<1>(conflict)
+             << ", room = " << std::get<2>(conflict) << endl;
     }
-
 #endif
+}
+
+
+
+/**
+ * @brief startVisitGeneration Start a new Kempe chain visit generation. All exams become unvisited
+ * @param _numExams
+ */
+template <typename EOT>
+void ETTPKempeChainHeuristic<EOT>::startVisitGeneration(int _numExams) {
+    // The buffers are only (re)sized for the first chain, or if the problem changes
+    if (examVisitGeneration.size() != _numExams) {
+        examVisitGeneration.assign(_numExams, 0);
+        examSourceRoom.assign(_numExams, -1);
+        visitGeneration = 0;
+    }
+    // On overflow, reset the visit generations
+    if (visitGeneration == std::numeric_limits<int>::max()) {
+        std::fill(examVisitGeneration.begin(), examVisitGeneration.end(), 0);
+        visitGeneration = 0;
+    }
+    ++visitGeneration;
+}
+
 
+
+/**
+ * @brief visitExam Mark exam _ei as belonging to the current Kempe chain and push it into the _frontier.
+ * Exams already visited by the current chain are ignored
+ * @param _ei
+ * @param _tj Period where the exam is scheduled
+ * @param _rk Room where the exam is scheduled
+ * @param _frontier
+ */
+template <typename EOT>
+void ETTPKempeChainHeuristic<EOT>::visitExam(int _ei, int _tj, int _rk,
+                                             std::vector<typename GCHeuristics<EOT>::VariableValueTuple> &_frontier) {
+    if (examVisitGeneration[_ei] != visitGeneration) {
+        examVisitGeneration[_ei] = visitGeneration;
+        // Record the room the exam is leaving
+        examSourceRoom[_ei] = _rk;
+        _frontier.push_back(std::make_tuple(_ei, _tj, _rk));
+    }
 }
 
 
@@ -1261,9 +1665,10 @@ void ETTPKempeChainHeuristic<EOT>::initialiseKempeChain(EOT &_sol, int _ti, int
     kempeChain.setRi(_roomi);
     // Set destination timeslot Tj
     kempeChain.setTj(_tj);
-    // Record source Ti and Tj period exams
+    // Record source Ti and Tj period exams. Not needed if the move was already rejected
     // Pre-condition: kempe chain solution must be initialised
-    recordOriginalPeriodExams(_ti, _tj);
+    if (isFeasibleNeighbour())
+        recordOriginalPeriodExams(_ti, _tj);
 }
 
 
@@ -1323,7 +1728,7 @@ void ETTPKempeChainHeuristic<EOT>::selectRandomExam(TimetableContainer const &_t
     // Get period exams
     auto &periodExams = _timetableCont.getPeriodExams(_ti);
     // Generate random exam ei index
-    int randIdx = rng.random(periodExams.size());
+    int randIdx = randomGenerator->random(periodExams.size());
     // Selected exam id to move
     auto &examRoomTuple = periodExams[randIdx];
     // Get exam
@@ -1346,7 +1751,7 @@ void ETTPKempeChainHeuristic<EOT>::selectRandomExam(TimetableContainer const &_t
  */
 template <typename EOT>
 bool ETTPKempeChainHeuristic<EOT>::selectRandomRoomWithCapacity(EOT &_sol, int _ei, int _tj, int &_rk) const {
-    return _sol.getFeasibleRoom(_ei, _tj, _rk);
+    return _sol.getFeasibleRoom(_ei, _tj, _rk, *randomGenerator);
 }
 
 
@@ -1365,9 +1770,9 @@ void ETTPKempeChainHeuristic<EOT>::selectRandomTimeslots(TimetableContainer cons
                                                          int &_ti, int &_tj) const {
     // Select randomly two time slots, ti and tj.
     do {
-        _ti = rng.random(_numPeriods);
+        _ti = randomGenerator->random(_numPeriods);
         do {
-            _tj = rng.random(_numPeriods);
+            _tj = randomGenerator->random(_numPeriods);
         }
         while (_ti == _tj);
     }
@@ -1391,7 +1796,7 @@ void ETTPKempeChainHeuristic<EOT>::selectRandomTimeslot(TimetableContainer const
                                                          int &_ti) const {
     // Select randomly a time slots, ti.
     do {
-        _ti = rng.random(_numPeriods);
+        _ti = randomGenerator->random(_numPeriods);
     }
     // Repeat until we found a non-empty time slot ti
     while (_timetableCont.getPeriodSize(_ti) == 0);
@@ -1412,6 +1817,20 @@ void ETTPKempeChainHeuristic<EOT>::setNeighbourFeasibility(bool _value) {
 
 
 
+/**
+ * @brief rejectMove Set the neighbour as infeasible and count the rejection
+ * @param _reason
+ */
+template <typename EOT>
+void ETTPKempeChainHeuristic<EOT>::rejectMove(typename ETTPMoveFilter<EOT>::RejectionReason _reason) {
+    setNeighbourFeasibility(false);
+    if (moveFilter.get() != nullptr)
+        moveFilter->recordRejection(_reason);
+}
+
+
+
+
 
 /**
  * @brief shiftMove
@@ -1437,8 +1856,8 @@ void ETTPKempeChainHeuristic<EOT>:: shiftMove(EOT &_sol) {
     // Selected exam id (randomly) to move, and return its room
     int exami, roomi;
     selectRandomExam(timetableCont, _sol, ti, exami, roomi);
-     // Initialise Kempe chain object
-    initialiseKempeChain(_sol, ti, exami, roomi, tj);
+    // Filter the move and initialise Kempe chain object
+    initialiseShiftMove(_sol, ti, exami, roomi, tj);
 
 #ifdef ETTP_KEMPE_CHAIN_HEURISTIC_DEBUG
     std::cout << std::endl << std::endl
@@ -1455,6 +1874,74 @@ void ETTPKempeChainHeuristic<EOT>:: shiftMove(EOT &_sol) {
 
 
 
+/**
+ * @brief guidedShiftMove Shift move where tj is sampled among the feasible periods
+ * which improve the cost of the selected exam
+ * @param _sol
+ */
+template <typename EOT>
+void ETTPKempeChainHeuristic<EOT>::guidedShiftMove(EOT &_sol) {
+    // The Kempe chain is built as in the shift move
+    currentOperator = Operator::ShiftMove;
+    // Initially assume that neigbour solution is feasible
+    setNeighbourFeasibility(true);
+    // Get timetable container
+    TimetableContainer &timetableCont = _sol.getTimetableContainer();
+    // Get # periods
+    int numPeriods = _sol.getNumPeriods();
+    // Select a random non-empty source time slot
+    int ti, tj;
+    selectRandomTimeslot(timetableCont, numPeriods, ti);
+    // Selected exam id (randomly) to move, and return its room
+    int exami, roomi;
+    selectRandomExam(timetableCont, _sol, ti, exami, roomi);
+    // Sample tj among the feasible improving periods. If there is none, select tj randomly
+    if (!periodScorer.selectPeriod(_sol, exami, ti, moveFilter.get(), *randomGenerator, tj)) {
+        do {
+            tj = randomGenerator->random(numPeriods);
+        }
+        while (tj == ti);
+    }
+    // Filter the move and initialise Kempe chain object
+    initialiseShiftMove(_sol, ti, exami, roomi, tj);
+
+#ifdef ETTP_KEMPE_CHAIN_HEURISTIC_DEBUG
+    std::cout << "In [ETTPKempeChainHeuristic<EOT>::guidedShiftMove()]:" << std::endl;
+    std::cout << "ti = " << ti << ", exami = " << exami << ", roomi = " << roomi << std::endl;
+    std::cout << "tj = " << tj << ", estimated delta = " << periodScorer.getDelta(tj) << std::endl;
+#endif
+}
+
+
+
+
+
+/**
+ * @brief initialiseShiftMove Filter the shift move of exam _exami from _ti to _tj
+ * and initialise the Kempe chain
+ * @param _sol
+ * @param _ti
+ * @param _exami
+ * @param _roomi
+ * @param _tj
+ */
+template <typename EOT>
+void ETTPKempeChainHeuristic<EOT>::initialiseShiftMove(EOT &_sol, int _ti, int _exami, int _roomi, int _tj) {
+    // Quick-reject moves which are surely infeasible, before building the Kempe chain
+    if (moveFilter.get() != nullptr) {
+        if (!moveFilter->isPeriodAllowed(_exami, _tj))
+            rejectMove(ETTPMoveFilter<EOT>::PeriodMask);
+        else if (!moveFilter->verifyPeriodRelatedPartners(_sol, _exami, _ti, _tj))
+            rejectMove(ETTPMoveFilter<EOT>::PeriodRelatedPartner);
+    }
+    // Initialise Kempe chain object
+    initialiseKempeChain(_sol, _ti, _exami, _roomi, _tj);
+}
+
+
+
+
+
 /**
  * @brief roomMove
  * @param _sol
@@ -1467,7 +1954,7 @@ void ETTPKempeChainHeuristic<EOT>::roomMove(EOT &_sol) {
     //
     // Set operator type
     currentOperator = Operator::RoomMove;
-    // This operator always produce a neigbour solution that is feasible
+    // Initially assume that neigbour solution is feasible
     setNeighbourFeasibility(true);
     // Get timetable container
     TimetableContainer &timetableCont = _sol.getTimetableContainer();
@@ -1481,6 +1968,9 @@ void ETTPKempeChainHeuristic<EOT>::roomMove(EOT &_sol) {
     // Selected exam id (randomly) to move, and return its room
     int exami, roomi;
     selectRandomExam(timetableCont, _sol, ti, exami, roomi);
+    // Quick-reject the move if no other room can host the exam
+    if (moveFilter.get() != nullptr && !moveFilter->hasAlternativeRoom(exami))
+        rejectMove(ETTPMoveFilter<EOT>::RoomCapacity);
      // Initialise Kempe chain object
     initialiseKempeChain(_sol, ti, exami, roomi, tj);
 #ifdef ETTP_KEMPE_CHAIN_HEURISTIC_DEBUG
@@ -0,0 +1,431 @@
+#ifndef ETTPMOVEFILTER_H
+#define ETTPMOVEFILTER_H
+
+#include "data/ITC2007Constraints.hpp"
+#include "utils/BinaryStream.h"
+#include <boost/shared_ptr.hpp>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+
+
+// For debugging purposes
+//#define ETTP_MOVE_FILTER_DEBUG
+
+
+//////////////////////////////////////////////////////////
+//
+// Quick-reject filters for Kempe chain moves.
+//
+// Many moves are only found to be infeasible after the Kempe chain is
+// built and the Period-Utilisation and Period-Related constraints of the
+// Ti and Tj exams are verified. The filters below are verified before
+// building the chain and only reject moves which the full verification
+// would also reject:
+//
+//   - Allowed periods: for each exam, a bitmask of the periods it may be
+//     assigned to, given its duration and the lower and upper period
+//     bounds implied by the chains of AFTER constraints it belongs to;
+//   - Period-Related partners: an exam cannot be moved to Tj if an AFTER
+//     or EXAM_COINCIDENCE partner, scheduled outside Ti and Tj (and so not
+//     moved by the chain), would be violated;
+//   - Room capacity: a room move needs at least one other room with
+//     enough seats for the exam.
+//
+// The filter also counts the rejected moves per reason, so that the
+// number of evaluations spent on infeasible neighbours can be reported.
+//
+
+
+/**
+ * @brief The ETTPMoveFilter class Quick-reject filters and rejection statistics
+ * of the Kempe chain moves. The filter is shared by the heuristic instances of a run
+ */
+template <typename EOT>
+class ETTPMoveFilter {
+
+public:
+    /**
+     * @brief The RejectionReason enum
+     */
+    enum RejectionReason {
+        PeriodMask = 0,         // Quick reject: Tj not allowed by duration or AFTER bounds
+        PeriodRelatedPartner,   // Quick reject: AFTER/EXAM_COINCIDENCE partner outside Ti and Tj
+        RoomCapacity,           // Quick reject: no other room has enough seats (room move)
+        NoFeasibleRoom,         // No feasible room found (room move)
+        PeriodUtilisation,      // Period-Utilisation violated after building the chain
+        PeriodRelated,          // Period-Related constraint violated after building the chain
+        NumRejectionReasons
+    };
+
+    /**
+     * @brief ETTPMoveFilter Constructor. Precompute the filter tables from the problem data
+     * @param _sol A solution of the problem
+     */
+    ETTPMoveFilter(EOT const &_sol);
+
+    /**
+     * @brief isPeriodAllowed
+     * @param _ei
+     * @param _tj
+     * @return true if exam _ei may be assigned to period _tj
+     */
+    inline bool isPeriodAllowed(int _ei, int _tj) const {
+        return allowedPeriods[_ei*numPeriods + _tj];
+    }
+
+    /**
+     * @brief verifyPeriodRelatedPartners Pre-condition: _ei is scheduled in _ti
+     * @param _sol
+     * @param _ei
+     * @param _ti
+     * @param _tj
+     * @return false if moving _ei from _ti to _tj surely violates an AFTER or EXAM_COINCIDENCE
+     * constraint with an exam not belonging to _ti or _tj
+     */
+    inline bool verifyPeriodRelatedPartners(EOT const &_sol, int _ei, int _ti, int _tj) const;
+
+    /**
+     * @brief hasAlternativeRoom
+     * @param _ei
+     * @return true if there are at least two rooms with enough seats for exam _ei
+     */
+    inline bool hasAlternativeRoom(int _ei) const {
+        return numRoomsWithCapacity[_ei] > 1;
+    }
+
+    /**
+     * @brief recordMove Count a built move
+     */
+    inline void recordMove() {
+        numMoves.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief recordRejection Count a move rejected for reason _reason
+     * @param _reason
+     */
+    inline void recordRejection(RejectionReason _reason) {
+        numRejections[_reason].fetch_add(1, std::memory_order_relaxed);
+#ifdef ETTP_MOVE_FILTER_DEBUG
+        std::cout << "In [ETTPMoveFilter::recordRejection]: " << getReasonName(_reason) << std::endl;
+#endif
+    }
+
+    /**
+     * @brief getNumMoves
+     * @return # built moves
+     */
+    inline long getNumMoves() const {
+        return numMoves;
+    }
+
+    /**
+     * @brief getNumRejections
+     * @param _reason
+     * @return # moves rejected for reason _reason
+     */
+    inline long getNumRejections(RejectionReason _reason) const {
+        return numRejections[_reason];
+    }
+
+    /**
+     * @brief getReasonName
+     * @param _reason
+     * @return The rejection reason name
+     */
+    static std::string getReasonName(RejectionReason _reason);
+
+    /**
+     * @brief print Print rejection statistics
+     * @param _os
+     */
+    void print(std::ostream &_os) const;
+
+    /**
+     * @brief saveState Save the rejection statistics into an evolution checkpoint
+     * @param _writer
+     */
+    void saveState(BinaryWriter &_writer) const;
+
+    /**
+     * @brief loadState Restore the rejection statistics from an evolution checkpoint
+     * @param _reader
+     */
+    void loadState(BinaryReader &_reader);
+
+protected:
+    /**
+     * @brief The PartnerRelation enum Relation of an exam with a Period-Related partner
+     */
+    enum PartnerRelation { After, Before, Coincident };
+
+    /**
+     * @brief computeAfterBounds Compute the earliest and latest period of each exam given the AFTER constraints
+     * @param _afterPairs (e1, e2) pairs where e1 must take place strictly after e2
+     * @param _numExams
+     * @param _earliest
+     * @param _latest
+     */
+    void computeAfterBounds(std::vector<std::pair<int, int> > const &_afterPairs, int _numExams,
+                            std::vector<int> &_earliest, std::vector<int> &_latest) const;
+
+    /**
+     * @brief numPeriods # periods
+     */
+    int numPeriods;
+    /**
+     * @brief allowedPeriods Exam x period bitmask. Position ei*numPeriods+tj is set if exam ei may be assigned to tj
+     */
+    std::vector<bool> allowedPeriods;
+    /**
+     * @brief periodRelatedPartners For each exam, its AFTER and EXAM_COINCIDENCE partners
+     */
+    std::vector<std::vector<std::pair<int, PartnerRelation> > > periodRelatedPartners;
+    /**
+     * @brief numRoomsWithCapacity For each exam, # rooms with enough seats for the exam
+     */
+    std::vector<int> numRoomsWithCapacity;
+    //
+    // The counters are atomic because the filter is shared by the heuristics
+    // of the speculative Threshold Accepting threads
+    //
+    /**
+     * @brief numMoves # built moves
+     */
+    std::atomic<long> numMoves;
+    /**
+     * @brief numRejections # rejected moves per reason
+     */
+    std::atomic<long> numRejections[NumRejectionReasons];
+};
+
+
+
+/**
+ * @brief ETTPMoveFilter Constructor. Precompute the filter tables from the problem data
+ * @param _sol A solution of the problem
+ */
+template <typename EOT>
+ETTPMoveFilter<EOT>::ETTPMoveFilter(EOT const &_sol)
+    : numPeriods(_sol.getNumPeriods()), numMoves(0) {
+    for (int reason = 0; reason < NumRejectionReasons; ++reason)
+        numRejections[reason] = 0;
+    // Get # exams
+    int numExams = _sol.getNumExams();
+    // Get exam, period and room vectors
+    auto const &examVector = _sol.getExamVector();
+    auto const &periodVector = _sol.getPeriodVector();
+    auto const &roomVector = _sol.getRoomVector();
+    // Get conflict matrix
+    auto const &conflictMatrix = _sol.getConflictMatrix();
+
+    //
+    // Period-Related partners
+    //
+    periodRelatedPartners.resize(numExams);
+    std::vector<std::pair<int, int> > afterPairs;
+    for (int ei = 0; ei < numExams; ++ei) {
+        for (auto const &ptrConstraint : examVector[ei]->getPeriodRelatedHardConstraints()) {
+            boost::shared_ptr<BinaryConstraint> ptrBinConstraint =
+                    boost::dynamic_pointer_cast<BinaryConstraint, Constraint>(ptrConstraint);
+            // Get the other exam
+            int e1 = ptrBinConstraint->getE1();
+            int e2 = ptrBinConstraint->getE2();
+            int other = (e1 == ei) ? e2 : e1;
+            if (boost::dynamic_pointer_cast<AfterConstraint, Constraint>(ptrConstraint).get() != nullptr) {
+                // e1 must take place strictly after e2
+                periodRelatedPartners[ei].push_back(std::make_pair(other, (e1 == ei) ? After : Before));
+                // Each constraint is registered in both exams. Keep one copy of the pair
+                if (e1 == ei)
+                    afterPairs.push_back(std::make_pair(e1, e2));
+            }
+            else if (boost::dynamic_pointer_cast<ExamCoincidenceConstraint, Constraint>(ptrConstraint).get() != nullptr) {
+                // The coincidence constraint is ignored if the exams clash with each other
+                if (conflictMatrix.getVal(e1, e2) == 0)
+                    periodRelatedPartners[ei].push_back(std::make_pair(other, Coincident));
+            }
+        }
+    }
+
+    //
+    // Allowed periods
+    //
+    std::vector<int> earliest, latest;
+    computeAfterBounds(afterPairs, numExams, earliest, latest);
+    allowedPeriods.assign(numExams*numPeriods, false);
+    for (int ei = 0; ei < numExams; ++ei) {
+        int examDuration = examVector[ei]->getDuration();
+        for (int tj = earliest[ei]; tj <= latest[ei]; ++tj) {
+            // Period-Utilisation
+            if (examDuration <= periodVector[tj]->getDuration())
+                allowedPeriods[ei*numPeriods + tj] = true;
+        }
+    }
+
+    //
+    // Rooms with capacity
+    //
+    numRoomsWithCapacity.assign(numExams, 0);
+    for (int ei = 0; ei < numExams; ++ei) {
+        int examNumStudents = examVector[ei]->getNumStudents();
+        for (auto const &ptrRoom : roomVector) {
+            if (examNumStudents <= ptrRoom->getCapacity())
+                ++numRoomsWithCapacity[ei];
+        }
+    }
+
+#ifdef ETTP_MOVE_FILTER_DEBUG
+    std::cout << "In [ETTPMoveFilter::ETTPMoveFilter]: # AFTER pairs = " << afterPairs.size() << std::endl;
+    for (int ei = 0; ei < numExams; ++ei) {
+        std::cout << "exam " << ei << ": periods [" << earliest[ei] << ", " << latest[ei] << "], "
+                  << "# partners = " << periodRelatedPartners[ei].size()
+                  << ", # rooms with capacity = " << numRoomsWithCapacity[ei] << std::endl;
+    }
+#endif
+}
+
+
+
+/**
+ * @brief computeAfterBounds Compute the earliest and latest period of each exam given the AFTER constraints
+ * @param _afterPairs (e1, e2) pairs where e1 must take place strictly after e2
+ * @param _numExams
+ * @param _earliest
+ * @param _latest
+ */
+template <typename EOT>
+void ETTPMoveFilter<EOT>::computeAfterBounds(std::vector<std::pair<int, int> > const &_afterPairs, int _numExams,
+                                             std::vector<int> &_earliest, std::vector<int> &_latest) const {
+    //
+    // If e1 must take place after e2, then earliest(e1) >= earliest(e2)+1 and
+    // latest(e2) <= latest(e1)-1. The bounds are the longest AFTER chains ending
+    // and starting in each exam. They are computed by relaxing all pairs until
+    // no bound changes. A chain is at most numPeriods long in a feasible problem,
+    // so at most numPeriods relaxation rounds are needed.
+    //
+    _earliest.assign(_numExams, 0);
+    _latest.assign(_numExams, numPeriods-1);
+    bool changed = true;
+    for (int round = 0; changed && round < numPeriods; ++round) {
+        changed = false;
+        for (auto const &afterPair : _afterPairs) {
+            int e1 = afterPair.first, e2 = afterPair.second;
+            if (_earliest[e1] < _earliest[e2]+1) {
+                _earliest[e1] = _earliest[e2]+1;
+                changed = true;
+            }
+            if (_latest[e2] > _latest[e1]-1) {
+                _latest[e2] = _latest[e1]-1;
+                changed = true;
+            }
+        }
+    }
+    // Clamp bounds to the period range
+    for (int ei = 0; ei < _numExams; ++ei) {
+        _earliest[ei] = std::min(_earliest[ei], numPeriods-1);
+        _latest[ei] = std::max(_latest[ei], 0);
+    }
+}
+
+
+
+/**
+ * @brief verifyPeriodRelatedPartners Pre-condition: _ei is scheduled in _ti
+ * @param _sol
+ * @param _ei
+ * @param _ti
+ * @param _tj
+ * @return false if moving _ei from _ti to _tj surely violates an AFTER or EXAM_COINCIDENCE
+ * constraint with an exam not belonging to _ti or _tj
+ */
+template <typename EOT>
+bool ETTPMoveFilter<EOT>::verifyPeriodRelatedPartners(EOT const &_sol, int _ei, int _ti, int _tj) const {
+    // Get scheduled exams vector
+    auto const &scheduledExamsVector = _sol.getScheduledExamsVector();
+    for (auto const &partner : periodRelatedPartners[_ei]) {
+        ScheduledExam const &other = scheduledExamsVector[partner.first];
+        // Partners in Ti and Tj may be moved by the Kempe chain. They're verified after the chain is built
+        if (!other.isScheduled() || other.getPeriod() == _ti || other.getPeriod() == _tj)
+            continue;
+        int tp = other.getPeriod();
+        if ((partner.second == After && _tj <= tp) ||
+            (partner.second == Before && _tj >= tp) ||
+            (partner.second == Coincident))
+            return false;
+    }
+    return true;
+}
+
+
+
+/**
+ * @brief getReasonName
+ * @param _reason
+ * @return The rejection reason name
+ */
+template <typename EOT>
+std::string ETTPMoveFilter<EOT>::getReasonName(RejectionReason _reason) {
+    switch (_reason) {
+        case PeriodMask: return "PeriodMask";
+        case PeriodRelatedPartner: return "PeriodRelatedPartner";
+        case RoomCapacity: return "RoomCapacity";
+        case NoFeasibleRoom: return "NoFeasibleRoom";
+        case PeriodUtilisation: return "PeriodUtilisation";
+        case PeriodRelated: return "PeriodRelated";
+        default: return "Unknown";
+    }
+}
+
+
+
+/**
+ * @brief print Print rejection statistics
+ * @param _os
+ */
+template <typename EOT>
+void ETTPMoveFilter<EOT>::print(std::ostream &_os) const {
+    long totalRejections = 0;
+    for (int reason = 0; reason < NumRejectionReasons; ++reason)
+        totalRejections += numRejections[reason];
+    _os << "# moves = " << numMoves << ", # rejected = " << totalRejections
+        << " (" << (numMoves > 0 ? 100.0*totalRejections/numMoves : 0) << "%)" << std::endl;
+    for (int reason = 0; reason < NumRejectionReasons; ++reason) {
+        _os << std::setw(22) << getReasonName(static_cast<RejectionReason>(reason))
+            << ": " << numRejections[reason]
+            << " (" << (numMoves > 0 ? 100.0*numRejections[reason]/numMoves : 0) << "%)"
+            << (reason < NoFeasibleRoom ? " [quick reject]" : "") << std::endl;
+    }
+}
+
+
+
+/**
+ * @brief saveState Save the rejection statistics into an evolution checkpoint
+ * @param _writer
+ */
+template <typename EOT>
+void ETTPMoveFilter<EOT>::saveState(BinaryWriter &_writer) const {
+    _writer.put<std::int64_t>(numMoves);
+    for (int reason = 0; reason < NumRejectionReasons; ++reason)
+        _writer.put<std::int64_t>(numRejections[reason]);
+}
+
+
+/**
+ * @brief loadState Restore the rejection statistics from an evolution checkpoint
+ * @param _reader
+ */
+template <typename EOT>
+void ETTPMoveFilter<EOT>::loadState(BinaryReader &_reader) {
+    numMoves = _reader.get<std::int64_t>();
+    for (int reason = 0; reason < NumRejectionReasons; ++reason)
+        numRejections[reason] = _reader.get<std::int64_t>();
+}
+
+
+
+#endif // ETTPMOVEFILTER_H
@@ -0,0 +1,469 @@
+#ifndef ETTPOPERATORSELECTOR_H
+#define ETTPOPERATORSELECTOR_H
+
+#include <utils/eoRNG.h>
+#include <boost/shared_ptr.hpp>
+#include "utils/BinaryStream.h"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <mutex>
+
+
+// For debugging purposes
+//#define ETTP_OPERATOR_SELECTOR_DEBUG
+
+
+//////////////////////////////////////////////////////////
+//
+// Adaptive operator selection for the Kempe chain heuristic.
+//
+// Each time the Kempe chain heuristic builds a neighbour it asks the
+// selector which operator to apply. After the neighbour is evaluated and
+// the acceptance criterion is applied, the outcome of the move is fed back
+// to the selector. The credit assigned to an operator is its improvement
+// per second of evaluation time, so that cheap operators that pay off are
+// applied more often.
+//
+// The selection rule is given by an OperatorSelectionPolicy object. The
+// following policies are available:
+//   - UniformOperatorSelection: operators are selected in equal proportions
+//   - AdaptivePursuitOperatorSelection: Adaptive Pursuit (Thierens 2005)
+//
+
+
+/**
+ * @brief The OperatorStatistics struct Per-operator statistics of a run
+ */
+struct OperatorStatistics {
+    OperatorStatistics()
+        : numApplications(0), numFeasible(0), numAccepted(0), numImprovements(0),
+          totalImprovement(0), totalTime(0) { }
+    /**
+     * @brief numApplications # neighbours built with the operator
+     */
+    long numApplications;
+    /**
+     * @brief numFeasible # feasible neighbours
+     */
+    long numFeasible;
+    /**
+     * @brief numAccepted # neighbours accepted by the local search
+     */
+    long numAccepted;
+    /**
+     * @brief numImprovements # accepted neighbours improving the solution
+     */
+    long numImprovements;
+    /**
+     * @brief totalImprovement Sum of the cost decrease of the improving moves
+     */
+    double totalImprovement;
+    /**
+     * @brief totalTime Time spent building and evaluating neighbours (in seconds)
+     */
+    double totalTime;
+};
+
+
+
+/**
+ * @brief The OperatorSelectionPolicy class Operator selection rule
+ */
+class OperatorSelectionPolicy {
+
+public:
+    virtual ~OperatorSelectionPolicy() { }
+
+    /**
+     * @brief init Initialise the policy
+     * @param _numOperators
+     */
+    virtual void init(int _numOperators) = 0;
+
+    /**
+     * @brief select Select an operator
+     * @param _rng Random generator of the calling Kempe chain heuristic
+     * @return The operator index
+     */
+    virtual int select(eoRng &_rng) = 0;
+
+    /**
+     * @brief update Credit operator _op with reward _reward
+     * @param _op
+     * @param _reward
+     */
+    virtual void update(int _op, double _reward) = 0;
+
+    /**
+     * @brief getProbability
+     * @param _op
+     * @return The current selection probability of operator _op
+     */
+    virtual double getProbability(int _op) const = 0;
+
+    /**
+     * @brief className
+     * @return The policy name
+     */
+    virtual std::string className() const = 0;
+
+    /**
+     * @brief saveState Save the learnt state into an evolution checkpoint
+     * @param _writer
+     */
+    virtual void saveState(BinaryWriter &_writer) const { }
+
+    /**
+     * @brief loadState Restore the learnt state from an evolution checkpoint
+     * @param _reader
+     */
+    virtual void loadState(BinaryReader &_reader) { }
+};
+
+
+
+/**
+ * @brief The UniformOperatorSelection class Select the operators in equal proportions
+ */
+class UniformOperatorSelection : public OperatorSelectionPolicy {
+
+public:
+    UniformOperatorSelection() : numOperators(0) { }
+
+    virtual void init(int _numOperators) override {
+        numOperators = _numOperators;
+    }
+
+    virtual int select(eoRng &_rng) override {
+        return _rng.random(numOperators);
+    }
+
+    virtual void update(int _op, double _reward) override { }
+
+    virtual double getProbability(int _op) const override {
+        return 1.0/numOperators;
+    }
+
+    virtual std::string className() const override {
+        return "Uniform";
+    }
+
+protected:
+    /**
+     * @brief numOperators # operators
+     */
+    int numOperators;
+};
+
+
+
+/**
+ * @brief The AdaptivePursuitOperatorSelection class
+ *
+ * Adaptive Pursuit (D. Thierens, An adaptive pursuit strategy for allocating
+ * operator probabilities, GECCO 2005). The operator quality estimates are
+ * updated with the received reward and the probability of the current best
+ * operator is pushed towards pMax, while the remaining ones are pushed
+ * towards pMin.
+ */
+class AdaptivePursuitOperatorSelection : public OperatorSelectionPolicy {
+
+public:
+    /**
+     * @brief AdaptivePursuitOperatorSelection Constructor
+     * @param _pMin Minimum selection probability
+     * @param _alpha Adaptation rate of the quality estimates
+     * @param _beta Learning rate of the selection probabilities
+     */
+    AdaptivePursuitOperatorSelection(double _pMin = 0.1, double _alpha = 0.1, double _beta = 0.1)
+        : pMin(_pMin), pMax(1-_pMin), alpha(_alpha), beta(_beta) { }
+
+    virtual void init(int _numOperators) override {
+        if (_numOperators*pMin > 1)
+            throw std::runtime_error("In [AdaptivePursuitOperatorSelection::init]: pMin is too large");
+        // pMax = 1 - (K-1)*pMin
+        pMax = 1 - (_numOperators-1)*pMin;
+        // All operators start with the same probability and quality
+        probabilities.assign(_numOperators, 1.0/_numOperators);
+        qualities.assign(_numOperators, 1.0);
+    }
+
+    virtual int select(eoRng &_rng) override {
+        // Roulette wheel selection
+        double r = _rng.uniform();
+        double sum = 0;
+        for (int op = 0; op < probabilities.size(); ++op) {
+            sum += probabilities[op];
+            if (r < sum)
+                return op;
+        }
+        return probabilities.size()-1;
+    }
+
+    virtual void update(int _op, double _reward) override {
+        // Update quality estimate of operator _op
+        qualities[_op] += alpha*(_reward - qualities[_op]);
+        // Determine the best operator
+        int best = 0;
+        for (int op = 1; op < qualities.size(); ++op) {
+            if (qualities[op] > qualities[best])
+                best = op;
+        }
+        // Pursue the best operator
+        for (int op = 0; op < probabilities.size(); ++op) {
+            if (op == best)
+                probabilities[op] += beta*(pMax - probabilities[op]);
+            else
+                probabilities[op] += beta*(pMin - probabilities[op]);
+        }
+    }
+
+    virtual double getProbability(int _op) const override {
+        return probabilities[_op];
+    }
+
+    virtual std::string className() const override {
+        return "AdaptivePursuit";
+    }
+
+    virtual void saveState(BinaryWriter &_writer) const override {
+        for (int op = 0; op < probabilities.size(); ++op) {
+            _writer.put<double>(probabilities[op]);
+            _writer.put<double>(qualities[op]);
+        }
+    }
+
+    virtual void loadState(BinaryReader &_reader) override {
+        for (int op = 0; op < probabilities.size(); ++op) {
+            probabilities[op] = _reader.get<double>();
+            qualities[op] = _reader.get<double>();
+        }
+    }
+
+protected:
+    /**
+     * @brief pMin Minimum selection probability
+     */
+    double pMin;
+    /**
+     * @brief pMax Maximum selection probability
+     */
+    double pMax;
+    /**
+     * @brief alpha Adaptation rate of the quality estimates
+     */
+    double alpha;
+    /**
+     * @brief beta Learning rate of the selection probabilities
+     */
+    double beta;
+    /**
+     * @brief probabilities Operator selection probabilities
+     */
+    std::vector<double> probabilities;
+    /**
+     * @brief qualities Operator quality estimates
+     */
+    std::vector<double> qualities;
+};
+
+
+
+/**
+ * @brief The ETTPOperatorSelector class Select Kempe chain operators and
+ * record per-operator statistics of the run
+ */
+class ETTPOperatorSelector {
+
+public:
+    /**
+     * @brief ETTPOperatorSelector Constructor
+     * @param _policy Operator selection policy
+     * @param _operatorNames Name of each operator. The operator index is the position in the vector
+     */
+    ETTPOperatorSelector(boost::shared_ptr<OperatorSelectionPolicy> const &_policy,
+                         std::vector<std::string> const &_operatorNames)
+        : policy(_policy), operatorNames(_operatorNames), statistics(_operatorNames.size()) {
+        policy->init(_operatorNames.size());
+    }
+
+    /**
+     * @brief selectOperator
+     * @param _rng Random generator of the calling Kempe chain heuristic. The speculative local
+     * search calls it from its worker threads, each one with its own generator, so the global
+     * rng is never drawn from those threads
+     * @return The index of the operator to apply
+     */
+    inline int selectOperator(eoRng &_rng) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return policy->select(_rng);
+    }
+
+    /**
+     * @brief recordMove Record the outcome of a move and credit the operator
+     * @param _op Operator index
+     * @param _feasible True if the neighbour is feasible
+     * @param _accepted True if the neighbour was accepted
+     * @param _improvement Cost decrease (positive if the neighbour is better than the solution)
+     * @param _elapsedTime Time spent building and evaluating the neighbour (in seconds)
+     */
+    inline void recordMove(int _op, bool _feasible, bool _accepted, double _improvement, double _elapsedTime);
+
+    /**
+     * @brief getNumOperators
+     * @return # operators
+     */
+    inline int getNumOperators() const {
+        return operatorNames.size();
+    }
+
+    /**
+     * @brief getStatistics
+     * @param _op
+     * @return Statistics of operator _op
+     */
+    inline OperatorStatistics const &getStatistics(int _op) const {
+        return statistics[_op];
+    }
+
+    /**
+     * @brief getPolicy
+     * @return The operator selection policy
+     */
+    inline OperatorSelectionPolicy const &getPolicy() const {
+        return *policy.get();
+    }
+
+    /**
+     * @brief print Print per-operator statistics
+     * @param _os
+     */
+    inline void print(std::ostream &_os) const;
+
+    /**
+     * @brief saveState Save the policy state and the statistics into an evolution checkpoint
+     * @param _writer
+     */
+    inline void saveState(BinaryWriter &_writer) const;
+
+    /**
+     * @brief loadState Restore the policy state and the statistics from an evolution checkpoint
+     * @param _reader
+     */
+    inline void loadState(BinaryReader &_reader);
+
+protected:
+    /**
+     * @brief policy Operator selection policy
+     */
+    boost::shared_ptr<OperatorSelectionPolicy> policy;
+    /**
+     * @brief operatorNames
+     */
+    std::vector<std::string> operatorNames;
+    /**
+     * @brief statistics Per-operator statistics
+     */
+    std::vector<OperatorStatistics> statistics;
+    /**
+     * @brief mutex Serialises selection and crediting, as the selector is shared
+     * by the heuristics of the speculative Threshold Accepting threads
+     */
+    std::mutex mutex;
+};
+
+
+
+/**
+ * @brief recordMove Record the outcome of a move and credit the operator
+ * @param _op Operator index
+ * @param _feasible True if the neighbour is feasible
+ * @param _accepted True if the neighbour was accepted
+ * @param _improvement Cost decrease (positive if the neighbour is better than the solution)
+ * @param _elapsedTime Time spent building and evaluating the neighbour (in seconds)
+ */
+void ETTPOperatorSelector::recordMove(int _op, bool _feasible, bool _accepted, double _improvement, double _elapsedTime) {
+    std::lock_guard<std::mutex> lock(mutex);
+    OperatorStatistics &stats = statistics[_op];
+    ++stats.numApplications;
+    stats.totalTime += _elapsedTime;
+    if (_feasible)
+        ++stats.numFeasible;
+    if (_accepted)
+        ++stats.numAccepted;
+    // Reward is the improvement per second of evaluation time
+    double reward = 0;
+    if (_accepted && _improvement > 0) {
+        ++stats.numImprovements;
+        stats.totalImprovement += _improvement;
+        if (_elapsedTime > 0)
+            reward = _improvement/_elapsedTime;
+    }
+    policy->update(_op, reward);
+
+#ifdef ETTP_OPERATOR_SELECTOR_DEBUG
+    std::cout << "In [ETTPOperatorSelector::recordMove]: op = " << operatorNames[_op]
+              << ", feasible = " << _feasible << ", accepted = " << _accepted
+              << ", improvement = " << _improvement << ", time = " << _elapsedTime
+              << ", reward = " << reward << std::endl;
+#endif
+}
+
+
+
+/**
+ * @brief print Print per-operator statistics
+ * @param _os
+ */
+void ETTPOperatorSelector::print(std::ostream &_os) const {
+    _os << "Operator selection policy: " << policy->className() << std::endl;
+    for (int op = 0; op < operatorNames.size(); ++op) {
+        OperatorStatistics const &stats = statistics[op];
+        _os << std::setw(10) << operatorNames[op]
+            << ": prob = " << policy->getProbability(op)
+            << ", # applications = " << stats.numApplications
+            << ", # feasible = " << stats.numFeasible
+            << ", # accepted = " << stats.numAccepted
+            << ", # improvements = " << stats.numImprovements
+            << ", total improvement = " << stats.totalImprovement
+            << ", time (s) = " << stats.totalTime
+            << ", improvement/s = " << (stats.totalTime > 0 ? stats.totalImprovement/stats.totalTime : 0)
+            << std::endl;
+    }
+}
+
+
+
+/**
+ * @brief saveState Save the policy state and the statistics into an evolution checkpoint
+ * @param _writer
+ */
+void ETTPOperatorSelector::saveState(BinaryWriter &_writer) const {
+    _writer.putString(policy->className());
+    _writer.put<std::int32_t>(operatorNames.size());
+    policy->saveState(_writer);
+    for (OperatorStatistics const &stats : statistics)
+        _writer.put(stats);
+}
+
+
+/**
+ * @brief loadState Restore the policy state and the statistics from an evolution checkpoint
+ * @param _reader
+ */
+void ETTPOperatorSelector::loadState(BinaryReader &_reader) {
+    if (_reader.getString() != policy->className())
+        throw std::runtime_error("In [ETTPOperatorSelector::loadState]: operator selection policy mismatch");
+    if (_reader.get<std::int32_t>() != (int)operatorNames.size())
+        throw std::runtime_error("In [ETTPOperatorSelector::loadState]: # operators mismatch");
+    policy->loadState(_reader);
+    for (OperatorStatistics &stats : statistics)
+        stats = _reader.get<OperatorStatistics>();
+}
+
+
+
+#endif // ETTPOPERATORSELECTOR_H
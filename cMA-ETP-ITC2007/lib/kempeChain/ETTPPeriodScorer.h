@@ -0,0 +1,355 @@
+#ifndef ETTPPERIODSCORER_H
+#define ETTPPERIODSCORER_H
+
+#include "kempeChain/ETTPMoveFilter.h"
+#include "containers/IntMatrix.h"
+#include <utils/eoRNG.h>
+#include "utils/Common.h"
+#include <vector>
+#include <algorithm>
+
+
+// For debugging purposes
+//#define ETTP_PERIOD_SCORER_DEBUG
+
+
+//////////////////////////////////////////////////////////
+//
+// Period scoring for the guided shift move.
+//
+// Instead of choosing the destination period tj of a shift move uniformly
+// at random, the cost delta of moving the selected exam to every period is
+// computed in a single sweep, and tj is sampled among the feasible periods
+// which improve the solution.
+//
+// The conflicts of the exam with the exams of each period are gathered
+// through the exam graph adjacency, in O(degree). Then, for every period,
+// the Two in a Row, Two in a Day and Period Spread costs are obtained from
+// prefix sums of the per-period conflicts over precomputed day and spread
+// windows, and the Period Penalty and Front Load costs are added. The sweep
+// is branch-free over plain int arrays so that it can be vectorised by the
+// compiler.
+//
+// The scores are those of getConflictInADayAndRowFromDay and
+// getConflictPeriodSpreadBeforeAndAfterPeriod for the exam alone. Room
+// related costs and the exams moved by the Kempe chain are not considered,
+// so the delta is an estimate. Periods where the exam clashes with other
+// exams are not candidates, because moving there would trigger a chain.
+//
+
+
+/**
+ * @brief The ETTPPeriodScorer class Score all periods as destination of a shift move
+ */
+template <typename EOT>
+class ETTPPeriodScorer {
+
+public:
+    /**
+     * @brief The Selection enum Rule for selecting among the improving periods
+     */
+    enum class Selection { Roulette, Tournament };
+
+    /**
+     * @brief ETTPPeriodScorer Constructor
+     * @param _selection Selection rule among the improving periods
+     * @param _tournamentSize Tournament size, used if _selection is Tournament
+     */
+    ETTPPeriodScorer(Selection _selection = Selection::Roulette, int _tournamentSize = 2)
+        : selection(_selection), tournamentSize(_tournamentSize), numPeriods(0) { }
+
+    /**
+     * @brief scorePeriods Compute the cost delta of moving exam _ei from period _ti to every period.
+     * Pre-condition: _ei is scheduled in _ti
+     * @param _sol
+     * @param _ei
+     * @param _ti
+     */
+    void scorePeriods(EOT &_sol, int _ei, int _ti);
+
+    /**
+     * @brief selectPeriod Select a destination period for exam _ei among the feasible improving periods
+     * @param _sol
+     * @param _ei
+     * @param _ti
+     * @param _moveFilter Quick-reject filter. If null, only Period-Utilisation is verified
+     * @param _rng Random number generator used in the selection
+     * @param _tj Selected period (out parameter)
+     * @return true if there is at least one feasible improving period
+     */
+    bool selectPeriod(EOT &_sol, int _ei, int _ti, ETTPMoveFilter<EOT> const *_moveFilter, eoRng &_rng, int &_tj);
+
+    /**
+     * @brief getDelta Pre-condition: scorePeriods was invoked
+     * @param _tj
+     * @return Estimated cost delta of moving the exam to period _tj
+     */
+    inline int getDelta(int _tj) const {
+        return deltas[_tj];
+    }
+
+    /**
+     * @brief hasConflicts Pre-condition: scorePeriods was invoked
+     * @param _tj
+     * @return true if the exam has students in common with exams scheduled in _tj
+     */
+    inline bool hasConflicts(int _tj) const {
+        return conflicts[_tj+1] > 0;
+    }
+
+protected:
+    /**
+     * @brief init Precompute the period windows and penalties
+     * @param _sol
+     */
+    void init(EOT &_sol);
+
+    /**
+     * @brief selection Selection rule among the improving periods
+     */
+    Selection selection;
+    /**
+     * @brief tournamentSize
+     */
+    int tournamentSize;
+    /**
+     * @brief numPeriods # periods
+     */
+    int numPeriods;
+    //
+    // Precomputed period data
+    //
+    /**
+     * @brief dayFirst, dayLast First and last period of the day of each period
+     */
+    std::vector<int> dayFirst, dayLast;
+    /**
+     * @brief spreadFirst, spreadLast First and last period of the period spread window of each period
+     */
+    std::vector<int> spreadFirst, spreadLast;
+    /**
+     * @brief hasPrevious, hasNext 1 if the previous (next) period is in the same day, and 0 otherwise
+     */
+    std::vector<int> hasPrevious, hasNext;
+    /**
+     * @brief periodPenalty Period penalty of each period
+     */
+    std::vector<int> periodPenalty;
+    /**
+     * @brief frontLoadPenalty Front load penalty of each period (0 except in the last periods)
+     */
+    std::vector<int> frontLoadPenalty;
+    /**
+     * @brief isLargeExam 1 if the exam is one of the largest exams (front load), and 0 otherwise
+     */
+    std::vector<int> isLargeExam;
+    /**
+     * @brief twoInARow, twoInADay Institutional model weightings
+     */
+    int twoInARow, twoInADay;
+    //
+    // Work buffers
+    //
+    /**
+     * @brief conflicts # students in common of the exam with each period, padded with a zero at both ends
+     */
+    std::vector<int> conflicts;
+    /**
+     * @brief prefix Prefix sums of the per-period conflicts
+     */
+    std::vector<int> prefix;
+    /**
+     * @brief scores Cost of the exam in each period
+     */
+    std::vector<int> scores;
+    /**
+     * @brief deltas Cost delta of moving the exam to each period
+     */
+    std::vector<int> deltas;
+    /**
+     * @brief candidates Feasible improving periods
+     */
+    std::vector<int> candidates;
+};
+
+
+
+/**
+ * @brief init Precompute the period windows and penalties
+ * @param _sol
+ */
+template <typename EOT>
+void ETTPPeriodScorer<EOT>::init(EOT &_sol) {
+    numPeriods = _sol.getNumPeriods();
+    auto const &periodVector = _sol.getPeriodVector();
+    InstitutionalModelWeightings const &modelWeightings =
+            _sol.getTimetableProblemData()->getInstitutionalModelWeightings();
+    twoInARow = modelWeightings.two_in_a_row;
+    twoInADay = modelWeightings.two_in_a_day;
+    int periodSpread = modelWeightings.period_spread;
+    // Periods are sorted by date, so the periods of a day are contiguous
+    dayFirst.resize(numPeriods);
+    dayLast.resize(numPeriods);
+    for (int p = 0; p < numPeriods; ) {
+        int q = p;
+        while (q+1 < numPeriods &&
+               periodVector[q+1]->getDate().getMonth() == periodVector[p]->getDate().getMonth() &&
+               periodVector[q+1]->getDate().getDay() == periodVector[p]->getDate().getDay())
+            ++q;
+        for (int r = p; r <= q; ++r) {
+            dayFirst[r] = p;
+            dayLast[r] = q;
+        }
+        p = q+1;
+    }
+    spreadFirst.resize(numPeriods);
+    spreadLast.resize(numPeriods);
+    hasPrevious.resize(numPeriods);
+    hasNext.resize(numPeriods);
+    periodPenalty.resize(numPeriods);
+    frontLoadPenalty.assign(numPeriods, 0);
+    for (int p = 0; p < numPeriods; ++p) {
+        spreadFirst[p] = std::max(0, p-periodSpread);
+        spreadLast[p] = std::min(numPeriods-1, p+periodSpread);
+        hasPrevious[p] = (p > dayFirst[p]) ? 1 : 0;
+        hasNext[p] = (p < dayLast[p]) ? 1 : 0;
+        periodPenalty[p] = periodVector[p]->getPenalty();
+        if (p >= numPeriods - modelWeightings.front_load[1])
+            frontLoadPenalty[p] = modelWeightings.front_load[2];
+    }
+    // Largest exams
+    auto const &sortedExamsCountsPairs = _sol.getSortedCourseClassSize();
+    isLargeExam.assign(_sol.getNumExams(), 0);
+    for (int i = 0; i < modelWeightings.front_load[0] && i < sortedExamsCountsPairs.size(); ++i)
+        isLargeExam[sortedExamsCountsPairs[i].first] = 1;
+    // Work buffers
+    conflicts.assign(numPeriods+2, 0);
+    prefix.assign(numPeriods+1, 0);
+    scores.assign(numPeriods, 0);
+    deltas.assign(numPeriods, 0);
+    candidates.reserve(numPeriods);
+}
+
+
+
+/**
+ * @brief scorePeriods Compute the cost delta of moving exam _ei from period _ti to every period.
+ * Pre-condition: _ei is scheduled in _ti
+ * @param _sol
+ * @param _ei
+ * @param _ti
+ */
+template <typename EOT>
+void ETTPPeriodScorer<EOT>::scorePeriods(EOT &_sol, int _ei, int _ti) {
+    if (numPeriods != _sol.getNumPeriods())
+        init(_sol);
+    // Get exam graph and conflict matrix
+    AdjacencyList const &examGraph = _sol.getExamGraph();
+    IntMatrix const &conflictMatrix = _sol.getConflictMatrix();
+    // Get scheduled exams vector
+    auto const &scheduledExamsVector = _sol.getScheduledExamsVector();
+
+    // Gather the conflicts of _ei with each period through the exam graph adjacency.
+    // conflicts[p+1] keeps the conflicts with period p.
+    std::fill(conflicts.begin(), conflicts.end(), 0);
+    boost::property_map<AdjacencyList, boost::vertex_index_t>::type index_map = get(boost::vertex_index, examGraph);
+    boost::graph_traits<AdjacencyList>::adjacency_iterator ai, a_end;
+    for (boost::tie(ai, a_end) = adjacent_vertices(_ei, examGraph); ai != a_end; ++ai) {
+        int ej = get(index_map, *ai);
+        ScheduledExam const &scheduledExam = scheduledExamsVector[ej];
+        if (scheduledExam.isScheduled())
+            conflicts[scheduledExam.getPeriod()+1] += conflictMatrix.getVal(_ei, ej);
+    }
+    // Prefix sums: prefix[p] = conflicts with periods 0..p-1
+    for (int p = 0; p < numPeriods; ++p)
+        prefix[p+1] = prefix[p] + conflicts[p+1];
+
+    // Score all periods in one branch-free sweep
+    int const *c = conflicts.data() + 1;
+    int const *s = prefix.data();
+    int const *dFirst = dayFirst.data(), *dLast = dayLast.data();
+    int const *sFirst = spreadFirst.data(), *sLast = spreadLast.data();
+    int const *prev = hasPrevious.data(), *next = hasNext.data();
+    int const *pPenalty = periodPenalty.data(), *fPenalty = frontLoadPenalty.data();
+    int *score = scores.data();
+    int large = isLargeExam[_ei];
+    for (int p = 0; p < numPeriods; ++p) {
+        int adjacent = prev[p]*c[p-1] + next[p]*c[p+1];
+        int sameDay = s[dLast[p]+1] - s[dFirst[p]] - c[p];
+        int spread = s[sLast[p]+1] - s[sFirst[p]] - c[p];
+        score[p] = twoInARow*adjacent + twoInADay*(sameDay - adjacent) + spread
+                 + pPenalty[p] + large*fPenalty[p];
+    }
+    int *delta = deltas.data();
+    int currentScore = scores[_ti];
+    for (int p = 0; p < numPeriods; ++p)
+        delta[p] = score[p] - currentScore;
+
+#ifdef ETTP_PERIOD_SCORER_DEBUG
+    std::cout << "In [ETTPPeriodScorer::scorePeriods]: ei = " << _ei << ", ti = " << _ti << std::endl;
+    for (int p = 0; p < numPeriods; ++p)
+        std::cout << "p = " << p << ", conflicts = " << c[p] << ", delta = " << deltas[p] << std::endl;
+#endif
+}
+
+
+
+/**
+ * @brief selectPeriod Select a destination period for exam _ei among the feasible improving periods
+ * @param _sol
+ * @param _ei
+ * @param _ti
+ * @param _moveFilter Quick-reject filter. If null, only Period-Utilisation is verified
+ * @param _rng Random number generator used in the selection
+ * @param _tj Selected period (out parameter)
+ * @return true if there is at least one feasible improving period
+ */
+template <typename EOT>
+bool ETTPPeriodScorer<EOT>::selectPeriod(EOT &_sol, int _ei, int _ti, ETTPMoveFilter<EOT> const *_moveFilter,
+                                         eoRng &_rng, int &_tj) {
+    scorePeriods(_sol, _ei, _ti);
+    // Determine the feasible improving periods
+    candidates.clear();
+    for (int p = 0; p < numPeriods; ++p) {
+        if (p == _ti || deltas[p] >= 0 || hasConflicts(p))
+            continue;
+        bool feasible = (_moveFilter != nullptr)
+                ? _moveFilter->isPeriodAllowed(_ei, p) && _moveFilter->verifyPeriodRelatedPartners(_sol, _ei, _ti, p)
+                : _sol.verifyPeriodUtilisationConstraint(_ei, p);
+        if (feasible)
+            candidates.push_back(p);
+    }
+    if (candidates.empty())
+        return false;
+
+    if (selection == Selection::Roulette) {
+        // Roulette wheel selection, proportional to the cost decrease
+        long total = 0;
+        for (int p : candidates)
+            total -= deltas[p];
+        double r = _rng.uniform()*total;
+        double sum = 0;
+        _tj = candidates.back();
+        for (int p : candidates) {
+            sum -= deltas[p];
+            if (r < sum) {
+                _tj = p;
+                break;
+            }
+        }
+    }
+    else {
+        // Tournament selection
+        _tj = candidates[_rng.random(candidates.size())];
+        for (int i = 1; i < tournamentSize; ++i) {
+            int p = candidates[_rng.random(candidates.size())];
+            if (deltas[p] < deltas[_tj])
+                _tj = p;
+        }
+    }
+    return true;
+}
+
+
+
+#endif // ETTPPERIODSCORER_H
@@ -85,6 +85,16 @@ public:
         return kempeChainHeuristic->isFeasibleNeighbour();
     }
 
+    /**
+     * @brief recordMoveOutcome Feed back the acceptance of this neighbour to the
+     * Kempe chain heuristic operator selector
+     * @param _accepted
+     * @param _solutionFitness
+     */
+    void recordMoveOutcome(bool _accepted, double _solutionFitness) {
+        kempeChainHeuristic->recordMoveOutcome(_accepted, _solutionFitness);
+    }
+
     /**
      * @brief evaluateMove Evaluate move of solution to the neighbour.
      * This envolves doing:
@@ -104,6 +114,26 @@ public:
         fitness(neighFitness);
     }
 
+    /**
+     * @brief reevaluateMove Evaluate this neighbour on solution _sol, reusing its Kempe chain.
+     * Pre-condition: the periods touched by the Kempe chain have the same contents in _sol
+     * as in the solution where the neighbour was built
+     * @param _sol
+     */
+    void reevaluateMove(EOT &_sol) {
+        kempeChainHeuristic->reevaluateSolutionMove(_sol);
+        fitness(kempeChainHeuristic->getNeighborFitness());
+    }
+
+    /**
+     * @brief rebuildMove Rebuild the Kempe chain of this neighbour on solution _sol and evaluate it
+     * @param _sol
+     */
+    void rebuildMove(EOT &_sol) {
+        kempeChainHeuristic->rebuildSolutionMove(_sol);
+        fitness(kempeChainHeuristic->getNeighborFitness());
+    }
+
 protected:
 
     /**
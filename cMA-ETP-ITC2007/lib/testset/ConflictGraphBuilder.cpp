@@ -0,0 +1,148 @@
+
+
+#include "testset/ConflictGraphBuilder.h"
+#include <algorithm>
+#include <thread>
+#include <cassert>
+#ifdef CONFLICTGRAPHBUILDER_DEBUG
+#include <iostream>
+#endif
+
+
+using namespace std;
+
+
+// Below this amount of work, counted in visited (student, exam) pairs, the graph is built sequentially
+static const long MIN_PARALLEL_WORK = 1L << 20;
+
+
+
+/**
+ * @brief ConflictGraphBuilder::ConflictGraphBuilder
+ * @param _numExams # exams
+ * @param _numThreads # threads. If _numThreads <= 0, the # hardware threads is used
+ */
+ConflictGraphBuilder::ConflictGraphBuilder(int _numExams, int _numThreads)
+    : numExams(_numExams), numThreads(_numThreads) {
+    if (numThreads <= 0)
+        numThreads = max(1, (int)std::thread::hardware_concurrency());
+}
+
+
+/**
+ * @brief ConflictGraphBuilder::build Build the conflict graph
+ * @param _studentMap List of exams of each student, in non-decreasing order
+ */
+void ConflictGraphBuilder::build(vector<vector<int> > const &_studentMap) {
+    //
+    // Invert the student -> exams map. Row work is estimated as the # exams
+    // visited by the sparse accumulator
+    //
+    examOffsets.assign(numExams+1, 0);
+    selfConflicts.assign(numExams, 0);
+    vector<long> rowWork(numExams, 0);
+    for (auto const &exams : _studentMap) {
+        assert(is_sorted(exams.begin(), exams.end()));
+        for (int i = 0; i < (int)exams.size(); ++i) {
+            ++examOffsets[exams[i]+1];
+            rowWork[exams[i]] += exams.size();
+            // Repeated exams conflict with themselves, as when incrementing
+            // both symmetric cells for every pair of exams of the student
+            if (i > 0 && exams[i] == exams[i-1])
+                selfConflicts[exams[i]] += 2 * (i - (lower_bound(exams.begin(), exams.begin()+i, exams[i]) - exams.begin()));
+        }
+    }
+    for (int e = 0; e < numExams; ++e)
+        examOffsets[e+1] += examOffsets[e];
+    examStudents.resize(examOffsets[numExams]);
+    vector<int> pos(examOffsets.begin(), examOffsets.end()-1);
+    for (int s = 0; s < (int)_studentMap.size(); ++s)
+        for (int exam : _studentMap[s])
+            examStudents[pos[exam]++] = s;
+
+    //
+    // Split the rows into contiguous blocks of similar work
+    //
+    long totalWork = 0;
+    for (long work : rowWork)
+        totalWork += work;
+    int numBlocks = (totalWork < MIN_PARALLEL_WORK) ? 1 : min(numThreads, max(1, numExams));
+    vector<int> blockStart(1, 0);
+    long accumWork = 0;
+    for (int e = 0; e < numExams && (int)blockStart.size() < numBlocks; ++e) {
+        accumWork += rowWork[e];
+        if (accumWork * numBlocks >= totalWork * (long)blockStart.size())
+            blockStart.push_back(e+1);
+    }
+    while ((int)blockStart.size() <= numBlocks)
+        blockStart.push_back(numExams);
+
+#ifdef CONFLICTGRAPHBUILDER_DEBUG
+    cout << "[ConflictGraphBuilder] total work = " << totalWork << ", # blocks = " << numBlocks << endl;
+#endif
+
+    //
+    // Build each block of rows, the first one in the calling thread
+    //
+    vector<vector<ConflictEdge> > blockEdges(numBlocks);
+    vector<std::thread> threads;
+    for (int b = 1; b < numBlocks; ++b)
+        threads.push_back(std::thread(&ConflictGraphBuilder::buildRows, this, blockStart[b], blockStart[b+1],
+                                      std::cref(_studentMap), std::ref(blockEdges[b])));
+    buildRows(blockStart[0], blockStart[1], _studentMap, blockEdges[0]);
+    for (auto &t : threads)
+        t.join();
+
+    // Concatenate blocks in row order
+    size_t numEdges = 0;
+    for (auto const &block : blockEdges)
+        numEdges += block.size();
+    edges.clear();
+    edges.reserve(numEdges);
+    for (auto const &block : blockEdges)
+        edges.insert(edges.end(), block.begin(), block.end());
+}
+
+
+/**
+ * @brief ConflictGraphBuilder::buildRows Build the rows [_firstRow, _lastRow) of the upper triangle
+ * @param _firstRow
+ * @param _lastRow
+ * @param _studentMap
+ * @param _rowEdges
+ */
+void ConflictGraphBuilder::buildRows(int _firstRow, int _lastRow, vector<vector<int> > const &_studentMap,
+                                     vector<ConflictEdge> &_rowEdges) const {
+    // Sparse accumulator
+    vector<int> counter(numExams, 0);
+    vector<int> touched;
+    for (int v1 = _firstRow; v1 < _lastRow; ++v1) {
+        for (int k = examOffsets[v1]; k < examOffsets[v1+1]; ++k) {
+            vector<int> const &exams = _studentMap[examStudents[k]];
+            // Exams after v1
+            for (auto it = upper_bound(exams.begin(), exams.end(), v1); it != exams.end(); ++it) {
+                if (counter[*it]++ == 0)
+                    touched.push_back(*it);
+            }
+        }
+        sort(touched.begin(), touched.end());
+        for (int v2 : touched) {
+            _rowEdges.push_back({ v1, v2, counter[v2] });
+            counter[v2] = 0;
+        }
+        touched.clear();
+    }
+}
+
+
+/**
+ * @brief ConflictGraphBuilder::getNumNonZeros
+ * @return # non-zero elements of the symmetric conflict matrix
+ */
+int ConflictGraphBuilder::getNumNonZeros() const {
+    int numNonZeros = 2 * edges.size();
+    for (int selfConflict : selfConflicts)
+        if (selfConflict != 0)
+            ++numNonZeros;
+    return numNonZeros;
+}
@@ -0,0 +1,86 @@
+#ifndef CONFLICTGRAPHBUILDER_H
+#define CONFLICTGRAPHBUILDER_H
+
+#include <vector>
+
+
+//#define CONFLICTGRAPHBUILDER_DEBUG
+
+
+/**
+ * @brief The ConflictEdge struct Weighted edge of the exam conflict graph, with _v1 < _v2
+ */
+struct ConflictEdge {
+    // Exams
+    int v1, v2;
+    // # students enrolled in both exams
+    int cost;
+};
+
+
+/**
+ * @brief The ConflictGraphBuilder class Builds the exam conflict graph from the student enrolments.
+ *
+ * The graph is built as a weighted edge list of the upper triangle of the conflict matrix,
+ * in row-major order, without materialising the E x E matrix. The exam -> students incidence
+ * is inverted once and each row v1 is computed with a sparse accumulator: for every student
+ * enrolled in v1, the counters of the student's exams after v1 are incremented, and the touched
+ * exams are emitted in increasing order. Rows are split into contiguous blocks of similar work
+ * and each block is computed by its own thread, so the blocks are concatenated in row order.
+ */
+class ConflictGraphBuilder {
+
+public:
+    /**
+     * @brief ConflictGraphBuilder
+     * @param _numExams # exams
+     * @param _numThreads # threads. If _numThreads <= 0, the # hardware threads is used
+     */
+    ConflictGraphBuilder(int _numExams, int _numThreads);
+
+    /**
+     * @brief build Build the conflict graph
+     * @param _studentMap List of exams of each student, in non-decreasing order
+     */
+    void build(std::vector<std::vector<int> > const &_studentMap);
+
+    /**
+     * @brief getEdges
+     * @return Edges (v1, v2, cost) with v1 < v2, sorted by v1 and then by v2
+     */
+    std::vector<ConflictEdge> const &getEdges() const { return edges; }
+
+    /**
+     * @brief getSelfConflicts
+     * @return Conflict matrix diagonal. It is only non-zero if a student is enrolled
+     * more than once in the same exam, each repeated pair counting twice
+     */
+    std::vector<int> const &getSelfConflicts() const { return selfConflicts; }
+
+    /**
+     * @brief getNumNonZeros
+     * @return # non-zero elements of the symmetric conflict matrix
+     */
+    int getNumNonZeros() const;
+
+private:
+    // Build the rows [_firstRow, _lastRow) of the upper triangle into _rowEdges
+    void buildRows(int _firstRow, int _lastRow, std::vector<std::vector<int> > const &_studentMap,
+                   std::vector<ConflictEdge> &_rowEdges) const;
+
+    // # exams
+    int numExams;
+    // # threads
+    int numThreads;
+    // Students of each exam, in CSR format: the students of exam e are in
+    // positions [examOffsets[e], examOffsets[e+1]) of examStudents
+    std::vector<int> examOffsets;
+    std::vector<int> examStudents;
+    // Upper triangle edges
+    std::vector<ConflictEdge> edges;
+    // Conflict matrix diagonal
+    std::vector<int> selfConflicts;
+};
+
+
+#endif // CONFLICTGRAPHBUILDER_H
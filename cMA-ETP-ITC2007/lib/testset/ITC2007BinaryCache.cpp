@@ -0,0 +1,326 @@
+
+
+#include "testset/ITC2007BinaryCache.h"
+#include "data/ITC2007Constraints.hpp"
+#include "utils/MappedFile.h"
+#include "utils/BinaryStream.h"
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+#include <boost/make_shared.hpp>
+
+
+using namespace std;
+
+
+namespace {
+
+// File signature
+const char MAGIC[8] = { 'I', 'T', 'C', '0', '7', 'B', 'I', 'N' };
+// Written in the native byte order, to detect caches with a different byte order
+const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// Hard constraint types
+enum ConstraintType { AFTER = 0, EXAM_COINCIDENCE = 1, EXCLUSION = 2, ROOM_EXCLUSIVE = 3 };
+
+// Cache header
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;
+    std::uint64_t sourceChecksum;
+    std::uint64_t payloadSize;
+};
+
+}
+
+
+
+/**
+ * @brief ITC2007BinaryCache::load Load the instance data from cache file _cacheFilename
+ * @param _cacheFilename
+ * @param _sourceChecksum Checksum of the source instance file
+ * @param _data Instance data. It is only modified if the cache is valid
+ * @return true if the cache exists, is valid and matches the source checksum
+ */
+bool ITC2007BinaryCache::load(std::string const &_cacheFilename, std::uint64_t _sourceChecksum,
+                              TimetableProblemData &_data) {
+    // The cache does not exist yet
+    if (access(_cacheFilename.c_str(), R_OK) != 0)
+        return false;
+    try {
+        MappedFile file(_cacheFilename);
+        BinaryReader reader(file.getData(), file.getData() + file.getSize());
+        // Check header
+        Header header = reader.get<Header>();
+        if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+                || header.byteOrderMark != BYTE_ORDER_MARK)
+            throw runtime_error("unsupported cache format");
+        if (header.sourceChecksum != _sourceChecksum)
+            throw runtime_error("instance file changed");
+        if (header.payloadSize != file.getSize() - sizeof(Header))
+            throw runtime_error("truncated cache");
+
+        // Sizes
+        int numExams = reader.getInt(0, INT32_MAX);
+        int numPeriods = reader.getInt(0, INT32_MAX);
+        int numRooms = reader.getInt(0, INT32_MAX);
+        int numStudents = reader.getInt(0, INT32_MAX);
+        int numEnrolments = reader.getInt(0, INT32_MAX);
+        double conflictMatrixDensity = reader.get<double>();
+        // Exams and class sizes
+        boost::shared_ptr<vector<int> > courseClassSize(new vector<int>(numExams));
+        boost::shared_ptr<vector<boost::shared_ptr<Exam> > > examVector(new vector<boost::shared_ptr<Exam> >());
+        examVector->reserve(numExams);
+        for (int ei = 0; ei < numExams; ++ei) {
+            int numExamStudents = reader.getInt(0, INT32_MAX);
+            int duration = reader.getInt(0, INT32_MAX);
+            (*courseClassSize.get())[ei] = numExamStudents;
+            examVector->push_back(boost::make_shared<Exam>(ei, numExamStudents, duration));
+        }
+        boost::shared_ptr<vector<pair<int,int> > > sortedCourseClassSize(new vector<pair<int,int> >(numExams));
+        for (auto &p : *sortedCourseClassSize.get()) {
+            p.first = reader.getInt(0, numExams-1);
+            p.second = reader.getInt(0, INT32_MAX);
+        }
+        // Conflict matrix and exam graph, from the upper triangle edges.
+        // Edges are stored in the order used by ITC2007TestSet::buildConflictGraph,
+        // so the adjacency lists are identical to the ones built from the instance file
+        boost::shared_ptr<IntMatrix> conflictMatrix(new IntMatrix(numExams, numExams));
+        boost::shared_ptr<AdjacencyList> examGraph(new AdjacencyList(numExams+1));
+        int numEdges = reader.getInt(0, INT32_MAX);
+        for (int i = 0; i < numEdges; ++i) {
+            int v1 = reader.getInt(0, numExams-1);
+            int v2 = reader.getInt(v1+1, numExams-1);
+            int cost = reader.getInt(1, INT32_MAX);
+            conflictMatrix->setVal(v1, v2, cost);
+            conflictMatrix->setVal(v2, v1, cost);
+            add_edge(v1, v2, *examGraph.get());
+        }
+        int numSelfConflicts = reader.getInt(0, numExams);
+        for (int i = 0; i < numSelfConflicts; ++i) {
+            int e = reader.getInt(0, numExams-1);
+            conflictMatrix->setVal(e, e, reader.getInt(1, INT32_MAX));
+        }
+        // Periods
+        boost::shared_ptr<vector<boost::shared_ptr<ITC2007Period> > > periodVector(
+                    new vector<boost::shared_ptr<ITC2007Period> >());
+        for (int pi = 0; pi < numPeriods; ++pi) {
+            int day = reader.get<std::int32_t>();
+            int month = reader.get<std::int32_t>();
+            int year = reader.get<std::int32_t>();
+            int hour = reader.get<std::int32_t>();
+            int minute = reader.get<std::int32_t>();
+            int second = reader.get<std::int32_t>();
+            int duration = reader.get<std::int32_t>();
+            int penalty = reader.get<std::int32_t>();
+            periodVector->push_back(boost::make_shared<ITC2007Period>(pi, Date(day, month, year),
+                                                                      Time(hour, minute, second), duration, penalty));
+        }
+        // Rooms
+        boost::shared_ptr<vector<boost::shared_ptr<Room> > > roomVector(new vector<boost::shared_ptr<Room> >());
+        for (int ri = 0; ri < numRooms; ++ri) {
+            int capacity = reader.get<std::int32_t>();
+            int penalty = reader.get<std::int32_t>();
+            roomVector->push_back(boost::make_shared<Room>(ri, capacity, penalty));
+        }
+        // Hard constraints, in the instance file order
+        vector<boost::shared_ptr<Constraint> > hardConstraints;
+        int numConstraints = reader.getInt(0, INT32_MAX);
+        for (int i = 0; i < numConstraints; ++i) {
+            int type = reader.getInt(AFTER, ROOM_EXCLUSIVE);
+            int e1 = reader.getInt(0, numExams-1);
+            int e2 = reader.getInt(0, numExams-1);
+            boost::shared_ptr<Constraint> hardConstr;
+            if (type == AFTER)
+                hardConstr = boost::make_shared<AfterConstraint>(e1, e2);
+            else if (type == EXAM_COINCIDENCE)
+                hardConstr = boost::make_shared<ExamCoincidenceConstraint>(e1, e2);
+            else if (type == EXCLUSION)
+                hardConstr = boost::make_shared<ExamExclusionConstraint>(e1, e2);
+            else
+                hardConstr = boost::make_shared<RoomExclusiveConstraint>(e1);
+            hardConstraints.push_back(hardConstr);
+            // Insert this hard constraint into each associated exam
+            if (type == ROOM_EXCLUSIVE)
+                (*examVector.get())[e1]->insertRoomRelatedHardConstraint(hardConstr);
+            else {
+                (*examVector.get())[e1]->insertPeriodRelatedHardConstraint(hardConstr);
+                (*examVector.get())[e2]->insertPeriodRelatedHardConstraint(hardConstr);
+            }
+        }
+        // Institutional weightings
+        InstitutionalModelWeightings model_weightings;
+        model_weightings.two_in_a_row = reader.get<std::int32_t>();
+        model_weightings.two_in_a_day = reader.get<std::int32_t>();
+        model_weightings.period_spread = reader.get<std::int32_t>();
+        model_weightings.non_mixed_durations = reader.get<std::int32_t>();
+        int frontLoadSize = reader.getInt(0, 3);
+        for (int i = 0; i < frontLoadSize; ++i)
+            model_weightings.front_load.push_back(reader.get<std::int32_t>());
+        if (!reader.atEnd())
+            throw runtime_error("unexpected data at the end of the cache");
+
+        //
+        // The cache is valid. Set TimetableProblemData fields
+        //
+        _data.setNumExams(numExams);
+        _data.setNumPeriods(numPeriods);
+        _data.setNumRooms(numRooms);
+        _data.setNumStudents(numStudents);
+        _data.setNumEnrolments(numEnrolments);
+        _data.setConflictMatrix(conflictMatrix, conflictMatrixDensity);
+        _data.setExamGraph(examGraph);
+        _data.setExamVector(examVector);
+        _data.setCourseClassSize(courseClassSize);
+        _data.setSortedCourseClassSize(sortedCourseClassSize);
+        _data.setPeriodVector(periodVector);
+        _data.setRoomVector(roomVector);
+        _data.setHardConstraints(hardConstraints);
+        _data.setInstitutionalModelWeightings(model_weightings);
+    }
+    catch (std::runtime_error const &e) {
+#ifdef ITC2007BINARYCACHE_DEBUG
+        cout << "Ignoring cache " << _cacheFilename << ": " << e.what() << endl;
+#endif
+        return false;
+    }
+#ifdef ITC2007BINARYCACHE_DEBUG
+    cout << "Loaded cache " << _cacheFilename << endl;
+#endif
+    return true;
+}
+
+
+
+/**
+ * @brief ITC2007BinaryCache::save Save the instance data into cache file _cacheFilename
+ * @param _cacheFilename
+ * @param _sourceChecksum Checksum of the source instance file
+ * @param _data Instance data
+ * @return true if the cache was written
+ */
+bool ITC2007BinaryCache::save(std::string const &_cacheFilename, std::uint64_t _sourceChecksum,
+                              TimetableProblemData const &_data) {
+    BinaryWriter writer;
+    int numExams = _data.getNumExams();
+    // Sizes
+    writer.put<std::int32_t>(numExams);
+    writer.put<std::int32_t>(_data.getNumPeriods());
+    writer.put<std::int32_t>(_data.getNumRooms());
+    writer.put<std::int32_t>(_data.getNumStudents());
+    writer.put<std::int32_t>(_data.getNumEnrolments());
+    writer.put<double>(_data.getConflictMatrixDensity());
+    // Exams and class sizes
+    for (auto const &exam : _data.getExamVector()) {
+        writer.put<std::int32_t>(exam->getNumStudents());
+        writer.put<std::int32_t>(exam->getDuration());
+    }
+    for (auto const &p : _data.getSortedCourseClassSize()) {
+        writer.put<std::int32_t>(p.first);
+        writer.put<std::int32_t>(p.second);
+    }
+    // Conflict matrix upper triangle edges, in row-major order. The exam graph
+    // adjacency lists are in increasing order, so the edges are read from them
+    IntMatrix const &conflictMatrix = _data.getConflictMatrix();
+    AdjacencyList const &examGraph = _data.getExamGraph();
+    vector<std::int32_t> edges;
+    for (int v1 = 0; v1 < numExams; ++v1) {
+        AdjacencyList::adjacency_iterator ai, a_end;
+        for (boost::tie(ai, a_end) = adjacent_vertices(v1, examGraph); ai != a_end; ++ai) {
+            int v2 = *ai;
+            if (v2 > v1) {
+                edges.push_back(v1);
+                edges.push_back(v2);
+                edges.push_back(conflictMatrix.getVal(v1, v2));
+            }
+        }
+    }
+    writer.put<std::int32_t>(edges.size() / 3);
+    for (std::int32_t value : edges)
+        writer.put<std::int32_t>(value);
+    // Conflict matrix diagonal, non-zero for students enrolled more than once in an exam
+    vector<std::int32_t> selfConflicts;
+    for (int e = 0; e < numExams; ++e) {
+        if (conflictMatrix.getVal(e, e) != 0) {
+            selfConflicts.push_back(e);
+            selfConflicts.push_back(conflictMatrix.getVal(e, e));
+        }
+    }
+    writer.put<std::int32_t>(selfConflicts.size() / 2);
+    for (std::int32_t value : selfConflicts)
+        writer.put<std::int32_t>(value);
+    // Periods
+    for (auto const &period : _data.getPeriodVector()) {
+        writer.put<std::int32_t>(period->getDate().getDay());
+        writer.put<std::int32_t>(period->getDate().getMonth());
+        writer.put<std::int32_t>(period->getDate().getYear());
+        writer.put<std::int32_t>(period->getTime().getHour());
+        writer.put<std::int32_t>(period->getTime().getMinutes());
+        writer.put<std::int32_t>(period->getTime().getSeconds());
+        writer.put<std::int32_t>(period->getDuration());
+        writer.put<std::int32_t>(period->getPenalty());
+    }
+    // Rooms
+    for (auto const &room : _data.getRoomVector()) {
+        writer.put<std::int32_t>(room->getCapacity());
+        writer.put<std::int32_t>(room->getPenalty());
+    }
+    // Hard constraints
+    auto const &hardConstraints = _data.getHardConstraints();
+    writer.put<std::int32_t>(hardConstraints.size());
+    for (auto const &constraint : hardConstraints) {
+        Constraint const *c = constraint.get();
+        if (auto after = dynamic_cast<AfterConstraint const *>(c)) {
+            writer.put<std::int32_t>(AFTER);
+            writer.put<std::int32_t>(after->getE1());
+            writer.put<std::int32_t>(after->getE2());
+        }
+        else if (auto coincidence = dynamic_cast<ExamCoincidenceConstraint const *>(c)) {
+            writer.put<std::int32_t>(EXAM_COINCIDENCE);
+            writer.put<std::int32_t>(coincidence->getE1());
+            writer.put<std::int32_t>(coincidence->getE2());
+        }
+        else if (auto exclusion = dynamic_cast<ExamExclusionConstraint const *>(c)) {
+            writer.put<std::int32_t>(EXCLUSION);
+            writer.put<std::int32_t>(exclusion->getE1());
+            writer.put<std::int32_t>(exclusion->getE2());
+        }
+        else if (auto exclusive = dynamic_cast<RoomExclusiveConstraint const *>(c)) {
+            writer.put<std::int32_t>(ROOM_EXCLUSIVE);
+            writer.put<std::int32_t>(exclusive->getE());
+            writer.put<std::int32_t>(exclusive->getE());
+        }
+        else // Unknown constraint type, it cannot be cached
+            return false;
+    }
+    // Institutional weightings
+    InstitutionalModelWeightings const &model_weightings = _data.getInstitutionalModelWeightings();
+    writer.put<std::int32_t>(model_weightings.two_in_a_row);
+    writer.put<std::int32_t>(model_weightings.two_in_a_day);
+    writer.put<std::int32_t>(model_weightings.period_spread);
+    writer.put<std::int32_t>(model_weightings.non_mixed_durations);
+    writer.put<std::int32_t>(model_weightings.front_load.size());
+    for (int value : model_weightings.front_load)
+        writer.put<std::int32_t>(value);
+
+    // Header
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.sourceChecksum = _sourceChecksum;
+    header.payloadSize = writer.getBuffer().size();
+
+    // Write a temporary file and rename it
+    BinaryWriter file;
+    file.put(header);
+    file.putBytes(writer.getBuffer().data(), writer.getBuffer().size());
+    if (!file.writeFile(_cacheFilename))
+        return false;
+#ifdef ITC2007BINARYCACHE_DEBUG
+    cout << "Saved cache " << _cacheFilename << endl;
+#endif
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef ITC2007BINARYCACHE_H
+#define ITC2007BINARYCACHE_H
+
+#include <string>
+#include <cstdint>
+#include "data/TimetableProblemData.hpp"
+
+
+//#define ITC2007BINARYCACHE_DEBUG
+
+
+/**
+ * @brief The ITC2007BinaryCache class Binary cache of a preprocessed ITC2007 instance.
+ *
+ * The cache keeps the fully preprocessed TimetableProblemData: exams, class sizes, the
+ * conflict graph as a list of weighted edges plus the conflict matrix diagonal, periods,
+ * rooms, hard constraints and institutional weightings. It is tagged with a format version and with the checksum
+ * of the source instance file, so a cache written by another version or for a modified
+ * instance is ignored. The cache is memory-mapped when loaded and the exam graph is
+ * rebuilt from the edge list, avoiding the conflict matrix construction from the
+ * student enrolments and the O(E^2) scans of the conflict matrix.
+ *
+ * Integers are stored in the native byte order, so the cache is not portable
+ * between architectures; a cache with another byte order is ignored.
+ */
+class ITC2007BinaryCache {
+
+public:
+    /**
+     * @brief VERSION Cache format version. It must be incremented whenever the format changes
+     */
+    static const std::uint32_t VERSION = 2;
+
+    /**
+     * @brief load Load the instance data from cache file _cacheFilename
+     * @param _cacheFilename
+     * @param _sourceChecksum Checksum of the source instance file
+     * @param _data Instance data. It is only modified if the cache is valid
+     * @return true if the cache exists, is valid and matches the source checksum
+     */
+    static bool load(std::string const &_cacheFilename, std::uint64_t _sourceChecksum, TimetableProblemData &_data);
+
+    /**
+     * @brief save Save the instance data into cache file _cacheFilename.
+     * The file is written to a temporary file and then renamed, so concurrent
+     * processes never read a partially written cache
+     * @param _cacheFilename
+     * @param _sourceChecksum Checksum of the source instance file
+     * @param _data Instance data
+     * @return true if the cache was written
+     */
+    static bool save(std::string const &_cacheFilename, std::uint64_t _sourceChecksum, TimetableProblemData const &_data);
+};
+
+
+#endif // ITC2007BINARYCACHE_H
@@ -0,0 +1,249 @@
+
+
+#include "testset/ITC2007Reader.h"
+#include <sstream>
+#include <climits>
+#include <cstring>
+
+
+
+/**
+ * @brief ITC2007ParseError::ITC2007ParseError
+ * @param _filename
+ * @param _line
+ * @param _column
+ * @param _message
+ */
+ITC2007ParseError::ITC2007ParseError(std::string const &_filename, int _line, int _column, std::string const &_message)
+    : std::runtime_error(_filename + ":" + std::to_string(_line) + ":" + std::to_string(_column) + ": " + _message),
+      filename(_filename), line(_line), column(_column), message(_message) { }
+
+
+
+
+/**
+ * @brief ITC2007Reader::ITC2007Reader Map file _filename in memory
+ * @param _filename
+ */
+ITC2007Reader::ITC2007Reader(std::string const &_filename)
+    : filename(_filename), cur(nullptr), end(nullptr), line(1), lineStart(nullptr) {
+    try {
+        file.reset(new MappedFile(_filename));
+    }
+    catch (std::runtime_error const &e) {
+        throw ITC2007ParseError(filename, 0, 0, e.what());
+    }
+    cur = lineStart = file->getData();
+    end = cur + file->getSize();
+}
+
+
+/**
+ * @brief ITC2007Reader::skipSpaces Skip spaces and tabs
+ */
+void ITC2007Reader::skipSpaces() {
+    while (cur != end && (*cur == ' ' || *cur == '\t'))
+        ++cur;
+}
+
+
+/**
+ * @brief ITC2007Reader::skipBlankLines Skip empty lines and lines with only spaces
+ */
+void ITC2007Reader::skipBlankLines() {
+    while (true) {
+        char const *p = cur;
+        while (p != end && (*p == ' ' || *p == '\t' || *p == '\r'))
+            ++p;
+        if (p == end) {
+            // Only blanks until the end of the file
+            cur = end;
+            return;
+        }
+        if (*p != '\n')
+            return;
+        // Go to the next line
+        cur = lineStart = p+1;
+        ++line;
+    }
+}
+
+
+/**
+ * @brief ITC2007Reader::atEnd
+ * @return true if there are no more non-blank lines
+ */
+bool ITC2007Reader::atEnd() {
+    skipBlankLines();
+    return cur == end;
+}
+
+
+/**
+ * @brief ITC2007Reader::atSectionHeader
+ * @return true if the next non-blank line is a section header, starting with '['
+ */
+bool ITC2007Reader::atSectionHeader() {
+    skipBlankLines();
+    skipSpaces();
+    return cur != end && *cur == '[';
+}
+
+
+/**
+ * @brief ITC2007Reader::readSectionHeader Read a "[_name:<n>]" line
+ * @param _name
+ * @return The number <n>
+ */
+int ITC2007Reader::readSectionHeader(char const *_name) {
+    skipBlankLines();
+    skipSpaces();
+    expect('[');
+    std::size_t len = strlen(_name);
+    if ((std::size_t)(end - cur) < len || strncmp(cur, _name, len) != 0)
+        error(std::string("expected section [") + _name + ":<n>], found " + describeCurrent());
+    cur += len;
+    expect(':');
+    int n = readInt();
+    expect(']');
+    endLine();
+    return n;
+}
+
+
+/**
+ * @brief ITC2007Reader::readSectionTag Read a "[_name]" line
+ * @param _name
+ */
+void ITC2007Reader::readSectionTag(char const *_name) {
+    skipBlankLines();
+    skipSpaces();
+    expect('[');
+    std::size_t len = strlen(_name);
+    if ((std::size_t)(end - cur) < len || strncmp(cur, _name, len) != 0)
+        error(std::string("expected section [") + _name + "], found " + describeCurrent());
+    cur += len;
+    expect(']');
+    endLine();
+}
+
+
+/**
+ * @brief ITC2007Reader::readInt Read a non-negative integer
+ * @return
+ */
+int ITC2007Reader::readInt() {
+    skipSpaces();
+    if (cur == end || *cur < '0' || *cur > '9')
+        error("expected a number, found " + describeCurrent());
+    int column = getColumn();
+    long value = 0;
+    while (cur != end && *cur >= '0' && *cur <= '9') {
+        value = value*10 + (*cur - '0');
+        if (value > INT_MAX)
+            error(column, "number out of range");
+        ++cur;
+    }
+    return (int)value;
+}
+
+
+/**
+ * @brief ITC2007Reader::readWord Read a word made of upper case letters and '_'
+ * @return
+ */
+std::string ITC2007Reader::readWord() {
+    skipSpaces();
+    char const *begin = cur;
+    while (cur != end && ((*cur >= 'A' && *cur <= 'Z') || *cur == '_'))
+        ++cur;
+    if (cur == begin)
+        error("expected a keyword, found " + describeCurrent());
+    return std::string(begin, cur);
+}
+
+
+/**
+ * @brief ITC2007Reader::expect Read character _c
+ * @param _c
+ */
+void ITC2007Reader::expect(char _c) {
+    skipSpaces();
+    if (cur == end || *cur != _c)
+        error(std::string("expected '") + _c + "', found " + describeCurrent());
+    ++cur;
+}
+
+
+/**
+ * @brief ITC2007Reader::readComma Read a comma if it is the next character
+ * @return true if a comma was read
+ */
+bool ITC2007Reader::readComma() {
+    skipSpaces();
+    if (cur != end && *cur == ',') {
+        ++cur;
+        return true;
+    }
+    return false;
+}
+
+
+/**
+ * @brief ITC2007Reader::atEndOfLine
+ * @return true if the rest of the line is blank
+ */
+bool ITC2007Reader::atEndOfLine() {
+    skipSpaces();
+    return cur == end || *cur == '\n' || (*cur == '\r' && (cur+1 == end || cur[1] == '\n'));
+}
+
+
+/**
+ * @brief ITC2007Reader::endLine Read the end of the line
+ */
+void ITC2007Reader::endLine() {
+    if (!atEndOfLine())
+        error("expected end of line, found " + describeCurrent());
+    if (cur != end && *cur == '\r')
+        ++cur;
+    if (cur != end) {
+        // Skip '\n'
+        lineStart = ++cur;
+        ++line;
+    }
+}
+
+
+/**
+ * @brief ITC2007Reader::error Throw an ITC2007ParseError at the current position
+ * @param _message
+ */
+void ITC2007Reader::error(std::string const &_message) const {
+    error(getColumn(), _message);
+}
+
+
+/**
+ * @brief ITC2007Reader::error Throw an ITC2007ParseError at column _column of the current line
+ * @param _column
+ * @param _message
+ */
+void ITC2007Reader::error(int _column, std::string const &_message) const {
+    throw ITC2007ParseError(filename, line, _column, _message);
+}
+
+
+/**
+ * @brief ITC2007Reader::describeCurrent Describe the character at the current position
+ * @return
+ */
+std::string ITC2007Reader::describeCurrent() const {
+    if (cur == end)
+        return "end of file";
+    if (*cur == '\r' || *cur == '\n')
+        return "end of line";
+    std::ostringstream sstream;
+    sstream << "'" << *cur << "'";
+    return sstream.str();
+}
@@ -0,0 +1,157 @@
+#ifndef ITC2007READER_H
+#define ITC2007READER_H
+
+#include <string>
+#include <stdexcept>
+#include <memory>
+#include <cstddef>
+#include "utils/MappedFile.h"
+
+
+/**
+ * @brief The ITC2007ParseError class Error found while reading an ITC2007 instance file.
+ * The line and column (starting at 1) locate the unexpected input
+ */
+class ITC2007ParseError : public std::runtime_error {
+
+public:
+    /**
+     * @brief ITC2007ParseError
+     * @param _filename
+     * @param _line
+     * @param _column
+     * @param _message
+     */
+    ITC2007ParseError(std::string const &_filename, int _line, int _column, std::string const &_message);
+
+    // Get file name
+    std::string const &getFilename() const { return filename; }
+    // Get line
+    int getLine() const { return line; }
+    // Get column
+    int getColumn() const { return column; }
+    // Get message
+    std::string const &getMessage() const { return message; }
+
+private:
+    std::string filename;
+    int line;
+    int column;
+    std::string message;
+};
+
+
+
+/**
+ * @brief The ITC2007Reader class Single-pass reader of an ITC2007 instance file.
+ *
+ * The file is memory-mapped and read in place, keeping track of the current
+ * line and column. Lines may end with "\r\n" or "\n". Spaces and tabs between
+ * fields are skipped. Any unexpected input throws an ITC2007ParseError.
+ */
+class ITC2007Reader {
+
+public:
+    /**
+     * @brief ITC2007Reader Map file _filename in memory
+     * @param _filename
+     */
+    explicit ITC2007Reader(std::string const &_filename);
+    /**
+     * @brief skipBlankLines Skip empty lines and lines with only spaces
+     */
+    void skipBlankLines();
+    /**
+     * @brief atEnd
+     * @return true if there are no more non-blank lines
+     */
+    bool atEnd();
+    /**
+     * @brief atSectionHeader
+     * @return true if the next non-blank line is a section header, starting with '['
+     */
+    bool atSectionHeader();
+    /**
+     * @brief readSectionHeader Read a "[_name:<n>]" line
+     * @param _name
+     * @return The number <n>
+     */
+    int readSectionHeader(char const *_name);
+    /**
+     * @brief readSectionTag Read a "[_name]" line
+     * @param _name
+     */
+    void readSectionTag(char const *_name);
+    /**
+     * @brief readInt Read a non-negative integer
+     * @return
+     */
+    int readInt();
+    /**
+     * @brief readWord Read a word made of upper case letters and '_'
+     * @return
+     */
+    std::string readWord();
+    /**
+     * @brief expect Read character _c
+     * @param _c
+     */
+    void expect(char _c);
+    /**
+     * @brief readComma Read a comma if it is the next character
+     * @return true if a comma was read
+     */
+    bool readComma();
+    /**
+     * @brief atEndOfLine
+     * @return true if the rest of the line is blank
+     */
+    bool atEndOfLine();
+    /**
+     * @brief endLine Read the end of the line
+     */
+    void endLine();
+    /**
+     * @brief error Throw an ITC2007ParseError at the current position
+     * @param _message
+     */
+    [[noreturn]] void error(std::string const &_message) const;
+    /**
+     * @brief error Throw an ITC2007ParseError at column _column of the current line
+     * @param _column
+     * @param _message
+     */
+    [[noreturn]] void error(int _column, std::string const &_message) const;
+    /**
+     * @brief skipSpaces Skip spaces and tabs
+     */
+    void skipSpaces();
+
+    // Get current line
+    int getLine() const { return line; }
+    // Get current column
+    int getColumn() const { return (int)(cur - lineStart) + 1; }
+    // Get checksum of the file contents
+    std::uint64_t getChecksum() const { return file->getChecksum(); }
+
+private:
+    // Non-copyable
+    ITC2007Reader(ITC2007Reader const &);
+    ITC2007Reader &operator=(ITC2007Reader const &);
+
+    // Describe the character at the current position, for error messages
+    std::string describeCurrent() const;
+
+    std::string filename;
+    // Mapped file
+    std::unique_ptr<MappedFile> file;
+    // Current position and end of the buffer
+    char const *cur;
+    char const *end;
+    // Current line and its first character
+    int line;
+    char const *lineStart;
+};
+
+
+#endif // ITC2007READER_H
@@ -1,7 +1,8 @@
 #include "ITC2007TestSet.h"
-#include <boost/regex.hpp>
-#include <boost/unordered_map.hpp>
+#include <climits>
+#include <algorithm>
 #include "utils/DateTime.h"
+#include "testset/ConflictGraphBuilder.h"
 
 
 //#define ITC2007TESTSET_DEBUG
@@ -79,19 +80,27 @@ void ITC2007TestSet::load() {
     //In addition, it is recomended that competitors should ignore unknown lines in the provided format.
 
     std::string filename = this->getRootDirectory() + "/" + this->getName();
-    std::string wholeFile = read_from_file(filename.c_str());
-    // Get line tokenizer
-    tokenizer<escaped_list_separator<char> > tok(wholeFile, escaped_list_separator<char>('\\', '\r')); // Lines terminate with \r\n
-    // Get line iterator
-    tokenizer<escaped_list_separator<char> >::iterator it = tok.begin();
+    // Map the file in memory and read it in a single pass. Unexpected input
+    // throws an ITC2007ParseError with the line and column where it was found
+    ITC2007Reader reader(filename);
+    // Load the preprocessed instance from the binary cache, if it is up to date
+    std::uint64_t checksum = 0;
+    if (useBinaryCache) {
+        checksum = reader.getChecksum();
+        if (ITC2007BinaryCache::load(getCacheFilename(), checksum, *timetableProblemData.get()))
+            return;
+    }
     // Read exams and students
-    readExams(it, tok);
+    readExams(reader);
     // Read periods
-    readPeriods(it, tok);
+    readPeriods(reader);
     // Read rooms
-    readRooms(it, tok);
+    readRooms(reader);
     // Read constraints and weightings
-    readConstraints(it, tok);
+    readConstraints(reader);
+    // Save the preprocessed instance. If the directory is not writable, the cache is not used
+    if (useBinaryCache)
+        ITC2007BinaryCache::save(getCacheFilename(), checksum, *timetableProblemData.get());
 }
 
 
@@ -101,11 +110,9 @@ void ITC2007TestSet::load() {
 
 ////
 /// \brief ITC2007TestSet::readExams
-/// \param it
-/// \param tok
+/// \param _reader
 ///
-void ITC2007TestSet::readExams(tokenizer<escaped_list_separator<char> >::iterator& it,
-                               tokenizer<escaped_list_separator<char> > const& tok) {
+void ITC2007TestSet::readExams(ITC2007Reader &_reader) {
     //
     // The problem instance files have the following format;
     // Number of Exams:
@@ -116,99 +123,79 @@ void ITC2007TestSet::readExams(tokenizer<escaped_list_separator<char> >::iterato
     // The line ends with a return character and line feed and is comma separated.
     ////
 
-    // Number of exams
-    int numExams = 0;
-    if (it != tok.end()) {
-        // Read number of exams
-        std::string s(*it);
-        boost::cmatch matches;
-        boost::regex re("(\\[Exams:)(\\d+)(\\])");
-        // If there's a match
-        if (boost::regex_match(s.c_str(), matches, re)) {
-             // Extract digits from std::string. The digits are the third subexpression, index = 2.
-            std::string match(matches[2].first, matches[2].second);
-            numExams = atoi(match.c_str());
+    // Read number of exams
+    int numExams = _reader.readSectionHeader("Exams");
 #ifdef ITC2007TESTSET_DEBUG
-            cout << "\tnumExams: " << numExams << endl;
+    cout << "\tnumExams: " << numExams << endl;
 #endif
-            // Set number of exams
-            timetableProblemData->setNumExams(numExams);
-            //////////////////////////////////////////
-            //
-            // Build Student map, Conflict matrix, and exam graph
-            //
-            //////////////////////////////////////////
-            //
-            // Define student map containing the list of exams for each student
-            //
-            boost::unordered_map<int, std::vector<int> > studentMap;
-            // Build Student map
-            buildStudentMap(it, tok, studentMap);
-            // Build Conflict matrix,
-            buildConflictMatrix(studentMap);
-            // Build exam graph representing exam relations
-            buildExamGraph(timetableProblemData.get()->getConflictMatrix());
+    // Set number of exams
+    timetableProblemData->setNumExams(numExams);
+    //////////////////////////////////////////
+    //
+    // Build Student map, Conflict matrix, and exam graph
+    //
+    //////////////////////////////////////////
+    //
+    // Define student map containing the list of exams for each student,
+    // indexed by the student number
+    //
+    std::vector<std::vector<int> > studentMap;
+    // Build Student map
+    buildStudentMap(_reader, studentMap);
+    // Build Conflict matrix and exam graph representing exam relations
+    buildConflictGraph(studentMap);
 
 #ifdef ITC2007TESTSET_DEBUG
-            //////////////////////////////////////////////////////////////////////////
-            //
-            // Verification of conflict matrix and exam graph integrity
-            //
-            //////////////////////////////////////////////////////////////////////////
-            IntMatrix const& conflictMatrix = timetableProblemData.get()->getConflictMatrix();
-            cout << "nlines = " << conflictMatrix.getNumLines() << endl;
-            cout << "ncols = " << conflictMatrix.getNumCols() << endl;
-            // Count the number of non-zero elements
-            int nonZeroElements = 0;
-            // Verify if it's symmetric
-            for (int i = 0; i < conflictMatrix.getNumLines(); ++i) {
-                for (int j = 0; j < conflictMatrix.getNumCols(); ++j) {
-                    if (conflictMatrix.getVal(i,j) != 0)
-                        ++nonZeroElements;
-
-                    if (conflictMatrix.getVal(i, j) != conflictMatrix.getVal(j, i))
-                        throw runtime_error("Not symmetric");
-                }
-            }
-            // Print the conflict matrix density
-            double conflictDensity = timetableProblemData.get()->getConflictMatrixDensity();
-            cout << "conflictDensity = " << conflictDensity << endl;
-            cout << "conflictDensity [%] = " << setprecision(3) << (conflictDensity * 100) << endl;
-
-            // Verification of exam graph integrity.
-            // # conflicts between exams. Should be equal to the number of non-zero elements in the conflict matrix
-            int countNumConflicts = 0;
-            // Get exam graph
-            AdjacencyList const& examGraph = timetableProblemData.get()->getExamGraph();
-            property_map<AdjacencyList, vertex_index_t>::type index_map = get(vertex_index, examGraph);
-            graph_traits<AdjacencyList>::adjacency_iterator ai, a_end;
-            // Iterate over all exams and check if the number of edges in the exam graph
-            // correspond to the edeges in the conflict matrix
-            for (int ei = 0; ei < numExams; ++ei) {
-                // Get ei adjacent exams
-                boost::tie(ai, a_end) = adjacent_vertices(ei, examGraph);
-                for (; ai != a_end; ++ai) {
-                    // Get adjacent exam
-                    int ej = get(index_map, *ai);
-                    // Verify if there's a conflict between ei and ej
-                    if (conflictMatrix.getVal(ei, ej) > 0)
-                        ++countNumConflicts;
-                }
-            }
-            cout << "nonZeroElements = " << nonZeroElements << ", countNumConflicts = " << countNumConflicts << endl;
-            if (nonZeroElements != countNumConflicts)
-                throw runtime_error("Error in exam graph integrity");
-#endif
-
+    //////////////////////////////////////////////////////////////////////////
+    //
+    // Verification of conflict matrix and exam graph integrity
+    //
+    //////////////////////////////////////////////////////////////////////////
+    IntMatrix const& conflictMatrix = timetableProblemData.get()->getConflictMatrix();
+    cout << "nlines = " << conflictMatrix.getNumLines() << endl;
+    cout << "ncols = " << conflictMatrix.getNumCols() << endl;
+    // Count the number of non-zero elements
+    int nonZeroElements = 0;
+    // Verify if it's symmetric
+    for (int i = 0; i < conflictMatrix.getNumLines(); ++i) {
+        for (int j = 0; j < conflictMatrix.getNumCols(); ++j) {
+            if (conflictMatrix.getVal(i,j) != 0)
+                ++nonZeroElements;
+
+            if (conflictMatrix.getVal(i, j) != conflictMatrix.getVal(j, i))
+                throw runtime_error("Not symmetric");
         }
-        else
-        {
-            cout << "[readExams] Error parsing input file. The regexp \"" << re << "\" does not match \"" << s << "\"" << endl;
-            cin.get();
+    }
+    // Print the conflict matrix density
+    double conflictDensity = timetableProblemData.get()->getConflictMatrixDensity();
+    cout << "conflictDensity = " << conflictDensity << endl;
+    cout << "conflictDensity [%] = " << setprecision(3) << (conflictDensity * 100) << endl;
+
+    // Verification of exam graph integrity.
+    // # conflicts between exams. Should be equal to the number of non-zero elements in the conflict matrix
+    int countNumConflicts = 0;
+    // Get exam graph
+    AdjacencyList const& examGraph = timetableProblemData.get()->getExamGraph();
+    property_map<AdjacencyList, vertex_index_t>::type index_map = get(vertex_index, examGraph);
+    graph_traits<AdjacencyList>::adjacency_iterator ai, a_end;
+    // Iterate over all exams and check if the number of edges in the exam graph
+    // correspond to the edeges in the conflict matrix
+    for (int ei = 0; ei < numExams; ++ei) {
+        // Get ei adjacent exams
+        boost::tie(ai, a_end) = adjacent_vertices(ei, examGraph);
+        for (; ai != a_end; ++ai) {
+            // Get adjacent exam
+            int ej = get(index_map, *ai);
+            // Verify if there's a conflict between ei and ej
+            if (conflictMatrix.getVal(ei, ej) > 0)
+                ++countNumConflicts;
         }
     }
-    else
-        throw runtime_error("Error while reading ITC07 exams");
+    cout << "nonZeroElements = " << nonZeroElements << ", countNumConflicts = " << countNumConflicts << endl;
+    if (nonZeroElements != countNumConflicts)
+        throw runtime_error("Error in exam graph integrity");
+#endif
+
 }
 
 
@@ -216,13 +203,11 @@ void ITC2007TestSet::readExams(tokenizer<escaped_list_separator<char> >::iterato
 
 
 ////
-/// \brief ITC2007TestSet::buildConflictMatrix
-/// \param it
-/// \param tok
+/// \brief ITC2007TestSet::buildStudentMap
+/// \param _reader
+/// \param _studentMap
 ///
-void ITC2007TestSet::buildStudentMap(boost::tokenizer<boost::escaped_list_separator<char> >::iterator &_it,
-                                     const boost::tokenizer<boost::escaped_list_separator<char> > &_tok,
-                                     boost::unordered_map<int, vector<int> > & _studentMap) {
+void ITC2007TestSet::buildStudentMap(ITC2007Reader &_reader, std::vector<std::vector<int> > &_studentMap) {
 
     int numExams = timetableProblemData->getNumExams();
     // Vector for keeping course total students. Exams indexed from [0..numExams-1].
@@ -231,59 +216,36 @@ void ITC2007TestSet::buildStudentMap(boost::tokenizer<boost::escaped_list_separa
     boost::shared_ptr<vector<pair<int,int> > > sortedCourseClassSize(new vector<pair<int,int> >(numExams));
     // Exam duration
     int examDuration;
-    // For checking the # enrolments
-    int numEnrolments1 = 0;
     // # enrolments
     int numEnrolments = 0;
     // Create *empty* exam vector
     boost::shared_ptr<vector<boost::shared_ptr<Exam> > > examVector(new vector<boost::shared_ptr<Exam> >());
-    // Go to the first line of exams
-    ++_it;
+    examVector->reserve(numExams);
     // Parse lines
-    for (int i = 0; i < numExams && _it != _tok.end(); ++i, ++_it) {
-        std::string line(*_it); // Lines start with \n because it wasn't removed
-#ifdef ITC2007TESTSET_DEBUG
-//        cout << i << ": " << line << endl;
-#endif
-        // Get number tokenizer
-        tokenizer<escaped_list_separator<char> > numberTok(line, escaped_list_separator<char>('\\', ','));
-        // Get number iterator
-        tokenizer<escaped_list_separator<char> >::iterator beg = numberTok.begin();
-        examDuration = atoi((*beg).c_str());
-#ifdef ITC2007TESTSET_DEBUG
-//        cout << "examDuration: " << examDuration << " - Students: ";
-#endif
-        ++beg; // Go to the first student
+    for (int i = 0; i < numExams; ++i) {
+        if (_reader.atEnd() || _reader.atSectionHeader())
+            _reader.error("expected " + std::to_string(numExams) + " exams, found " + std::to_string(i));
+        // Read duration
+        examDuration = _reader.readInt();
         // Exam number (start at 0)
         int exam = i;
         // Number of students enrolled in each exam
         int numExamStudents = 0;
-
-        for (; beg != numberTok.end(); ++beg) {
-#ifdef ITC2007TESTSET_DEBUG
-//            cout << *beg << " ";
-#endif
+        // Read students. A trailing comma is ignored
+        while (_reader.readComma() && !_reader.atEndOfLine()) {
             //////////////////////////////////////////
             // Build student map
             //////////////////////////////////////////
             // Current student
-            int student = atoi((*beg).c_str());
+            int student = _reader.readInt();
             // Insert current exam, given by the index i, in the student map
-            // If student doesn't exist yet, create entry <student, exam>
-            unordered_map<int, vector<int> >::iterator mapIt = _studentMap.find(student);
-            if (mapIt == _studentMap.end()) {
-                vector<int> exams;
-                exams.push_back(exam);
-                _studentMap.insert(pair<int, vector<int> >(student, exams));
-            }
-            else {
-                // Else add exam to the student exams
-                mapIt->second.push_back(exam);
-            }
+            if (student >= (int)_studentMap.size())
+                _studentMap.resize(student+1);
+            _studentMap[student].push_back(exam);
             // Increment # students
             ++numExamStudents;
         }
-//        cout << endl << endl;
+        _reader.endLine();
 
         // Insert total number of students associated to each exam
         (*courseClassSize.get())[exam] = numExamStudents;
@@ -292,37 +254,28 @@ void ITC2007TestSet::buildStudentMap(boost::tokenizer<boost::escaped_list_separa
         // Instantiate Exam object
         (*examVector.get()).push_back(boost::make_shared<Exam>(exam, numExamStudents, examDuration));
         // Update # enrolments
-        numEnrolments1 += numExamStudents;
+        numEnrolments += numExamStudents;
     }
-    int numStudents = 0, numStudents1 = 0, smallest = INT_MAX, greatest = INT_MIN;
-    for (auto const&s : _studentMap) {
-        //                cout << "Student: " << s.first << " - total exams: " << s.second.size() << endl;
-        ++numStudents1;
-        smallest = min(smallest, s.first);
-        greatest = max(greatest, s.first);
-        numEnrolments += s.second.size();
+    // Students numbers are the ones enrolled in at least one exam
+    int numStudents = 0, smallest = INT_MAX, greatest = INT_MIN;
+    for (int s = 0; s < (int)_studentMap.size(); ++s) {
+        if (!_studentMap[s].empty()) {
+            smallest = min(smallest, s);
+            greatest = max(greatest, s);
+        }
     }
     // Update # students
-    numStudents = greatest-smallest+1;
+    if (greatest >= smallest)
+        numStudents = greatest-smallest+1;
 
 #ifdef ITC2007TESTSET_DEBUG
     // Print student info
     cout << "Print student info" << endl << endl;
     cout << "numStudents = " << numStudents << endl;
-    cout << "numStudents1 = " << numStudents1 << endl;
     cout << "smallest = " << smallest << endl;
     cout << "greatest = " << greatest << endl;
     cout << "numEnrolments = " << numEnrolments << endl;
 
-//    // Print total number of students associated to each exam
-//    for (const auto& it : *courseClassSizeUnorderedMap.get()) {
-//        cout << "Exam = " << it.first << ", # students = " << it.second << endl;
-//    }
-    cout << "numEnrolments1 = " << numEnrolments1 << endl;
-
-    if (numEnrolments != numEnrolments1)
-        throw runtime_error("numEnrolments != numEnrolments1");
-
     // Print exam vector
     for (const auto& ptrExam : *examVector.get()) {
         cout << "Exam = " << ptrExam->getId()
@@ -366,62 +319,39 @@ void ITC2007TestSet::buildStudentMap(boost::tokenizer<boost::escaped_list_separa
 
 
 /**
- * @brief ITC2007TestSet::buildConflictMatrix Builds the Conflict matrix
+ * @brief ITC2007TestSet::buildConflictGraph Builds the Conflict matrix and the exam graph
  * @param _studentMap Student map containing the list of exams for each student
- * @return
  */
-void ITC2007TestSet::buildConflictMatrix(boost::unordered_map<int, vector<int> > const& _studentMap) {
+void ITC2007TestSet::buildConflictGraph(std::vector<std::vector<int> > const& _studentMap) {
     // # exams
     int numExams = timetableProblemData->getNumExams();
+    // Build the weighted edges of the conflict graph in parallel
+    ConflictGraphBuilder builder(numExams, numThreads);
+    builder.build(_studentMap);
     // Create shared ptr to manage Conflict Matrix
     boost::shared_ptr<IntMatrix> ptrConflictMatrix(new IntMatrix(numExams, numExams));
     // Get Conflict Matrix
     IntMatrix &conflictMatrix = *ptrConflictMatrix.get();
-    // Now, fill the conflict matrix and exam graph for each student
-    // (each map entry corresponds to one student enrolment data)
-    int v1, v2;
-    for (auto entry : _studentMap) {
-        vector<int>& exams = entry.second;
-        int examListSize = exams.size();
-        for (int i = 0; i < examListSize; ++i) {
-            for (int j = i+1; j < examListSize; ++j) {
-                // Get vertices.
-                v1 = exams[i];
-                v2 = exams[j];
-                // Increment by one (one student is enrolled in v1 and v2) arc's cost in
-                // the conflict matrix for vertices v1 and v2
-                conflictMatrix.incVal(v1, v2);
-                conflictMatrix.incVal(v2, v1); // Conflict matrix is symmetric
-            }
-        }
-    }
-    // Set conflict matrix in the TimetableProblemData
-    timetableProblemData.get()->setConflictMatrix(ptrConflictMatrix);
-}
-
-
-
-////
-/// \brief ITC2007TestSet::buildExamGraph
-/// \param conflictMatrix
-///
-void ITC2007TestSet::buildExamGraph(const IntMatrix &conflictMatrix) {
     // Instantiate graph with ncols vertices
-    boost::shared_ptr<AdjacencyList> ptrGraphAux(new AdjacencyList(conflictMatrix.getNumCols()+1));
-    // and set TimetableProblemData field
-    timetableProblemData.get()->setExamGraph(ptrGraphAux);
-    int cost;
-    // Vertices start at 0 as specified by the ITC 2007 rules
-    for (int v1 = 0; v1 < conflictMatrix.getNumLines(); ++v1) {
-        for (int v2 = 0; v2 < conflictMatrix.getNumLines(); ++v2) {
-            cost = conflictMatrix.getVal(v1, v2);
-            if (cost != 0) {
-                if (v2 > v1) {
-                    add_edge(v1, v2, *ptrGraphAux.get());
-                }
-            }
-        }
+    boost::shared_ptr<AdjacencyList> ptrGraphAux(new AdjacencyList(numExams+1));
+    // Vertices start at 0 as specified by the ITC 2007 rules.
+    // Edges are sorted by v1 and then by v2, so the adjacency lists are in increasing order
+    for (ConflictEdge const &edge : builder.getEdges()) {
+        conflictMatrix.setVal(edge.v1, edge.v2, edge.cost);
+        conflictMatrix.setVal(edge.v2, edge.v1, edge.cost); // Conflict matrix is symmetric
+        add_edge(edge.v1, edge.v2, *ptrGraphAux.get());
     }
+    for (int e = 0; e < numExams; ++e) {
+        if (builder.getSelfConflicts()[e] != 0)
+            conflictMatrix.setVal(e, e, builder.getSelfConflicts()[e]);
+    }
+    // The conflict density is the ratio of the number of non-zero elements in the conflict
+    // matrix to the total number of conflict matrix elements, not considering the diagonal
+    double numMatrixElements = numExams * numExams;
+    double conflictMatrixDensity = builder.getNumNonZeros() / (numMatrixElements - numExams);
+    // Set conflict matrix and exam graph in the TimetableProblemData
+    timetableProblemData.get()->setConflictMatrix(ptrConflictMatrix, conflictMatrixDensity);
+    timetableProblemData.get()->setExamGraph(ptrGraphAux);
 }
 
 
@@ -433,11 +363,9 @@ void ITC2007TestSet::buildExamGraph(const IntMatrix &conflictMatrix) {
 
 ////
 /// \brief ITC2007TestSet::readPeriods
-/// \param it
-/// \param tok
+/// \param _reader
 ///
-void ITC2007TestSet::readPeriods(tokenizer<escaped_list_separator<char> >::iterator& it,
-                                 tokenizer<escaped_list_separator<char> > const& tok) {
+void ITC2007TestSet::readPeriods(ITC2007Reader &_reader) {
     //
     // The problem instance files have the following format;
     // Number of Periods:
@@ -452,135 +380,73 @@ void ITC2007TestSet::readPeriods(tokenizer<escaped_list_separator<char> >::itera
     boost::shared_ptr<vector<boost::shared_ptr<ITC2007Period> > > periodVector(
                 new vector<boost::shared_ptr<ITC2007Period> >());
 
-    if (it != tok.end()) {
-        // Match period number
-        int numPeriods = matchPeriods(it);
-        int periodId = 0; // Period index
-        ++it; // Read next line
-        // Read periods info
-        for (int i = 0; i < numPeriods; ++i) {
-//            cout << "line " << (i+1) << ":" << endl;
-            // Match a sequence line
-            matchPeriodSequenceLine(periodId, it, periodVector);
-            ++periodId; // Increment period index
-            ++it; // Read next line
-        }
-        //
-        // Set TimetableProblemData field
-        //
-        // Set number of periods
-        timetableProblemData.get()->setNumPeriods(numPeriods);
-        // Set period vector
-        timetableProblemData->setPeriodVector(periodVector);
-#ifdef ITC2007TESTSET_DEBUG
-        // Processed period information
-        cout << "Processed period information: " << endl;
-        cout << "numPeriods = " << numPeriods << endl;
-        cout << "period vector # entries = " << timetableProblemData->getPeriodVector().size() << endl;
-#endif
+    // Read number of periods
+    int numPeriods = _reader.readSectionHeader("Periods");
+    // Read periods info
+    for (int periodId = 0; periodId < numPeriods; ++periodId) {
+        if (_reader.atEnd() || _reader.atSectionHeader())
+            _reader.error("expected " + std::to_string(numPeriods) + " periods, found " + std::to_string(periodId));
+        readPeriodLine(periodId, _reader, periodVector);
     }
-    else
-        throw runtime_error("Error while reading ITC07 periods");
-}
-
-
-
-
-////
-/// \brief ITC2007TestSet::matchPeriods
-/// \param it
-/// \return
-///
-int ITC2007TestSet::matchPeriods(tokenizer<escaped_list_separator<char> >::iterator& it) {
-    /////////////////////////////////////////////////
-    // Lines start with \n because it wasn't removed
     //
-    // Remove first \n in the regexp
-    /////////////////////////////////////////////////
-
-    // Number of periods
-    int numPeriods = 0;
-    // Read number of periods specified within the Timetabling Session e.g. [Periods:42]
-    std::string s(*it);
-    boost::cmatch matches;
-    //        boost::regex re("(\\[Periods:)(\\d+)(\\])");
-    boost::regex re("(\\\n)(\\[Periods:)(\\d+)(\\])");
-
-    if (boost::regex_match(s.c_str(), matches, re)) {
-        // Extract digits from std::string. The digits are the third subexpression, index = 3.
-        std::string match(matches[3].first, matches[3].second);
-        numPeriods = atoi(match.c_str());
-//        cout << "\tnumPeriods: " << numPeriods << endl;
-    }
-    else {
-        cout << "The regexp \"" << re << "\" does not match \"" << s << "\"" << endl;
-        cin.get();
-    }
-    return numPeriods;
+    // Set TimetableProblemData field
+    //
+    // Set number of periods
+    timetableProblemData.get()->setNumPeriods(numPeriods);
+    // Set period vector
+    timetableProblemData->setPeriodVector(periodVector);
+#ifdef ITC2007TESTSET_DEBUG
+    // Processed period information
+    cout << "Processed period information: " << endl;
+    cout << "numPeriods = " << numPeriods << endl;
+    cout << "period vector # entries = " << timetableProblemData->getPeriodVector().size() << endl;
+#endif
 }
 
 
 
 ////
-/// \brief ITC2007TestSet::matchPeriodSequenceLine
+/// \brief ITC2007TestSet::readPeriodLine
 /// \param _periodId
-/// \param _it
+/// \param _reader
 /// \param _periodVector
-/// \return
 ///
-int ITC2007TestSet::matchPeriodSequenceLine(int _periodId,
-                                            tokenizer<escaped_list_separator<char> >::iterator& _it,
-                                            boost::shared_ptr<vector<boost::shared_ptr<ITC2007Period> > >& _periodVector) {
+void ITC2007TestSet::readPeriodLine(int _periodId, ITC2007Reader &_reader,
+                                    boost::shared_ptr<vector<boost::shared_ptr<ITC2007Period> > >& _periodVector) {
 
     // Read sequence of lines detailing Period Dates, Times, Durations and associated Penalty:
     //  E.g.  31:05:2005, 09:00:00, 180, 0.
-    std::string s(*_it);
-    //    std::std::string s("\n15:04:2005, 09:30:00");
-
-    boost::cmatch matches;
-    boost::regex re("(\\\n)(\\d{2}):(\\d{2}):(\\d{4}), (\\d{2}):(\\d{2}):(\\d{2}), (\\d+), (\\d+)");
-
-    if (boost::regex_match(s.c_str(), matches, re)) {
-        // Extract values from std::string. E.g., the day part is the second subexpression, index = 2.
-        std::string matchDay(matches[2].first, matches[2].second);
-        int day = atoi(matchDay.c_str());
-        std::string matchMonth(matches[3].first, matches[3].second);
-        int month = atoi(matchMonth.c_str());
-        std::string matchYear(matches[4].first, matches[4].second);
-        int year = atoi(matchYear.c_str());
-
-        std::string matchHour(matches[5].first, matches[5].second);
-        int hour = atoi(matchHour.c_str());
-        std::string matchMinute(matches[6].first, matches[6].second);
-        int minute = atoi(matchMinute.c_str());
-        std::string matchSecond(matches[7].first, matches[7].second);
-        int second = atoi(matchSecond.c_str());
-
-        std::string matchDuration(matches[8].first, matches[8].second);
-        int duration = atoi(matchDuration.c_str());
-
-        std::string matchPenalty(matches[9].first, matches[9].second);
-        int penalty = atoi(matchPenalty.c_str());
+    int day = _reader.readInt();
+    _reader.expect(':');
+    int month = _reader.readInt();
+    _reader.expect(':');
+    int year = _reader.readInt();
+    _reader.expect(',');
+    int hour = _reader.readInt();
+    _reader.expect(':');
+    int minute = _reader.readInt();
+    _reader.expect(':');
+    int second = _reader.readInt();
+    _reader.expect(',');
+    int duration = _reader.readInt();
+    _reader.expect(',');
+    int penalty = _reader.readInt();
+    _reader.endLine();
 #ifdef ITC2007TESTSET_DEBUG
-        cout << "\tday: " << day << endl;
-        cout << "\tmonth: " << month << endl;
-        cout << "\tyear: " << year << endl;
-        cout << "\thour: " << hour << endl;
-        cout << "\tminute: " << minute << endl;
-        cout << "\tsecond: " << second << endl;
-        cout << "\tduration: " << duration << endl;
-        cout << "\tpenalty: " << penalty << endl;
-        cout << endl;
+    cout << "\tday: " << day << endl;
+    cout << "\tmonth: " << month << endl;
+    cout << "\tyear: " << year << endl;
+    cout << "\thour: " << hour << endl;
+    cout << "\tminute: " << minute << endl;
+    cout << "\tsecond: " << second << endl;
+    cout << "\tduration: " << duration << endl;
+    cout << "\tpenalty: " << penalty << endl;
+    cout << endl;
 #endif
-        // Create Period instance for keeping period information
-        boost::shared_ptr<ITC2007Period> period(new ITC2007Period(_periodId, Date(day, month, year),
-                                                                  Time(hour, minute, second), duration, penalty));
-        _periodVector->push_back(period);
-    }
-    else {
-        cout << "The regexp \"" << re << "\" does not match \"" << s << "\"" << endl;
-        cin.get();
-    }
+    // Create Period instance for keeping period information
+    boost::shared_ptr<ITC2007Period> period(new ITC2007Period(_periodId, Date(day, month, year),
+                                                              Time(hour, minute, second), duration, penalty));
+    _periodVector->push_back(period);
 }
 
 
@@ -591,11 +457,9 @@ int ITC2007TestSet::matchPeriodSequenceLine(int _periodId,
 
 ////
 /// \brief ITC2007TestSet::readRooms
-/// \param it
-/// \param tok
+/// \param _reader
 ///
-void ITC2007TestSet::readRooms(tokenizer<escaped_list_separator<char> >::iterator& it,
-                               tokenizer<escaped_list_separator<char> > const& tok) {
+void ITC2007TestSet::readRooms(ITC2007Reader &_reader) {
     //
     // The problem instance files have the following format;
     // Number of Rooms:
@@ -612,111 +476,53 @@ void ITC2007TestSet::readRooms(tokenizer<escaped_list_separator<char> >::iterato
     boost::shared_ptr<vector<boost::shared_ptr<Room> > > roomVector(
                 new vector<boost::shared_ptr<Room> >());
 
-    if (it != tok.end()) {
-        // Match rooms number
-        int numRooms = matchRooms(it);
-        int roomId = 0; // Room index
-        ++it; // Read next line
-        // Read rooms info
-        for (int i = 0; i < numRooms; ++i) {
-//            cout << "line " << (i+1) << ":" << endl;
-            // Match a sequence line
-            matchRoomSequenceLine(roomId, it, roomVector);
-            ++roomId; // Increment room index
-            ++it; // Read next line
-        }
-        //
-        // Set TimetableProblemData field
-        //
-        // Set number of rooms
-        (*timetableProblemData.get()).setNumRooms(numRooms);
-        // Set room vector
-        timetableProblemData->setRoomVector(roomVector);
-#ifdef ITC2007TESTSET_DEBUG
-        // Processed period information
-        cout << "Processed room information: " << endl;
-        cout << "numRooms = " << numRooms << endl;
-        cout << "room vector # entries = " << timetableProblemData->getRoomVector().size() << endl;
-#endif
+    // Read number of rooms
+    int numRooms = _reader.readSectionHeader("Rooms");
+    // Read rooms info
+    for (int roomId = 0; roomId < numRooms; ++roomId) {
+        if (_reader.atEnd() || _reader.atSectionHeader())
+            _reader.error("expected " + std::to_string(numRooms) + " rooms, found " + std::to_string(roomId));
+        readRoomLine(roomId, _reader, roomVector);
     }
-    else
-        throw runtime_error("Error while reading ITC07 rooms");
-}
-
-
-
-////
-/// \brief ITC2007TestSet::matchRooms
-/// \param it
-/// \return
-///
-int ITC2007TestSet::matchRooms(tokenizer<escaped_list_separator<char> >::iterator& it) {
-    /////////////////////////////////////////////////
-    // Lines start with \n because it wasn't removed
     //
-    // Remove first \n in the regexp
-    /////////////////////////////////////////////////
-
-    // Number of rooms
-    int numRooms = 0;
-    // Read number of rooms used e.g. [Rooms:10]
-    std::string s(*it);
-    boost::cmatch matches;
-    //        boost::regex re("(\\[Rooms:)(\\d+)(\\])");
-    boost::regex re("(\\\n)(\\[Rooms:)(\\d+)(\\])");
-
-    if (boost::regex_match(s.c_str(), matches, re)) {
-        // Extract digits from std::string. The digits are the third subexpression, index = 3.
-        std::string match(matches[3].first, matches[3].second);
-        numRooms = atoi(match.c_str());
-    }
-    else {
-        cout << "The regexp \"" << re << "\" does not match \"" << s << "\"" << endl;
-        cin.get();
-    }
-
-    return numRooms;
+    // Set TimetableProblemData field
+    //
+    // Set number of rooms
+    (*timetableProblemData.get()).setNumRooms(numRooms);
+    // Set room vector
+    timetableProblemData->setRoomVector(roomVector);
+#ifdef ITC2007TESTSET_DEBUG
+    // Processed period information
+    cout << "Processed room information: " << endl;
+    cout << "numRooms = " << numRooms << endl;
+    cout << "room vector # entries = " << timetableProblemData->getRoomVector().size() << endl;
+#endif
 }
 
 
 
 ////
-/// \brief ITC2007TestSet::matchRoomSequenceLine
+/// \brief ITC2007TestSet::readRoomLine
 /// \param _roomId
-/// \param _it
+/// \param _reader
 /// \param _roomVector
-/// \return
 ///
-int ITC2007TestSet::matchRoomSequenceLine(int _roomId, tokenizer<escaped_list_separator<char> >::iterator& _it,
-                                          boost::shared_ptr<vector<boost::shared_ptr<Room> > > &_roomVector) {
+void ITC2007TestSet::readRoomLine(int _roomId, ITC2007Reader &_reader,
+                                  boost::shared_ptr<vector<boost::shared_ptr<Room> > > &_roomVector) {
     // Read sequence of lines detailing room capacity and associated penalty:
     //  E.g.  260, 0
-    std::string s(*_it);
-    boost::cmatch matches;
-    boost::regex re("(\\\n)(\\d+), (\\d+)");
-
-    if (boost::regex_match(s.c_str(), matches, re)) {
-        // Extract values from std::string.
-        std::string matchCapacity(matches[2].first, matches[2].second);
-        int roomCapacity = atoi(matchCapacity.c_str());
-
-        std::string matchPenalty(matches[3].first, matches[3].second);
-        int penalty = atoi(matchPenalty.c_str());
+    int roomCapacity = _reader.readInt();
+    _reader.expect(',');
+    int penalty = _reader.readInt();
+    _reader.endLine();
 #ifdef ITC2007TESTSET_DEBUG
-//        cout << "\tcapacity: " << roomCapacity << endl;
-//        cout << "\tpenalty: " << penalty << endl;
-//        cout << endl;
+//    cout << "\tcapacity: " << roomCapacity << endl;
+//    cout << "\tpenalty: " << penalty << endl;
+//    cout << endl;
 #endif
-        // Get number of periods
-        int numPeriods = timetableProblemData.get()->getNumPeriods();
-        // Create Room instance for keeping room information
-        boost::shared_ptr<Room> room(new Room(_roomId, roomCapacity, penalty));
-        _roomVector->push_back(room);
-    }
-    else {
-        cout << "The regexp \"" << re << "\" does not match \"" << s << "\"" << endl;
-        cin.get();
-    }
+    // Create Room instance for keeping room information
+    boost::shared_ptr<Room> room(new Room(_roomId, roomCapacity, penalty));
+    _roomVector->push_back(room);
 }
 
 
@@ -727,11 +533,9 @@ int ITC2007TestSet::matchRoomSequenceLine(int _roomId, tokenizer<escaped_list_se
 
 ////
 /// \brief ITC2007TestSet::readConstraints
-/// \param it
-/// \param tok
+/// \param _reader
 ///
-void ITC2007TestSet::readConstraints(tokenizer<escaped_list_separator<char> >::iterator& it,
-                                     tokenizer<escaped_list_separator<char> > const& tok) {
+void ITC2007TestSet::readConstraints(ITC2007Reader &_reader) {
 
     //
     // The problem instance files have the following format:
@@ -765,168 +569,120 @@ void ITC2007TestSet::readConstraints(tokenizer<escaped_list_separator<char> >::i
     // FRONTLOAD, 100, 30, 5
     ////
 
-    // Get hard and soft constraints vectors
+    // Get hard constraints vector
     auto &hardConstraints = timetableProblemData.get()->getHardConstraints();
-//    auto &softConstraints = timetableProblemData.get()->getSoftConstraints();
     InstitutionalModelWeightings model_weightings;
 
-    if (it != tok.end()) {
-        readPeriodHardConstraints(it, hardConstraints);
+    readPeriodHardConstraints(_reader, hardConstraints);
 #ifdef ITC2007TESTSET_DEBUG
-        cout << "Finished reading Period hard constraints" << endl;
+    cout << "Finished reading Period hard constraints" << endl;
 #endif
 
-        readRoomHardConstraints(it, hardConstraints);
+    readRoomHardConstraints(_reader, hardConstraints);
 #ifdef ITC2007TESTSET_DEBUG
-        cout << "Finished reading Room hard constraints" << endl;
+    cout << "Finished reading Room hard constraints" << endl;
 #endif
 
-        // Read Institutional Weightings
-        readInstitutionalWeightingsSoftConstraints(it, model_weightings);
+    // Read Institutional Weightings
+    readInstitutionalWeightingsSoftConstraints(_reader, model_weightings);
 #ifdef ITC2007TESTSET_DEBUG
-        cout << "Finished reading Institutional Weightings soft constraints" << endl;
+    cout << "Finished reading Institutional Weightings soft constraints" << endl;
 #endif
 
     // Set timetableProblemData Institutional Model Weightings
     timetableProblemData->setInstitutionalModelWeightings(model_weightings);
+}
 
-//        // Read Institutional Weightings soft constraints
-//        readInstitutionalWeightingsSoftConstraints(it, softConstraints);
-//#ifdef ITC2007TESTSET_DEBUG
-//        cout << "Finished reading Institutional Weightings soft constraints" << endl;
-//#endif
-    }
 
-//    // Add Soft Room penalty and Soft Period penalty constraints
-//    boost::shared_ptr<Constraint> roomPenaltysoftConstr(
-//                new RoomPenaltySoftConstraint()
-//                );
-//    softConstraints.push_back(roomPenaltysoftConstr);
 
-//    boost::shared_ptr<Constraint> periodPenaltysoftConstr(
-//                new PeriodPenaltySoftConstraint()
-//                );
-//    softConstraints.push_back(periodPenaltysoftConstr);
+////
+/// \brief ITC2007TestSet::readExamIndex Read an exam index, which must be in [0, # exams)
+/// \param _reader
+/// \return
+///
+int ITC2007TestSet::readExamIndex(ITC2007Reader &_reader) {
+    _reader.skipSpaces();
+    int column = _reader.getColumn();
+    int exam = _reader.readInt();
+    if (exam >= timetableProblemData->getNumExams())
+        _reader.error(column, "exam " + std::to_string(exam) + " out of range [0, "
+                      + std::to_string(timetableProblemData->getNumExams()) + ")");
+    return exam;
 }
 
 
 
 ////
 /// \brief ITC2007TestSet::readPeriodHardConstraints
-/// \param it
+/// \param _reader
 /// \param hardConstraints
 ///
-void ITC2007TestSet::readPeriodHardConstraints(tokenizer<escaped_list_separator<char> >::iterator& it,
+void ITC2007TestSet::readPeriodHardConstraints(ITC2007Reader &_reader,
                                                vector<boost::shared_ptr<Constraint> > &hardConstraints) {
-    std::string s(*it);
-    boost::cmatch matches;
     // Section begins with the tag [PeriodHardConstraints]
-    boost::regex re("(\\\n)(\\[PeriodHardConstraints\\])");
-    if (!boost::regex_match(s.c_str(), matches, re))
-    {
-        cout << "The regexp \"" << re << "\" does not match \"" << s << "\"" << endl;
-        // throw exception
-        throw runtime_error("No PeriodHardConstraints specified");
-    }
+    _reader.readSectionTag("PeriodHardConstraints");
 #ifdef ITC2007TESTSET_DEBUG
     cout << "Read period hard constraints header" << endl;
 #endif
-    ++it; // Proceed to read the next line
-
-    // Read constraints if any.
-    // If line starts with a number then is a Period hard constraint
-    while (readPeriodConstraint(it, hardConstraints))
-        ++it;
+    // Read constraints until the next section
+    while (!_reader.atEnd() && !_reader.atSectionHeader())
+        readPeriodConstraint(_reader, hardConstraints);
 }
 
 
 
 ////
 /// \brief ITC2007TestSet::readPeriodConstraint
-/// \param it
+/// \param _reader
 /// \param hardConstraints
-/// \return
 ///
-bool ITC2007TestSet::readPeriodConstraint(tokenizer<escaped_list_separator<char> >::iterator& it,
+void ITC2007TestSet::readPeriodConstraint(ITC2007Reader &_reader,
                                           vector<boost::shared_ptr<Constraint> >& hardConstraints) {
-    std::string s(*it);
-    boost::cmatch matches;
-    boost::regex re("(\\\n)(\\d+), (AFTER|EXAM_COINCIDENCE|EXCLUSION), (\\d+)");
-
-    if (boost::regex_match(s.c_str(), matches, re)) {
-        // Extract values from std::string.
-        // Read Exam 1
-        std::string matchExam1(matches[2].first, matches[2].second);
-        int exam1 = atoi(matchExam1.c_str());
-        // Read Constraint type
-        std::string constraintType(matches[3].first, matches[3].second);
-        // Read Exam 2
-        std::string matchExam2(matches[4].first, matches[4].second);
-        int exam2 = atoi(matchExam2.c_str());
+    // E.g. 0, AFTER, 3
+    // Read Exam 1
+    int exam1 = readExamIndex(_reader);
+    _reader.expect(',');
+    // Read Constraint type
+    _reader.skipSpaces();
+    int typeColumn = _reader.getColumn();
+    std::string constraintType = _reader.readWord();
+    _reader.expect(',');
+    // Read Exam 2
+    int exam2 = readExamIndex(_reader);
+    _reader.endLine();
 #ifdef ITC2007TESTSET_DEBUG
-        cout << "\texam1: " << exam1 << endl;
-        cout << "\ttype of constraint: " << constraintType << endl;
-        cout << "\texam2: " << exam2 << endl;
-        cout << endl;
+    cout << "\texam1: " << exam1 << endl;
+    cout << "\ttype of constraint: " << constraintType << endl;
+    cout << "\texam2: " << exam2 << endl;
+    cout << endl;
 #endif
 
-///
-/// TODO: Improve code generality
-///
-
-        auto const& examVector = this->getTimetableProblemData()->getExamVector();
-
-        // Period Related Hard Constraints
-        if (constraintType == "EXAM_COINCIDENCE") {
-            boost::shared_ptr<Constraint> hardConstr(
-                        new ExamCoincidenceConstraint(exam1, exam2)
-                        );
-            hardConstraints.push_back(hardConstr);
-            // Insert this hard constraint into each associated exam, 'exam1' and 'exam2'
-            examVector[exam1]->insertPeriodRelatedHardConstraint(hardConstr);
-            examVector[exam2]->insertPeriodRelatedHardConstraint(hardConstr);
-        }
-        else if (constraintType == "EXCLUSION") {
-            boost::shared_ptr<Constraint> hardConstr(
-                        new ExamExclusionConstraint(exam1, exam2)
-                        );
-            hardConstraints.push_back(hardConstr);
-            // Insert this hard constraint into each associated exam, 'exam1' and 'exam2'
-            examVector[exam1]->insertPeriodRelatedHardConstraint(hardConstr);
-            examVector[exam2]->insertPeriodRelatedHardConstraint(hardConstr);
-        }
-        else if (constraintType == "AFTER") {
-            boost::shared_ptr<Constraint> hardConstr(
-                        new AfterConstraint(exam1, exam2)
-                        );
-            hardConstraints.push_back(hardConstr);
-            // Insert this hard constraint into each associated exam, 'exam1' and 'exam2'
-            examVector[exam1]->insertPeriodRelatedHardConstraint(hardConstr);
-            examVector[exam2]->insertPeriodRelatedHardConstraint(hardConstr);
-        }
-    }
-    else {
-//        cout << "The regexp \"" << re << "\" does not match \"" << s << "\"" << endl;
-        //        cin.get();
-        return false; // It couldn't read a period constraint.
-        // There are two possibilities:
-        // (1) the file format is incorrect,
-        // (2) Read the header of Room hard constraint
-    }
-    return true;
+    // Period Related Hard Constraints
+    boost::shared_ptr<Constraint> hardConstr;
+    if (constraintType == "EXAM_COINCIDENCE")
+        hardConstr = boost::make_shared<ExamCoincidenceConstraint>(exam1, exam2);
+    else if (constraintType == "EXCLUSION")
+        hardConstr = boost::make_shared<ExamExclusionConstraint>(exam1, exam2);
+    else if (constraintType == "AFTER")
+        hardConstr = boost::make_shared<AfterConstraint>(exam1, exam2);
+    else
+        _reader.error(typeColumn, "unknown period hard constraint " + constraintType);
+    hardConstraints.push_back(hardConstr);
+    // Insert this hard constraint into each associated exam, 'exam1' and 'exam2'
+    auto const& examVector = this->getTimetableProblemData()->getExamVector();
+    examVector[exam1]->insertPeriodRelatedHardConstraint(hardConstr);
+    examVector[exam2]->insertPeriodRelatedHardConstraint(hardConstr);
 }
 
 
 
 /////
 /// \brief ITC07TestSet::readRoomHardConstraints
-/// \param it
+/// \param _reader
 /// \param hardConstraints
 ///
-void ITC2007TestSet::readRoomHardConstraints(tokenizer<escaped_list_separator<char> >::iterator& it,
+void ITC2007TestSet::readRoomHardConstraints(ITC2007Reader &_reader,
                                              vector<boost::shared_ptr<Constraint> >& hardConstraints) {
-    std::string s(*it);
-    boost::cmatch matches;
     // Room Related Hard Constraints
     //
     // This section begins with the line [RoomHardConstraints] and provides data on conditions which are
@@ -934,86 +690,58 @@ void ITC2007TestSet::readRoomHardConstraints(tokenizer<escaped_list_separator<ch
     // This is
     // ROOM_EXCLUSIVE.  An exam must be timetabled in a room by itself e.g.
     // 2, ROOM_EXCLUSIVE      Exam ‘2' must be timetabled in a room by itself.
-    boost::regex re("(\\\n)(\\[RoomHardConstraints\\])");
-    if (!boost::regex_match(s.c_str(), matches, re))
-    {
-        cout << "The regexp \"" << re << "\" does not match \"" << s << "\"" << endl;
-        // throw exception
-        throw runtime_error("No RoomHardConstraints specified");
-    }
+    _reader.readSectionTag("RoomHardConstraints");
 #ifdef ITC2007TESTSET_DEBUG
     cout << "Read room hard constraints header" << endl;
 #endif
-    ++it; // Proceed to read the next line
-
-    // Read constraints if any.
-    // If line starts with a number then is a Room hard constraint
-    while (readRoomConstraint(it, hardConstraints))
-        ++it;
+    // Read constraints until the next section
+    while (!_reader.atEnd() && !_reader.atSectionHeader())
+        readRoomConstraint(_reader, hardConstraints);
 }
 
 
 
 /////
 /// \brief ITC07TestSet::readRoomConstraint
-/// \param it
+/// \param _reader
 /// \param hardConstraints
-/// \return
 ///
-bool ITC2007TestSet::readRoomConstraint(tokenizer<escaped_list_separator<char> >::iterator& it,
+void ITC2007TestSet::readRoomConstraint(ITC2007Reader &_reader,
                                         vector<boost::shared_ptr<Constraint> >& hardConstraints) {
-    std::string s(*it);
-    boost::cmatch matches;
-    boost::regex re("(\\\n)(\\d+), (ROOM_EXCLUSIVE)");
-
-    if (boost::regex_match(s.c_str(), matches, re)) {
-        // Extract values from std::string.
-        // Read Exam
-        std::string matchExam(matches[2].first, matches[2].second);
-        int exam = atoi(matchExam.c_str());
-        // Read Constraint type
-        std::string constraintType(matches[3].first, matches[3].second);
+    // E.g. 2, ROOM_EXCLUSIVE
+    // Read Exam
+    int exam = readExamIndex(_reader);
+    _reader.expect(',');
+    // Read Constraint type
+    _reader.skipSpaces();
+    int typeColumn = _reader.getColumn();
+    std::string constraintType = _reader.readWord();
+    _reader.endLine();
 #ifdef ITC2007TESTSET_DEBUG
-        cout << "\texam: " << exam << endl;
-        cout << "\ttype of constraint: " << constraintType << endl;
-        cout << endl;
+    cout << "\texam: " << exam << endl;
+    cout << "\ttype of constraint: " << constraintType << endl;
+    cout << endl;
 #endif
-        auto const& examVector = this->getTimetableProblemData()->getExamVector();
-
-        ///
-        /// Improve code generality
-        ///
-        // Room Related Hard Constraints
-        if (constraintType == "ROOM_EXCLUSIVE") {
-            boost::shared_ptr<Constraint> hardConstr(
-                        new RoomExclusiveConstraint(exam)
-                        );
-            hardConstraints.push_back(hardConstr);
-            // Insert this hard constraint into the associated exam, 'exam'
-            examVector[exam]->insertRoomRelatedHardConstraint(hardConstr);
-        }
-    }
-    else {
-//        cout << "The regexp \"" << re << "\" does not match \"" << s << "\"" << endl;
-        return false; // It couldn't read a room constraint.
-        // There are two possibilities:
-        // (1) the file format is incorrect,
-        // (2) Read the header of InstitutionalWeightings
-    }
-    return true;
+    // Room Related Hard Constraints
+    if (constraintType != "ROOM_EXCLUSIVE")
+        _reader.error(typeColumn, "unknown room hard constraint " + constraintType);
+    boost::shared_ptr<Constraint> hardConstr(
+                new RoomExclusiveConstraint(exam)
+                );
+    hardConstraints.push_back(hardConstr);
+    // Insert this hard constraint into the associated exam, 'exam'
+    auto const& examVector = this->getTimetableProblemData()->getExamVector();
+    examVector[exam]->insertRoomRelatedHardConstraint(hardConstr);
 }
 
 
 
-
-
-
 ////
 /// \brief ITC2007TestSet::readInstitutionalWeightingsSoftConstraints
-/// \param it
-/// \param softConstraints
+/// \param _reader
+/// \param _model_weightings
 ///
-void ITC2007TestSet::readInstitutionalWeightingsSoftConstraints(tokenizer<escaped_list_separator<char> >::iterator& it,
+void ITC2007TestSet::readInstitutionalWeightingsSoftConstraints(ITC2007Reader &_reader,
                                                                 InstitutionalModelWeightings &_model_weightings) {
     // Institutional Model Weightings
     //
@@ -1026,145 +754,66 @@ void ITC2007TestSet::readInstitutionalWeightingsSoftConstraints(tokenizer<escape
     // NONMIXEDDURATIONS, 10
     // FRONTLOAD, 100, 30, 5
     //
-    std::string s(*it);
-    boost::cmatch matches;
-    // Section begins with the tag [InstitutionalWeightings]
-    boost::regex re("(\\\n)(\\[InstitutionalWeightings\\])");
-    if (!boost::regex_match(s.c_str(), matches, re))
-    {
-        cout << "The regexp \"" << re << "\" does not match \"" << s << "\"" << endl;
-        // throw exception
-        throw runtime_error("No InstitutionalWeightings specified");
-    }
+    _reader.readSectionTag("InstitutionalWeightings");
 #ifdef ITC2007TESTSET_DEBUG
     cout << "Read [InstitutionalWeightings] header" << endl;
 #endif
-    ++it; // Proceed to read the next line
-
-    // Read constraints if any.
-    while (readInstitutionalWeightingsConstraint(it, _model_weightings))
-        ++it;
+    // Read weightings until the end of the file or the next section
+    while (!_reader.atEnd() && !_reader.atSectionHeader())
+        readInstitutionalWeightingsConstraint(_reader, _model_weightings);
 }
 
 
 
-
-
-
-
 ////
 /// \brief ITC2007TestSet::readInstitutionalWeightingsConstraint
-/// \param it
-/// \param softConstraints
-/// \return
+/// \param _reader
+/// \param _model_weightings
 ///
-bool ITC2007TestSet::readInstitutionalWeightingsConstraint(tokenizer<escaped_list_separator<char> >::iterator& it,
+void ITC2007TestSet::readInstitutionalWeightingsConstraint(ITC2007Reader &_reader,
                                                            InstitutionalModelWeightings &_model_weightings) {
-    std::string s(*it);
-    boost::cmatch matches;
-
-    ///
-    /// Improve code generality and regex parsing robustness
-    ///
-
-    // E. g.
-    // TWOINAROW, 7
-    // TWOINADAY, 5
-    // PERIODSPREAD, 3
-    // NONMIXEDDURATIONS, 10
-    // FRONTLOAD, 100, 30, 5
-    boost::regex re("(\\\n)(((TWOINAROW|TWOINADAY|PERIODSPREAD|NONMIXEDDURATIONS),(\\s*)(\\d+))|((FRONTLOAD),(\\s*)(\\d+),(\\s*)(\\d+),(\\s*)(\\d+)))");
-
-    if (boost::regex_match(s.c_str(), matches, re)) {
-        // Extract values from std::string.
-        //
-        // In the case of the constraints:
-        //  TWOINAROW, 7
-        //  TWOINADAY, 5
-        //  PERIODSPREAD, 3
-        //  NONMIXEDDURATIONS, 10
-        //
-        // matches[4] and matches[6] contain the <constraint type> and <id> fields.
-        //
-        // In the constraint:
-        // FRONTLOAD, 100, 30, 5
-        //
-        // matches[8], matches[10], matches[12], and matches[14] contain the <constraint type> and <id1>,<id2>,<id3> fields.
-        //
-        //  Input line containing constraint info
-        std::string inputLine(matches[2].first, matches[2].second);
-
-        if (inputLine.find("FRONTLOAD") != std::string::npos) {
-            // Constraint type
-            std::string constraintType(matches[8].first, matches[8].second);
-            // Id1
-            std::string matchId1(matches[10].first, matches[10].second);
-            int id1 = atoi(matchId1.c_str());
-            // Id2
-            std::string matchId2(matches[12].first, matches[12].second);
-            int id2 = atoi(matchId2.c_str());
-            // Id3
-            std::string matchId3(matches[14].first, matches[14].second);
-            int id3 = atoi(matchId3.c_str());
-#ifdef ITC2007TESTSET_DEBUG
-            cout << "\ttype of constraint: " << constraintType << endl;
-            cout << "\tid1: " << id1 << endl;
-            cout << "\tid2: " << id2 << endl;
-            cout << "\tid3: " << id3 << endl;
-            cout << endl;
-#endif
-            // FRONTLOAD soft constraint
-            if (constraintType == "FRONTLOAD") {
-                // First parameter  = number of largest exams. Largest exams are specified by class size
-                // Second parameter = number of last periods to take into account
-                // Third parameter  = the penalty or weighting
-                int numberLargestExams = id1;
-                int numberLastPeriods = id2;
-                int weightFL = id3;
-                // Set fields in _model_weightings instance
-                _model_weightings.front_load = { numberLargestExams, numberLastPeriods, weightFL };
-            }
-        }
-        else {
-            // Constraint type
-            std::string constraintType(matches[4].first, matches[4].second);
-            // Id
-            std::string matchId(matches[6].first, matches[6].second);
-            int id = atoi(matchId.c_str());
+    // Read Constraint type
+    _reader.skipSpaces();
+    int typeColumn = _reader.getColumn();
+    std::string constraintType = _reader.readWord();
+    _reader.expect(',');
+
+    if (constraintType == "FRONTLOAD") {
+        // FRONTLOAD soft constraint
+        // First parameter  = number of largest exams. Largest exams are specified by class size
+        // Second parameter = number of last periods to take into account
+        // Third parameter  = the penalty or weighting
+        int numberLargestExams = _reader.readInt();
+        _reader.expect(',');
+        int numberLastPeriods = _reader.readInt();
+        _reader.expect(',');
+        int weightFL = _reader.readInt();
 #ifdef ITC2007TESTSET_DEBUG
-            cout << "\ttype of constraint: " << constraintType << endl;
-            cout << "\tid: " << id << endl;
+        cout << "\ttype of constraint: " << constraintType << endl;
+        cout << "\tid1: " << numberLargestExams << endl;
+        cout << "\tid2: " << numberLastPeriods << endl;
+        cout << "\tid3: " << weightFL << endl;
+        cout << endl;
 #endif
-            // TWOINAROW soft constraint
-            if (constraintType == "TWOINAROW") {
-                int weight2R = id;
-                // Set fields in _model_weightings instance
-                _model_weightings.two_in_a_row = weight2R;
-            }
-            else if (constraintType == "TWOINADAY") { // TWOINADAY soft constraint
-                int weight2D = id;
-                // Set fields in _model_weightings instance
-                _model_weightings.two_in_a_day = weight2D;
-            }
-            else if (constraintType == "PERIODSPREAD") { // PERIODSPREAD soft constraint
-                int weightPS = id;
-                // Set fields in _model_weightings instance
-                _model_weightings.period_spread = weightPS;
-            }
-            else if (constraintType == "NONMIXEDDURATIONS") { // NONMIXEDDURATIONS soft constraint
-                int weightNMD = id;
-                // Set fields in _model_weightings instance
-                _model_weightings.non_mixed_durations = weightNMD;
-            }
-        }
+        // Set fields in _model_weightings instance
+        _model_weightings.front_load = { numberLargestExams, numberLastPeriods, weightFL };
     }
     else {
-//        cout << "The regexp \"" << re << "\" does not match \"" << s << "\"" << endl;
-        return false; // It couldn't read a period constraint.
-        // There are two possibilities:
-        // (1) the file format is incorrect,
-        // (2) Reach the end of file
+        int weight = _reader.readInt();
+#ifdef ITC2007TESTSET_DEBUG
+        cout << "\ttype of constraint: " << constraintType << endl;
+        cout << "\tid: " << weight << endl;
+#endif
+        if (constraintType == "TWOINAROW") // TWOINAROW soft constraint
+            _model_weightings.two_in_a_row = weight;
+        else if (constraintType == "TWOINADAY") // TWOINADAY soft constraint
+            _model_weightings.two_in_a_day = weight;
+        else if (constraintType == "PERIODSPREAD") // PERIODSPREAD soft constraint
+            _model_weightings.period_spread = weight;
+        else if (constraintType == "NONMIXEDDURATIONS") // NONMIXEDDURATIONS soft constraint
+            _model_weightings.non_mixed_durations = weight;
+        else
+            _reader.error(typeColumn, "unknown institutional weighting " + constraintType);
     }
-    return true;
+    _reader.endLine();
 }
-
@@ -10,7 +10,8 @@
 #include "data/Room.h"
 #include "data/ITC2007Period.h"
 #include "data/ConstraintValidator.hpp"
-#include <boost/tokenizer.hpp>
+#include "testset/ITC2007Reader.h"
+#include "testset/ITC2007BinaryCache.h"
 
 
 
@@ -20,7 +21,8 @@ class ITC2007TestSet : public TestSet {
 public:
     // Constructor
     ITC2007TestSet(std::string _testSetName, std::string _description, std::string _rootDir)
-        : TestSet(_testSetName, _description, _rootDir, boost::shared_ptr<TimetableProblemData>(new TimetableProblemData()))
+        : TestSet(_testSetName, _description, _rootDir, boost::shared_ptr<TimetableProblemData>(new TimetableProblemData())),
+          useBinaryCache(true), numThreads(0)
     {
 
 //        cout << "ITC07TestSet ctor" << endl;
@@ -33,55 +35,61 @@ public:
     // Overriden method
     virtual void load() override;
 
+    // Get/set whether the preprocessed instance is loaded from and saved to a binary cache
+    bool getUseBinaryCache() const { return useBinaryCache; }
+    void setUseBinaryCache(bool _useBinaryCache) { useBinaryCache = _useBinaryCache; }
+    // Get binary cache file name, next to the instance file
+    std::string getCacheFilename() const { return getRootDirectory() + "/" + getName() + ".cache"; }
+    // Get/set # threads used to build the conflict graph. If <= 0, the # hardware threads is used
+    int getNumThreads() const { return numThreads; }
+    void setNumThreads(int _numThreads) { numThreads = _numThreads; }
+
 protected:
     // Read exams and students
-    void readExams(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it,
-                   boost::tokenizer<boost::escaped_list_separator<char> > const& tok);
+    void readExams(ITC2007Reader &_reader);
     // Read periods
-    void readPeriods(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it,
-                     boost::tokenizer<boost::escaped_list_separator<char> > const& tok);
+    void readPeriods(ITC2007Reader &_reader);
     // Read rooms
-    void readRooms(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it,
-                   boost::tokenizer<boost::escaped_list_separator<char> > const& tok);
+    void readRooms(ITC2007Reader &_reader);
     // Read constraints and weightings
-    void readConstraints(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it,
-                         boost::tokenizer<boost::escaped_list_separator<char> > const& tok);
+    void readConstraints(ITC2007Reader &_reader);
 
 
     ///////////////////////////
     // Auxiliary methods
     ///////////////////////////
-    int matchPeriods(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it);
-    int matchPeriodSequenceLine(int _periodId, boost::tokenizer<boost::escaped_list_separator<char> >::iterator& _it,
-                                boost::shared_ptr<std::vector<boost::shared_ptr<ITC2007Period> > > &_periodVector);
+    void readPeriodLine(int _periodId, ITC2007Reader &_reader,
+                        boost::shared_ptr<std::vector<boost::shared_ptr<ITC2007Period> > > &_periodVector);
 
-    int matchRooms(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it);
-    int matchRoomSequenceLine(int _roomId, boost::tokenizer<boost::escaped_list_separator<char> >::iterator& _it,
-                              boost::shared_ptr<std::vector<boost::shared_ptr<Room> > > &_roomVector);
+    void readRoomLine(int _roomId, ITC2007Reader &_reader,
+                      boost::shared_ptr<std::vector<boost::shared_ptr<Room> > > &_roomVector);
 
-    void readPeriodHardConstraints(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it,
+    void readPeriodHardConstraints(ITC2007Reader &_reader,
                                    std::vector<boost::shared_ptr<Constraint> > &hardConstraints);
-    bool readPeriodConstraint(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it,
+    void readPeriodConstraint(ITC2007Reader &_reader,
                               std::vector<boost::shared_ptr<Constraint> >& hardConstraints);
 
-    void readRoomHardConstraints(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it,
-                                  std::vector<boost::shared_ptr<Constraint> >& hardConstraints);
-    bool readRoomConstraint(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it,
+    void readRoomHardConstraints(ITC2007Reader &_reader,
+                                 std::vector<boost::shared_ptr<Constraint> >& hardConstraints);
+    void readRoomConstraint(ITC2007Reader &_reader,
                             std::vector<boost::shared_ptr<Constraint> >& hardConstraints);
 
-    void readInstitutionalWeightingsSoftConstraints(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it,
-                                                 InstitutionalModelWeightings &_model_weightings);
-    bool readInstitutionalWeightingsConstraint(boost::tokenizer<boost::escaped_list_separator<char> >::iterator& it,
-                                                 InstitutionalModelWeightings &_model_weightings);
+    void readInstitutionalWeightingsSoftConstraints(ITC2007Reader &_reader,
+                                                    InstitutionalModelWeightings &_model_weightings);
+    void readInstitutionalWeightingsConstraint(ITC2007Reader &_reader,
+                                               InstitutionalModelWeightings &_model_weightings);
 
-    void buildStudentMap(boost::tokenizer<boost::escaped_list_separator<char> >::iterator &_it,
-                         const boost::tokenizer<boost::escaped_list_separator<char> > &_tok,
-                         boost::unordered_map<int, std::vector<int> > & _studentMap);
+    int readExamIndex(ITC2007Reader &_reader);
 
-    void buildConflictMatrix(boost::unordered_map<int, std::vector<int> > const& _studentMap);
+    void buildStudentMap(ITC2007Reader &_reader, std::vector<std::vector<int> > &_studentMap);
 
-    void buildExamGraph(const IntMatrix &conflictMatrix);
+    void buildConflictGraph(std::vector<std::vector<int> > const& _studentMap);
 
+private:
+    // Load from and save to the binary cache
+    bool useBinaryCache;
+    // # threads used to build the conflict graph
+    int numThreads;
 };
 
 
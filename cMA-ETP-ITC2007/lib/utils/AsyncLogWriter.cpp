@@ -0,0 +1,91 @@
+
+
+#include "utils/AsyncLogWriter.h"
+#include <algorithm>
+
+
+using namespace std;
+
+
+
+/**
+ * @brief AsyncLogWriter::AsyncLogWriter Start the writer thread
+ * @param _sinks Output streams. Sink i is selected by bit i of the write mask
+ * @param _capacity Max. # queued messages
+ */
+AsyncLogWriter::AsyncLogWriter(vector<ostream *> const &_sinks, size_t _capacity)
+    : sinks(_sinks), capacity(max<size_t>(1, _capacity)), writing(false), stopping(false) {
+    thread = std::thread(&AsyncLogWriter::run, this);
+}
+
+
+/**
+ * @brief AsyncLogWriter::~AsyncLogWriter Write the queued messages and stop the writer thread
+ */
+AsyncLogWriter::~AsyncLogWriter() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    notEmpty.notify_one();
+    thread.join();
+}
+
+
+/**
+ * @brief AsyncLogWriter::write Queue text _text. Blocks while the queue is full
+ * @param _text
+ * @param _sinkMask Sinks where the text is written (bit i - sink i)
+ */
+void AsyncLogWriter::write(string _text, unsigned _sinkMask) {
+    {
+        unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return queue.size() < capacity; });
+        queue.push_back(make_pair(_sinkMask, std::move(_text)));
+    }
+    notEmpty.notify_one();
+}
+
+
+/**
+ * @brief AsyncLogWriter::flush Wait until all queued messages are written and the sinks are flushed
+ */
+void AsyncLogWriter::flush() {
+    unique_lock<std::mutex> lock(mutex);
+    drained.wait(lock, [this] { return queue.empty() && !writing; });
+}
+
+
+/**
+ * @brief AsyncLogWriter::run Writer thread loop. Messages are taken from the queue in batches
+ * and written without holding the lock
+ */
+void AsyncLogWriter::run() {
+    deque<pair<unsigned, string> > batch;
+    unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        notEmpty.wait(lock, [this] { return !queue.empty() || stopping; });
+        if (queue.empty())
+            break;
+        batch.swap(queue);
+        writing = true;
+        lock.unlock();
+        notFull.notify_all();
+        for (auto const &message : batch) {
+            for (size_t i = 0; i < sinks.size(); ++i)
+                if (message.first & (1u << i))
+                    *sinks[i] << message.second;
+        }
+        batch.clear();
+        lock.lock();
+        // Flush once the queue is empty
+        if (queue.empty()) {
+            lock.unlock();
+            for (ostream *sink : sinks)
+                sink->flush();
+            lock.lock();
+            writing = false;
+            drained.notify_all();
+        }
+    }
+}
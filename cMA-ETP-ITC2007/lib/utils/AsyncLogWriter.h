@@ -0,0 +1,78 @@
+#ifndef ASYNCLOGWRITER_H
+#define ASYNCLOGWRITER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+/**
+ * @brief The AsyncLogWriter class Writes log text to a set of output streams from a background thread.
+ *
+ * The search thread only formats the text and queues it. The queue is bounded: when it is
+ * full, write blocks until the writer thread catches up, so the memory used by the log is
+ * bounded even if the streams are slow. The streams are flushed when the queue becomes empty,
+ * instead of after each line. While a writer exists, the streams must only be written through it.
+ */
+class AsyncLogWriter {
+
+public:
+    /**
+     * @brief AsyncLogWriter Start the writer thread
+     * @param _sinks Output streams. Sink i is selected by bit i of the write mask
+     * @param _capacity Max. # queued messages
+     */
+    AsyncLogWriter(std::vector<std::ostream *> const &_sinks, std::size_t _capacity = 1024);
+
+    /**
+     * @brief ~AsyncLogWriter Write the queued messages and stop the writer thread
+     */
+    ~AsyncLogWriter();
+
+    /**
+     * @brief write Queue text _text. Blocks while the queue is full
+     * @param _text
+     * @param _sinkMask Sinks where the text is written (bit i - sink i)
+     */
+    void write(std::string _text, unsigned _sinkMask = ~0u);
+
+    /**
+     * @brief flush Wait until all queued messages are written and the sinks are flushed
+     */
+    void flush();
+
+private:
+    // Non-copyable
+    AsyncLogWriter(AsyncLogWriter const &);
+    AsyncLogWriter &operator=(AsyncLogWriter const &);
+
+    // Writer thread loop
+    void run();
+
+    // Output streams
+    std::vector<std::ostream *> sinks;
+    // Max. # queued messages
+    std::size_t capacity;
+    // Queued (sink mask, text) messages
+    std::deque<std::pair<unsigned, std::string> > queue;
+    // True while the writer thread is writing a batch of messages
+    bool writing;
+    // True when the writer thread must stop
+    bool stopping;
+    std::mutex mutex;
+    // Signalled when messages are queued or the writer must stop
+    std::condition_variable notEmpty;
+    // Signalled when messages are dequeued
+    std::condition_variable notFull;
+    // Signalled when the queue is empty and the sinks are flushed
+    std::condition_variable drained;
+    std::thread thread;
+};
+
+
+#endif // ASYNCLOGWRITER_H
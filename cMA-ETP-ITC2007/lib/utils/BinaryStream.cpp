@@ -0,0 +1,32 @@
+
+
+#include "utils/BinaryStream.h"
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+
+
+/**
+ * @brief BinaryWriter::writeFile Write the buffer into file _filename. The buffer is written to
+ * a temporary file which is then renamed over _filename
+ * @param _filename
+ * @return true if the file was written
+ */
+bool BinaryWriter::writeFile(std::string const &_filename) const {
+    std::string tmpFilename = _filename + ".tmp." + std::to_string(getpid());
+    std::ofstream out(tmpFilename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+    out.write(buffer.data(), buffer.size());
+    out.close();
+    if (!out) {
+        std::remove(tmpFilename.c_str());
+        return false;
+    }
+    if (std::rename(tmpFilename.c_str(), _filename.c_str()) != 0) {
+        std::remove(tmpFilename.c_str());
+        return false;
+    }
+    return true;
+}
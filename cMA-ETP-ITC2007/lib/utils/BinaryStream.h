@@ -0,0 +1,104 @@
+#ifndef BINARYSTREAM_H
+#define BINARYSTREAM_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+
+/**
+ * @brief The BinaryWriter class Appends values, in the native byte order, to a byte buffer.
+ *
+ * Used by the binary instance cache and by the evolution checkpoints. The buffer
+ * is written to disk in one go, through a temporary file which is then renamed,
+ * so a reader never sees a partially written file.
+ */
+class BinaryWriter {
+
+public:
+    // Append a trivially copyable value
+    template <typename T>
+    void put(T const &_value) {
+        putBytes(reinterpret_cast<char const *>(&_value), sizeof(T));
+    }
+
+    // Append _size raw bytes
+    void putBytes(char const *_data, std::size_t _size) {
+        buffer.insert(buffer.end(), _data, _data + _size);
+    }
+
+    // Append a string, preceded by its length
+    void putString(std::string const &_value) {
+        put<std::uint64_t>(_value.size());
+        putBytes(_value.data(), _value.size());
+    }
+
+    // Get buffer
+    std::vector<char> const &getBuffer() const { return buffer; }
+
+    /**
+     * @brief writeFile Write the buffer into file _filename. The buffer is written to
+     * a temporary file which is then renamed over _filename
+     * @param _filename
+     * @return true if the file was written
+     */
+    bool writeFile(std::string const &_filename) const;
+
+private:
+    std::vector<char> buffer;
+};
+
+
+/**
+ * @brief The BinaryReader class Reads values from a byte buffer, checking its bounds.
+ * Throws std::runtime_error if the buffer is exhausted or a value is out of range
+ */
+class BinaryReader {
+
+public:
+    BinaryReader(char const *_begin, char const *_end) : cur(_begin), end(_end) { }
+
+    // Read a trivially copyable value
+    template <typename T>
+    T get() {
+        if ((std::size_t)(end - cur) < sizeof(T))
+            throw std::runtime_error("truncated file");
+        T value;
+        // The buffer may not be aligned
+        std::memcpy(&value, cur, sizeof(T));
+        cur += sizeof(T);
+        return value;
+    }
+
+    // Read a value in [_min, _max]
+    std::int32_t getInt(std::int32_t _min, std::int32_t _max) {
+        std::int32_t value = get<std::int32_t>();
+        if (value < _min || value > _max)
+            throw std::runtime_error("value out of range");
+        return value;
+    }
+
+    // Read a string written by BinaryWriter::putString
+    std::string getString() {
+        std::uint64_t size = get<std::uint64_t>();
+        if ((std::uint64_t)(end - cur) < size)
+            throw std::runtime_error("truncated file");
+        std::string value(cur, size);
+        cur += size;
+        return value;
+    }
+
+    // Get # unread bytes
+    std::size_t getRemaining() const { return end - cur; }
+
+    bool atEnd() const { return cur == end; }
+
+private:
+    char const *cur;
+    char const *end;
+};
+
+
+#endif // BINARYSTREAM_H
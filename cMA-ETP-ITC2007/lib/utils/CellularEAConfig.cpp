@@ -0,0 +1,291 @@
+
+
+#include "utils/CellularEAConfig.h"
+#include "utils/ParameterFile.h"
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <climits>
+#include <cstdlib>
+#include <cerrno>
+
+
+using namespace std;
+
+
+namespace {
+
+const double NO_LIMIT = numeric_limits<double>::infinity();
+
+// # Kempe chain operators among which the operator selection policy chooses
+// (see ETTPKempeChainHeuristic::getOperatorNames)
+const int NUM_KEMPE_OPERATORS = 3;
+
+// Remove leading and trailing blanks
+string trim(string const &_s) {
+    size_t first = _s.find_first_not_of(" \t\r");
+    if (first == string::npos)
+        return "";
+    size_t last = _s.find_last_not_of(" \t\r");
+    return _s.substr(first, last - first + 1);
+}
+
+// Parse number _value. Returns false if it is malformed
+bool parseNumber(string const &_value, double &_number) {
+    char *end;
+    errno = 0;
+    _number = strtod(_value.c_str(), &end);
+    return !_value.empty() && *end == '\0' && errno == 0;
+}
+
+}
+
+
+
+/**
+ * @brief CellularEAConfig::CellularEAConfig Declare the parameters with their default values
+ */
+CellularEAConfig::CellularEAConfig() {
+    // Random number generation
+    add("seed", Type::Int, "0", 0, INT_MAX, "seed of the random number generators (0 - from the clock)");
+    // Population grid. A 1-row grid is a ring cGA
+    add("nlines", Type::Int, "4", 1, NO_LIMIT, "# grid rows");
+    add("ncols", Type::Int, "4", 1, NO_LIMIT, "# grid columns");
+    add("topology", { "auto", "Ring", "L5", "L9", "C9", "C13" }, "cell neighbourhood (auto - Ring if nlines = 1, L5 otherwise)");
+    // Stop criteria
+    add("generations", Type::Int, "5000000", 1, NO_LIMIT, "# generations");
+    add("timeLimit", Type::Double, "0", 0, NO_LIMIT, "wall-clock time limit in seconds (0 - no time limit)");
+    add("machineSpeedFactor", Type::Double, "1", 0, NO_LIMIT,
+        "time limit multiplier: (local ITC2007 benchmark program time) / (ITC2007 benchmark machine time)");
+    // Variation
+    add("cp", Type::Double, "0.5", 0, 1, "crossover probability");
+    add("mp", Type::Double, "0.1", 0, 1, "mutation probability");
+    add("ip", Type::Double, "0.1", 0, 1, "improvement probability");
+    // Improvement step
+    add("improvementStep", { "ThresholdAccepting", "LateAcceptance", "GreatDeluge" },
+        "local search of the improvement step");
+    add("coolingSchedule", { "simple", "adaptive" },
+        "TA threshold schedule (adaptive - speeds up, holds or reheats according to the acceptance rate)");
+    add("initT", Type::Double, "10", 0, NO_LIMIT, "TA initial threshold");
+    add("alpha", Type::Double, "0.001", 0, NO_LIMIT, "TA threshold decrease factor");
+    add("span", Type::Int, "5", 1, NO_LIMIT, "TA # iterations per threshold");
+    add("finalT", Type::Double, "2e-4", 0, NO_LIMIT, "TA final threshold");
+    add("taBatchSize", Type::Int, "1", 1, NO_LIMIT, "# neighbours evaluated per TA iteration");
+    add("taBatchAcceptance", { "BestCandidate", "FirstAcceptable" }, "candidate submitted to the threshold test when taBatchSize > 1");
+    add("taNumThreads", Type::Int, "1", 0, NO_LIMIT,
+        "# threads of the speculative TA (1 - sequential TA, 0 - # hardware threads). If > 1, taBatchSize is ignored");
+    add("lahcHistoryLength", Type::Int, "500", 1, NO_LIMIT, "Late Acceptance history length");
+    add("gdTargetRatio", Type::Double, "0.5", 0, 1, "Great Deluge target cost, as a fraction of the initial cost");
+    add("taCacheSize", Type::Int, "-1", -1, NO_LIMIT,
+        "# entries of the local search outcome cache (0 - disabled, -1 - twice the population size)");
+    // Diversity
+    add("minReplacementDistance", Type::Double, "0.01", 0, 1,
+        "an offspring this close to another, not worse, cell does not replace the current individual");
+    add("restartDistance", Type::Double, "0.05", 0, 1,
+        "population mean distance below which converged cells are re-seeded (0 - disabled)");
+    add("restartFraction", Type::Double, "0.5", 0, 1, "maximum fraction of the cells re-seeded");
+    // Kempe chain operator selection
+    add("operatorSelection", { "AdaptivePursuit", "Uniform" }, "Kempe chain operator selection policy");
+    add("apPMin", Type::Double, "0.1", 0, 1, "Adaptive Pursuit minimum selection probability (<= 1/# operators)");
+    add("apAlpha", Type::Double, "0.1", 0, 1, "Adaptive Pursuit adaptation rate of the quality estimates");
+    add("apBeta", Type::Double, "0.1", 0, 1, "Adaptive Pursuit learning rate of the selection probabilities");
+    // Checkpoint and logging
+    add("checkpointInterval", Type::Int, "10", 0, NO_LIMIT, "# generations between evolution checkpoints (0 - disabled)");
+    add("logInterval", Type::Int, "100", 0, NO_LIMIT, "# generations between generation reports (0 - disabled)");
+    add("logOnImprovement", true, "report the generations which improve the best solution");
+    add("logPeriod", Type::Double, "10", 0, NO_LIMIT, "maximum seconds between generation reports (0 - disabled)");
+    // Warm start
+    add("warmStartPerturbedFraction", Type::Double, "0.5", 0, 1,
+        "fraction of the non-seed cells which are perturbed copies of the warm start solutions");
+    add("warmStartNumPerturbations", Type::Int, "20", 0, NO_LIMIT, "# mutations applied to each perturbed copy");
+}
+
+
+/**
+ * @brief CellularEAConfig::set Assign value _value to parameter _key
+ * @param _key
+ * @param _value
+ */
+void CellularEAConfig::set(string const &_key, string const &_value) {
+    Parameter &param = find(_key);
+    string value = trim(_value);
+    double number;
+    switch (param.type) {
+    case Type::Int:
+    case Type::Double:
+        if (!parseNumber(value, number) || (param.type == Type::Int && value.find_first_not_of("+-0123456789") != string::npos))
+            throw runtime_error("invalid " + string(param.type == Type::Int ? "integer" : "number") + " for " + _key + ": " + value);
+        if (number != number || number < param.min || number > param.max ||
+                (param.type == Type::Int && number > INT_MAX))
+            throw runtime_error(_key + " out of range: " + value);
+        break;
+    case Type::Bool:
+        if (value == "1" || value == "true")
+            value = "true";
+        else if (value == "0" || value == "false")
+            value = "false";
+        else
+            throw runtime_error("invalid boolean for " + _key + ": " + value);
+        break;
+    case Type::Choice:
+        if (find_if(param.choices.begin(), param.choices.end(), [&value](string const &_c) { return _c == value; }) == param.choices.end())
+            throw runtime_error("invalid value for " + _key + ": " + value);
+        break;
+    }
+    param.value = value;
+}
+
+
+/**
+ * @brief CellularEAConfig::set Assign a "key=value" string
+ * @param _assignment
+ */
+void CellularEAConfig::set(string const &_assignment) {
+    size_t eq = _assignment.find('=');
+    if (eq == string::npos)
+        throw runtime_error("expected 'key=value': " + _assignment);
+    set(trim(_assignment.substr(0, eq)), _assignment.substr(eq+1));
+}
+
+
+/**
+ * @brief CellularEAConfig::load Assign the parameters of configuration file _filename
+ * @param _filename
+ */
+void CellularEAConfig::load(string const &_filename) {
+    ParameterFile file;
+    file.load(_filename);
+    for (auto const &key : file.getKeys()) {
+        try {
+            set(key, file.getString(key, ""));
+        }
+        catch (runtime_error const &e) {
+            throw runtime_error(_filename + ":" + to_string(file.getLine(key)) + ": " + e.what());
+        }
+    }
+}
+
+
+/**
+ * @brief CellularEAConfig::check Check the constraints between parameters
+ */
+void CellularEAConfig::check() const {
+    if (getDouble("alpha") <= 0 || getDouble("finalT") <= 0 || getDouble("initT") < getDouble("finalT"))
+        throw runtime_error("invalid cooling schedule: alpha and finalT must be > 0, and initT >= finalT");
+    // Adaptive Pursuit gives every operator at least apPMin
+    if (getString("operatorSelection") == "AdaptivePursuit" && getDouble("apPMin")*NUM_KEMPE_OPERATORS > 1)
+        throw runtime_error("invalid apPMin: it must be <= 1/" + to_string(NUM_KEMPE_OPERATORS)
+                            + " (# Kempe chain operators)");
+}
+
+
+/**
+ * @brief CellularEAConfig::getString
+ * @param _key
+ * @return The value of parameter _key
+ */
+string CellularEAConfig::getString(string const &_key) const {
+    return find(_key).value;
+}
+
+
+/**
+ * @brief CellularEAConfig::getDouble
+ * @param _key
+ * @return The value of numeric parameter _key
+ */
+double CellularEAConfig::getDouble(string const &_key) const {
+    return strtod(find(_key).value.c_str(), nullptr);
+}
+
+
+/**
+ * @brief CellularEAConfig::getInt
+ * @param _key
+ * @return The value of numeric parameter _key
+ */
+int CellularEAConfig::getInt(string const &_key) const {
+    return atoi(find(_key).value.c_str());
+}
+
+
+/**
+ * @brief CellularEAConfig::getBool
+ * @param _key
+ * @return The value of Bool parameter _key
+ */
+bool CellularEAConfig::getBool(string const &_key) const {
+    return find(_key).value == "true";
+}
+
+
+/**
+ * @brief CellularEAConfig::isNumeric
+ * @param _key
+ * @return true if parameter _key is an integer or a real number
+ */
+bool CellularEAConfig::isNumeric(string const &_key) const {
+    Type type = find(_key).type;
+    return type == Type::Int || type == Type::Double;
+}
+
+
+/**
+ * @brief CellularEAConfig::isInteger
+ * @param _key
+ * @return true if parameter _key is an integer
+ */
+bool CellularEAConfig::isInteger(string const &_key) const {
+    return find(_key).type == Type::Int;
+}
+
+
+/**
+ * @brief CellularEAConfig::write Write the configuration as "key = value" lines
+ * @param _os
+ * @param _descriptions Add the parameter descriptions as comments
+ */
+void CellularEAConfig::write(ostream &_os, bool _descriptions) const {
+    for (auto const &param : parameters) {
+        _os << param.key << " = " << param.value;
+        if (_descriptions) {
+            _os << "    # " << param.description;
+            if (param.type == Type::Choice) {
+                _os << ". Values:";
+                for (auto const &choice : param.choices)
+                    _os << " " << choice;
+            }
+        }
+        _os << endl;
+    }
+}
+
+
+void CellularEAConfig::add(string const &_key, Type _type, string const &_value, double _min, double _max,
+                           string const &_description) {
+    parameters.push_back({ _key, _type, _value, _min, _max, {}, _description });
+}
+
+
+void CellularEAConfig::add(string const &_key, bool _value, string const &_description) {
+    parameters.push_back({ _key, Type::Bool, _value ? "true" : "false", 0, 0, {}, _description });
+}
+
+
+void CellularEAConfig::add(string const &_key, vector<string> const &_choices, string const &_description) {
+    parameters.push_back({ _key, Type::Choice, _choices.front(), 0, 0, _choices, _description });
+}
+
+
+CellularEAConfig::Parameter &CellularEAConfig::find(string const &_key) {
+    for (auto &param : parameters) {
+        if (param.key == _key)
+            return param;
+    }
+    throw runtime_error("unknown parameter " + _key);
+}
+
+
+CellularEAConfig::Parameter const &CellularEAConfig::find(string const &_key) const {
+    return const_cast<CellularEAConfig *>(this)->find(_key);
+}
@@ -0,0 +1,98 @@
+#ifndef CELLULAREACONFIG_H
+#define CELLULAREACONFIG_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+
+/**
+ * @brief The CellularEAConfig class Parameters of a cEA run: grid and topology, stop criteria,
+ * variation probabilities, local search engine and cooling schedule, diversity, operator
+ * selection, checkpoint, logging and warm start.
+ *
+ * Every parameter has a default value, which reproduces the reference configuration. They
+ * are overridden by "key = value" configuration files (see ParameterFile) and by single
+ * assignments, such as those given in the command line; the last assignment wins. Values
+ * are checked when they are assigned: unknown keys, malformed values, values out of range
+ * and unknown choices throw std::runtime_error. write outputs the configuration in the file
+ * format, so the configuration echoed in a run output can be loaded again.
+ */
+class CellularEAConfig {
+
+public:
+    // Ctor. Declares the parameters with their default values
+    CellularEAConfig();
+
+    /**
+     * @brief set Assign value _value to parameter _key
+     * @param _key
+     * @param _value
+     */
+    void set(std::string const &_key, std::string const &_value);
+
+    /**
+     * @brief set Assign a "key=value" string, as given in the command line
+     * @param _assignment
+     */
+    void set(std::string const &_assignment);
+
+    /**
+     * @brief load Assign the parameters of configuration file _filename. Errors name the file and line
+     * @param _filename
+     */
+    void load(std::string const &_filename);
+
+    /**
+     * @brief check Check the constraints between parameters. Throws std::runtime_error if one is not met
+     */
+    void check() const;
+
+    // Get the value of parameter _key
+    std::string getString(std::string const &_key) const;
+    double getDouble(std::string const &_key) const;
+    int getInt(std::string const &_key) const;
+    bool getBool(std::string const &_key) const;
+
+    // Get whether parameter _key is a number, and whether it is an integer
+    bool isNumeric(std::string const &_key) const;
+    bool isInteger(std::string const &_key) const;
+
+    /**
+     * @brief write Write the configuration as "key = value" lines. If _descriptions is set,
+     * each line is followed by a comment with the parameter description
+     * @param _os
+     * @param _descriptions
+     */
+    void write(std::ostream &_os, bool _descriptions = false) const;
+
+private:
+    enum class Type { Int, Double, Bool, Choice };
+
+    struct Parameter {
+        std::string key;
+        Type type;
+        std::string value;
+        double min, max; // Range of Int and Double parameters
+        std::vector<std::string> choices; // Values of Choice parameters
+        std::string description;
+    };
+
+    // Declare a numeric parameter
+    void add(std::string const &_key, Type _type, std::string const &_value, double _min, double _max,
+             std::string const &_description);
+    // Declare a Bool parameter
+    void add(std::string const &_key, bool _value, std::string const &_description);
+    // Declare a Choice parameter. The default value is the first choice
+    void add(std::string const &_key, std::vector<std::string> const &_choices, std::string const &_description);
+
+    // Get parameter _key. Throws std::runtime_error if it doesn't exist
+    Parameter &find(std::string const &_key);
+    Parameter const &find(std::string const &_key) const;
+
+    // Parameters, in declaration order
+    std::vector<Parameter> parameters;
+};
+
+
+#endif // CELLULAREACONFIG_H
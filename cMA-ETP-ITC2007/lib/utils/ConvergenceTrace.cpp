@@ -0,0 +1,118 @@
+
+
+#include "utils/ConvergenceTrace.h"
+#include "utils/BinaryStream.h"
+#include "utils/MappedFile.h"
+#include <stdexcept>
+#include <algorithm>
+#include <unistd.h>
+
+
+using namespace std;
+
+
+namespace {
+
+// Trace file signature
+const char TRACE_MAGIC[8] = { 'C', 'M', 'A', 'E', 'T', 'P', 'T', 'R' };
+// Written in the native byte order, to detect traces with a different byte order
+const uint32_t TRACE_BYTE_ORDER_MARK = 0x01020304;
+
+static_assert(sizeof(ConvergenceTraceRecord) == (NUM_CONSTRAINT_COSTS+9)*8, "trace records must not have padding");
+
+}
+
+
+const uint32_t ConvergenceTrace::VERSION;
+
+char const *const ConvergenceTrace::CONSTRAINT_NAMES[NUM_CONSTRAINT_COSTS] = {
+    "twoInARow", "twoInADay", "periodSpread", "mixedDurations", "frontLoad", "roomPenalty", "periodPenalty"
+};
+
+
+
+/**
+ * @brief ConvergenceTrace::getHeader Get the file header: signature, version, byte order mark and record size
+ * @return
+ */
+string ConvergenceTrace::getHeader() {
+    BinaryWriter writer;
+    writer.putBytes(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    writer.put<uint32_t>(VERSION);
+    writer.put<uint32_t>(TRACE_BYTE_ORDER_MARK);
+    writer.put<uint32_t>(sizeof(ConvergenceTraceRecord));
+    return string(writer.getBuffer().begin(), writer.getBuffer().end());
+}
+
+
+/**
+ * @brief ConvergenceTrace::openFile Open trace file _filename in _file. If _append is set and the file
+ * has a valid header, the new records are appended, after dropping a partially written last record.
+ * Otherwise the file is created and the header is written
+ * @param _file
+ * @param _filename
+ * @param _append
+ * @return true if the file was opened
+ */
+bool ConvergenceTrace::openFile(ofstream &_file, string const &_filename, bool _append) {
+    string header = getHeader();
+    if (_append) {
+        ifstream in(_filename.c_str(), ios::binary);
+        string fileHeader(header.size(), '\0');
+        if (in.read(&fileHeader[0], fileHeader.size()) && fileHeader == header) {
+            in.seekg(0, ios::end);
+            long long size = in.tellg();
+            in.close();
+            long long recordsSize = size - header.size();
+            // A partial record would misalign the appended ones
+            if (recordsSize % sizeof(ConvergenceTraceRecord) != 0 &&
+                    truncate(_filename.c_str(), size - recordsSize % sizeof(ConvergenceTraceRecord)) != 0)
+                return false;
+            _file.open(_filename.c_str(), ios::binary | ios::app);
+            return _file.is_open();
+        }
+    }
+    _file.open(_filename.c_str(), ios::binary | ios::trunc);
+    _file << header;
+    return _file.good();
+}
+
+
+/**
+ * @brief ConvergenceTrace::toBytes
+ * @param _record
+ * @return The bytes of record _record
+ */
+string ConvergenceTrace::toBytes(ConvergenceTraceRecord const &_record) {
+    return string(reinterpret_cast<char const *>(&_record), sizeof(_record));
+}
+
+
+/**
+ * @brief ConvergenceTrace::read Read the records of trace file _filename. Throws std::runtime_error
+ * if the file is not a valid trace
+ * @param _filename
+ * @return The records, in generation order
+ */
+vector<ConvergenceTraceRecord> ConvergenceTrace::read(string const &_filename) {
+    try {
+        MappedFile file(_filename);
+        string header = getHeader();
+        if (file.getSize() < header.size() || !equal(header.begin(), header.end(), file.getData()))
+            throw runtime_error("unsupported trace format");
+        BinaryReader reader(file.getData() + header.size(), file.getData() + file.getSize());
+        vector<ConvergenceTraceRecord> records;
+        // A partially written last record is ignored
+        while (reader.getRemaining() >= sizeof(ConvergenceTraceRecord)) {
+            ConvergenceTraceRecord record = reader.get<ConvergenceTraceRecord>();
+            // Drop the records of a resumed run which were written after its checkpoint
+            while (!records.empty() && records.back().generation >= record.generation)
+                records.pop_back();
+            records.push_back(record);
+        }
+        return records;
+    }
+    catch (runtime_error const &e) {
+        throw runtime_error("In [ConvergenceTrace::read]: " + _filename + ": " + e.what());
+    }
+}
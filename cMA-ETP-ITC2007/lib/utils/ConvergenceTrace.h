@@ -0,0 +1,114 @@
+#ifndef CONVERGENCETRACE_H
+#define CONVERGENCETRACE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+
+/**
+ * @brief NUM_CONSTRAINT_COSTS # soft constraint costs in a trace record
+ */
+const int NUM_CONSTRAINT_COSTS = 7;
+
+
+/**
+ * @brief The ConvergenceTraceRecord struct State of the search at the end of a generation.
+ * All the fields have 8 bytes, so the record has no padding and is written as is
+ */
+struct ConvergenceTraceRecord {
+    /**
+     * @brief time Seconds since the start of the run
+     */
+    double time;
+    /**
+     * @brief generation Generation number
+     */
+    std::int64_t generation;
+    /**
+     * @brief numEvaluations Total # evaluations
+     */
+    std::int64_t numEvaluations;
+    /**
+     * @brief bestCost Best solution fitness
+     */
+    double bestCost;
+    /**
+     * @brief constraintCosts Best solution soft constraint costs, in the order of
+     * ConvergenceTrace::CONSTRAINT_NAMES
+     */
+    std::int64_t constraintCosts[NUM_CONSTRAINT_COSTS];
+    /**
+     * @brief popMean Population mean fitness
+     */
+    double popMean;
+    /**
+     * @brief popVariance Population fitness variance
+     */
+    double popVariance;
+    /**
+     * @brief feasibleRate Fraction of the neighbours built in the generation which were feasible
+     */
+    double feasibleRate;
+    /**
+     * @brief acceptRate Fraction of the neighbours built in the generation which were accepted
+     */
+    double acceptRate;
+    /**
+     * @brief improveRate Fraction of the neighbours built in the generation which improved the solution
+     */
+    double improveRate;
+};
+
+
+/**
+ * @brief The ConvergenceTrace class Binary convergence trace file: a header followed by
+ * fixed-size ConvergenceTraceRecord records, in the native byte order.
+ *
+ * When a run is resumed from a checkpoint, the records are appended to the existing
+ * trace. The records written after the checkpoint by the interrupted run are then
+ * followed by records of the same generations, and read drops them.
+ */
+class ConvergenceTrace {
+
+public:
+    /**
+     * @brief VERSION Trace format version. It must be incremented whenever the format changes
+     */
+    static const std::uint32_t VERSION = 1;
+
+    /**
+     * @brief CONSTRAINT_NAMES Names of the soft constraint costs
+     */
+    static char const *const CONSTRAINT_NAMES[NUM_CONSTRAINT_COSTS];
+
+    /**
+     * @brief openFile Open trace file _filename in _file. If _append is set and the file has a
+     * valid header, the new records are appended, after dropping a partially written last
+     * record. Otherwise the file is created and the header is written
+     * @param _file
+     * @param _filename
+     * @param _append
+     * @return true if the file was opened
+     */
+    static bool openFile(std::ofstream &_file, std::string const &_filename, bool _append);
+
+    // Get the bytes of record _record
+    static std::string toBytes(ConvergenceTraceRecord const &_record);
+
+    /**
+     * @brief read Read the records of trace file _filename. Throws std::runtime_error
+     * if the file is not a valid trace
+     * @param _filename
+     * @return The records, in generation order
+     */
+    static std::vector<ConvergenceTraceRecord> read(std::string const &_filename);
+
+private:
+    // Get the file header: signature, version, byte order mark and record size
+    static std::string getHeader();
+};
+
+
+#endif // CONVERGENCETRACE_H
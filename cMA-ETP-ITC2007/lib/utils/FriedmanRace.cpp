@@ -0,0 +1,218 @@
+
+
+#include "utils/FriedmanRace.h"
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+
+
+using namespace std;
+
+
+namespace {
+
+// Regularised lower incomplete gamma function P(_a, _x) (Numerical Recipes, 6.2)
+double incompleteGamma(double _a, double _x) {
+    if (_x <= 0)
+        return 0;
+    double lnPrefix = _a*log(_x) - _x - lgamma(_a);
+    if (_x < _a+1) {
+        // Series
+        double term = 1/_a, sum = term;
+        for (int n = 1; n < 1000 && fabs(term) > fabs(sum)*1e-15; ++n) {
+            term *= _x/(_a+n);
+            sum += term;
+        }
+        return sum*exp(lnPrefix);
+    }
+    // Continued fraction of Q(_a, _x), by the modified Lentz method
+    double b = _x+1-_a, c = 1e300, d = 1/b, h = d;
+    for (int i = 1; i < 1000; ++i) {
+        double an = -i*(i-_a);
+        b += 2;
+        d = an*d + b;
+        d = (fabs(d) < 1e-300) ? 1e300 : 1/d;
+        c = b + an/c;
+        if (fabs(c) < 1e-300)
+            c = 1e-300;
+        double delta = d*c;
+        h *= delta;
+        if (fabs(delta-1) < 1e-15)
+            break;
+    }
+    return 1 - exp(lnPrefix)*h;
+}
+
+// Continued fraction of the incomplete beta function (Numerical Recipes, 6.4)
+double betaContinuedFraction(double _a, double _b, double _x) {
+    double c = 1, d = 1 - (_a+_b)*_x/(_a+1);
+    d = (fabs(d) < 1e-300) ? 1e300 : 1/d;
+    double h = d;
+    for (int m = 1; m < 1000; ++m) {
+        // Even step
+        double an = m*(_b-m)*_x/((_a+2*m-1)*(_a+2*m));
+        d = 1 + an*d;
+        d = (fabs(d) < 1e-300) ? 1e300 : 1/d;
+        c = 1 + an/c;
+        if (fabs(c) < 1e-300)
+            c = 1e-300;
+        h *= d*c;
+        // Odd step
+        an = -(_a+m)*(_a+_b+m)*_x/((_a+2*m)*(_a+2*m+1));
+        d = 1 + an*d;
+        d = (fabs(d) < 1e-300) ? 1e300 : 1/d;
+        c = 1 + an/c;
+        if (fabs(c) < 1e-300)
+            c = 1e-300;
+        double delta = d*c;
+        h *= delta;
+        if (fabs(delta-1) < 1e-15)
+            break;
+    }
+    return h;
+}
+
+// Regularised incomplete beta function I_x(_a, _b)
+double incompleteBeta(double _a, double _b, double _x) {
+    if (_x <= 0)
+        return 0;
+    if (_x >= 1)
+        return 1;
+    double lnPrefix = lgamma(_a+_b) - lgamma(_a) - lgamma(_b) + _a*log(_x) + _b*log(1-_x);
+    if (_x < (_a+1)/(_a+_b+2))
+        return exp(lnPrefix)*betaContinuedFraction(_a, _b, _x)/_a;
+    return 1 - exp(lnPrefix)*betaContinuedFraction(_b, _a, 1-_x)/_b;
+}
+
+// Chi-squared distribution function with _df degrees of freedom
+double chiSquaredCdf(double _x, double _df) {
+    return incompleteGamma(_df/2, _x/2);
+}
+
+// Student's t distribution function with _df degrees of freedom
+double studentCdf(double _t, double _df) {
+    double tail = 0.5*incompleteBeta(_df/2, 0.5, _df/(_df + _t*_t));
+    return (_t > 0) ? 1-tail : tail;
+}
+
+// Get the _p quantile of increasing distribution function _cdf, by bisection
+template <typename Cdf>
+double quantile(Cdf _cdf, double _p, double _low, double _high) {
+    while (_cdf(_high) < _p)
+        _high *= 2;
+    for (int i = 0; i < 200 && _high-_low > 1e-12*_high; ++i) {
+        double mid = (_low+_high)/2;
+        if (_cdf(mid) < _p)
+            _low = mid;
+        else
+            _high = mid;
+    }
+    return (_low+_high)/2;
+}
+
+// Get the ranks of _values in 1..n, ties taking their average rank
+vector<double> getRanks(vector<double> const &_values) {
+    vector<int> order(_values.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&_values](int _i, int _j) { return _values[_i] < _values[_j]; });
+    vector<double> ranks(_values.size());
+    for (size_t i = 0; i < order.size(); ) {
+        size_t j = i;
+        while (j+1 < order.size() && _values[order[j+1]] == _values[order[i]])
+            ++j;
+        for (size_t k = i; k <= j; ++k)
+            ranks[order[k]] = (i+j)/2.0 + 1;
+        i = j+1;
+    }
+    return ranks;
+}
+
+}
+
+
+
+/**
+ * @brief FriedmanRace::FriedmanRace Ctor
+ * @param _numCandidates
+ * @param _significance
+ * @param _firstTest
+ */
+FriedmanRace::FriedmanRace(int _numCandidates, double _significance, int _firstTest)
+    : significance(_significance), firstTest(max(2, _firstTest)), alive(_numCandidates, true),
+      meanRanks(_numCandidates, 0), droppedAtBlock(_numCandidates, 0) { }
+
+
+/**
+ * @brief FriedmanRace::getAlive
+ * @return The candidates still in the race
+ */
+vector<int> FriedmanRace::getAlive() const {
+    vector<int> candidates;
+    for (int c = 0; c < (int)alive.size(); ++c) {
+        if (alive[c])
+            candidates.push_back(c);
+    }
+    return candidates;
+}
+
+
+/**
+ * @brief FriedmanRace::addBlock Add the costs of a block and test the remaining candidates.
+ * The Friedman statistic and the post-hoc comparisons follow Conover (Practical nonparametric
+ * statistics, 1999), as in F-Race
+ * @param _costs Cost of each candidate
+ * @return The candidates dropped after this block
+ */
+vector<int> FriedmanRace::addBlock(vector<double> const &_costs) {
+    costs.push_back(_costs);
+    vector<int> candidates = getAlive();
+    int k = candidates.size();
+    int n = costs.size();
+    if (k < 2)
+        return {};
+    // Rank sums of the remaining candidates, over all the blocks
+    vector<double> rankSums(k, 0);
+    double sumSquaredRanks = 0; // A
+    for (auto const &blockCosts : costs) {
+        vector<double> values;
+        for (int c : candidates)
+            values.push_back(blockCosts[c]);
+        vector<double> ranks = getRanks(values);
+        for (int j = 0; j < k; ++j) {
+            rankSums[j] += ranks[j];
+            sumSquaredRanks += ranks[j]*ranks[j];
+        }
+    }
+    for (int j = 0; j < k; ++j)
+        meanRanks[candidates[j]] = rankSums[j]/n;
+    if (n < firstTest)
+        return {};
+    // Friedman statistic. If all the ranks are tied, there is no difference
+    double c = n*k*(k+1)*(k+1)/4.0;
+    if (sumSquaredRanks - c <= 1e-12)
+        return {};
+    double s = 0;
+    for (double r : rankSums)
+        s += (r - n*(k+1)/2.0)*(r - n*(k+1)/2.0);
+    double t = (k-1)*s/(sumSquaredRanks - c);
+    double df = k-1;
+    if (t <= quantile([df](double _x) { return chiSquaredCdf(_x, df); }, 1-significance, 0, df+1))
+        return {};
+    // Post-hoc comparisons with the best candidate
+    double sumSquaredRankSums = 0;
+    for (double r : rankSums)
+        sumSquaredRankSums += r*r;
+    double postHocDf = (n-1)*(k-1);
+    double tQuantile = quantile([postHocDf](double _x) { return studentCdf(_x, postHocDf); }, 1-significance/2, 0, 10);
+    double criticalDifference = tQuantile*sqrt(2*(n*sumSquaredRanks - sumSquaredRankSums)/postHocDf);
+    double bestRankSum = *min_element(rankSums.begin(), rankSums.end());
+    vector<int> dropped;
+    for (int j = 0; j < k; ++j) {
+        if (rankSums[j] - bestRankSum > criticalDifference) {
+            alive[candidates[j]] = false;
+            droppedAtBlock[candidates[j]] = n;
+            dropped.push_back(candidates[j]);
+        }
+    }
+    return dropped;
+}
@@ -0,0 +1,60 @@
+#ifndef FRIEDMANRACE_H
+#define FRIEDMANRACE_H
+
+#include <vector>
+
+
+/**
+ * @brief The FriedmanRace class Racing of candidate configurations with the Friedman test
+ * (M. Birattari et al., A racing algorithm for configuring metaheuristics, GECCO 2002).
+ *
+ * The race is made of blocks. In each block, every candidate still in the race is run once
+ * on the same instance, and the candidates are ranked by cost within the block, so costs of
+ * different instances are never compared. After the first blocks, the Friedman test is applied
+ * to the ranks of the remaining candidates after each block. If they differ significantly, the
+ * candidates whose rank sum exceeds the best one by more than the post-hoc critical difference
+ * are dropped.
+ */
+class FriedmanRace {
+
+public:
+    /**
+     * @brief FriedmanRace Ctor
+     * @param _numCandidates # candidates
+     * @param _significance Significance level of the tests
+     * @param _firstTest # blocks before the first test
+     */
+    FriedmanRace(int _numCandidates, double _significance = 0.05, int _firstTest = 5);
+
+    /**
+     * @brief addBlock Add the costs of a block and test the remaining candidates
+     * @param _costs Cost of each candidate. Only those of the remaining candidates are used.
+     * Failed runs may be given an infinite cost
+     * @return The candidates dropped after this block
+     */
+    std::vector<int> addBlock(std::vector<double> const &_costs);
+
+    // Get whether candidate _candidate is still in the race
+    bool isAlive(int _candidate) const { return alive[_candidate]; }
+    // Get the candidates still in the race
+    std::vector<int> getAlive() const;
+    // Get # blocks
+    int getNumBlocks() const { return costs.size(); }
+    // Get the mean rank of candidate _candidate among the remaining candidates, in the
+    // blocks up to the one where it was dropped
+    double getMeanRank(int _candidate) const { return meanRanks[_candidate]; }
+    // Get the block after which candidate _candidate was dropped (0 if it is still in the race)
+    int getDroppedAtBlock(int _candidate) const { return droppedAtBlock[_candidate]; }
+
+private:
+    // Instance fields
+    double significance;
+    int firstTest;
+    std::vector<std::vector<double> > costs; // Costs of each block
+    std::vector<bool> alive;
+    std::vector<double> meanRanks;
+    std::vector<int> droppedAtBlock;
+};
+
+
+#endif // FRIEDMANRACE_H
@@ -0,0 +1,67 @@
+
+
+#include "utils/MappedFile.h"
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+
+/**
+ * @brief MappedFile::MappedFile Map file _filename in memory
+ * @param _filename
+ */
+MappedFile::MappedFile(std::string const &_filename)
+    : data(nullptr), size(0) {
+    int fd = open(_filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error(std::string("couldn't open file: ") + strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        int err = errno;
+        close(fd);
+        throw std::runtime_error(std::string("couldn't stat file: ") + strerror(err));
+    }
+    size = st.st_size;
+    // An empty file cannot be mapped
+    if (size > 0) {
+        void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            int err = errno;
+            close(fd);
+            throw std::runtime_error(std::string("couldn't map file: ") + strerror(err));
+        }
+        data = static_cast<char const *>(addr);
+        // The file is read once, from the beginning to the end
+        madvise(addr, size, MADV_SEQUENTIAL);
+    }
+    // The mapping remains valid after closing the descriptor
+    close(fd);
+}
+
+
+/**
+ * @brief MappedFile::~MappedFile Unmap the file
+ */
+MappedFile::~MappedFile() {
+    if (data != nullptr)
+        munmap(const_cast<char *>(data), size);
+}
+
+
+/**
+ * @brief MappedFile::getChecksum 64-bit FNV-1a hash of the file contents
+ * @return
+ */
+std::uint64_t MappedFile::getChecksum() const {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
@@ -0,0 +1,50 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+ * @brief The MappedFile class Read-only memory mapping of a whole file.
+ *
+ * The pages are shared with the page cache, so processes mapping the same
+ * file do not duplicate it in memory. Throws std::runtime_error if the file
+ * cannot be opened or mapped.
+ */
+class MappedFile {
+
+public:
+    /**
+     * @brief MappedFile Map file _filename in memory
+     * @param _filename
+     */
+    explicit MappedFile(std::string const &_filename);
+    /**
+     * @brief ~MappedFile Unmap the file
+     */
+    ~MappedFile();
+
+    // Get mapped data. It is null for an empty file
+    char const *getData() const { return data; }
+    // Get file size in bytes
+    std::size_t getSize() const { return size; }
+
+    /**
+     * @brief getChecksum 64-bit FNV-1a hash of the file contents
+     * @return
+     */
+    std::uint64_t getChecksum() const;
+
+private:
+    // Non-copyable
+    MappedFile(MappedFile const &);
+    MappedFile &operator=(MappedFile const &);
+
+    char const *data;
+    std::size_t size;
+};
+
+
+#endif // MAPPEDFILE_H
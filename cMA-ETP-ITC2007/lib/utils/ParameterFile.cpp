@@ -0,0 +1,141 @@
+
+
+#include "utils/ParameterFile.h"
+#include <fstream>
+#include <stdexcept>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+
+
+using namespace std;
+
+
+namespace {
+
+// Remove leading and trailing blanks
+string trim(string const &_s) {
+    size_t first = _s.find_first_not_of(" \t\r");
+    if (first == string::npos)
+        return "";
+    size_t last = _s.find_last_not_of(" \t\r");
+    return _s.substr(first, last - first + 1);
+}
+
+}
+
+
+
+/**
+ * @brief ParameterFile::load Load the parameters of file _filename, replacing the current ones
+ * @param _filename
+ */
+void ParameterFile::load(string const &_filename) {
+    ifstream in(_filename.c_str());
+    if (!in)
+        throw runtime_error("couldn't open parameter file " + _filename);
+    map<string, string> newValues;
+    map<string, int> newLines;
+    string line;
+    for (int lineNumber = 1; getline(in, line); ++lineNumber) {
+        // Remove comment
+        size_t comment = line.find('#');
+        if (comment != string::npos)
+            line.erase(comment);
+        line = trim(line);
+        if (line.empty())
+            continue;
+        size_t eq = line.find('=');
+        string key = trim(line.substr(0, eq));
+        if (eq == string::npos || key.empty())
+            throw runtime_error(_filename + ":" + to_string(lineNumber) + ": expected 'key = value'");
+        newValues[key] = trim(line.substr(eq+1));
+        newLines[key] = lineNumber;
+    }
+    values.swap(newValues);
+    lines.swap(newLines);
+    filename = _filename;
+}
+
+
+/**
+ * @brief ParameterFile::contains
+ * @param _key
+ * @return true if parameter _key is set
+ */
+bool ParameterFile::contains(string const &_key) const {
+    return values.find(_key) != values.end();
+}
+
+
+/**
+ * @brief ParameterFile::getString
+ * @param _key
+ * @param _default
+ * @return The value of parameter _key, or _default if it is not set
+ */
+string ParameterFile::getString(string const &_key, string const &_default) const {
+    auto it = values.find(_key);
+    return (it != values.end()) ? it->second : _default;
+}
+
+
+/**
+ * @brief ParameterFile::getDouble
+ * @param _key
+ * @param _default
+ * @return The value of parameter _key, or _default if it is not set
+ */
+double ParameterFile::getDouble(string const &_key, double _default) const {
+    auto it = values.find(_key);
+    if (it == values.end())
+        return _default;
+    char *end;
+    errno = 0;
+    double value = strtod(it->second.c_str(), &end);
+    if (it->second.empty() || *end != '\0' || errno != 0)
+        throw runtime_error(filename + ":" + to_string(lines.at(_key)) + ": invalid number for " + _key);
+    return value;
+}
+
+
+/**
+ * @brief ParameterFile::getInt
+ * @param _key
+ * @param _default
+ * @return The value of parameter _key, or _default if it is not set
+ */
+int ParameterFile::getInt(string const &_key, int _default) const {
+    auto it = values.find(_key);
+    if (it == values.end())
+        return _default;
+    char *end;
+    errno = 0;
+    long value = strtol(it->second.c_str(), &end, 10);
+    if (it->second.empty() || *end != '\0' || errno != 0 || value < INT_MIN || value > INT_MAX)
+        throw runtime_error(filename + ":" + to_string(lines.at(_key)) + ": invalid integer for " + _key);
+    return value;
+}
+
+
+/**
+ * @brief ParameterFile::getKeys
+ * @return The keys, in alphabetical order
+ */
+vector<string> ParameterFile::getKeys() const {
+    vector<string> keys;
+    for (auto const &p : values)
+        keys.push_back(p.first);
+    return keys;
+}
+
+
+/**
+ * @brief ParameterFile::getLine
+ * @param _key
+ * @return The line of parameter _key in the file, or 0 if it is not set
+ */
+int ParameterFile::getLine(string const &_key) const {
+    auto it = lines.find(_key);
+    return (it != lines.end()) ? it->second : 0;
+}
@@ -0,0 +1,71 @@
+#ifndef PARAMETERFILE_H
+#define PARAMETERFILE_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+
+/**
+ * @brief The ParameterFile class Parameters read from a text file of "key = value" lines.
+ *
+ * Blank lines and text after '#' are ignored. Keys and values are trimmed. A
+ * malformed line or value throws std::runtime_error, naming the file and line.
+ */
+class ParameterFile {
+
+public:
+    /**
+     * @brief load Load the parameters of file _filename, replacing the current ones
+     * @param _filename
+     */
+    void load(std::string const &_filename);
+
+    /**
+     * @brief contains
+     * @param _key
+     * @return true if parameter _key is set
+     */
+    bool contains(std::string const &_key) const;
+
+    /**
+     * @brief getString
+     * @param _key
+     * @param _default
+     * @return The value of parameter _key, or _default if it is not set
+     */
+    std::string getString(std::string const &_key, std::string const &_default) const;
+
+    /**
+     * @brief getDouble
+     * @param _key
+     * @param _default
+     * @return The value of parameter _key, or _default if it is not set
+     */
+    double getDouble(std::string const &_key, double _default) const;
+
+    /**
+     * @brief getInt
+     * @param _key
+     * @param _default
+     * @return The value of parameter _key, or _default if it is not set
+     */
+    int getInt(std::string const &_key, int _default) const;
+
+    // Get the keys, in alphabetical order
+    std::vector<std::string> getKeys() const;
+
+    // Get the line of parameter _key in the file (0 if it is not set)
+    int getLine(std::string const &_key) const;
+
+private:
+    // Parameter values
+    std::map<std::string, std::string> values;
+    // Line of each parameter, used in error messages
+    std::map<std::string, int> lines;
+    // Source file name
+    std::string filename;
+};
+
+
+#endif // PARAMETERFILE_H
@@ -0,0 +1,44 @@
+
+
+#include "utils/SignalHandler.h"
+#include <signal.h>
+#include <cstring>
+
+
+std::atomic<int> SignalHandler::requests(0);
+
+
+
+/**
+ * @brief SignalHandler::install Install the signal handlers
+ */
+void SignalHandler::install() {
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = &SignalHandler::handle;
+    sigemptyset(&action.sa_mask);
+    // Interrupted system calls are restarted
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    sigaction(SIGUSR1, &action, nullptr);
+    sigaction(SIGUSR2, &action, nullptr);
+}
+
+
+/**
+ * @brief SignalHandler::handle Set the request bit of signal _signal. Only async-signal-safe
+ * operations are used: a lock-free atomic update, and signal and raise
+ * @param _signal
+ */
+void SignalHandler::handle(int _signal) {
+    if (_signal == SIGUSR1)
+        requests.fetch_or(DumpRequest, std::memory_order_relaxed);
+    else if (_signal == SIGUSR2)
+        requests.fetch_or(ReloadRequest, std::memory_order_relaxed);
+    else if (requests.fetch_or(StopRequest, std::memory_order_relaxed) & StopRequest) {
+        // Second stop signal. Terminate now with the default action
+        signal(_signal, SIG_DFL);
+        raise(_signal);
+    }
+}
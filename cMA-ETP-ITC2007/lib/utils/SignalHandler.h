@@ -0,0 +1,52 @@
+#ifndef SIGNALHANDLER_H
+#define SIGNALHANDLER_H
+
+#include <atomic>
+
+
+/**
+ * @brief The SignalHandler class Non-interactive control of a running solver through signals.
+ *
+ *   - SIGINT, SIGTERM: stop after the current generation, saving a checkpoint.
+ *                      A second stop signal terminates the process immediately
+ *   - SIGUSR1: dump the best solution and a statistics snapshot, and continue
+ *   - SIGUSR2: reload the tunable parameters, and continue
+ *
+ * The handlers only set a request bit, so the solver polls all requests with
+ * a single relaxed atomic load per generation and acts on them between generations.
+ */
+class SignalHandler {
+
+public:
+    /**
+     * @brief The Request enum Request bits set by the signal handlers
+     */
+    enum Request { StopRequest = 1, DumpRequest = 2, ReloadRequest = 4 };
+
+    /**
+     * @brief install Install the signal handlers
+     */
+    static void install();
+
+    // Get the pending requests
+    static int getRequests() { return requests.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief takeRequests Clear the pending requests in _mask
+     * @param _mask
+     * @return The requests in _mask which were pending
+     */
+    static int takeRequests(int _mask) {
+        return requests.fetch_and(~_mask, std::memory_order_relaxed) & _mask;
+    }
+
+private:
+    // Signal handler
+    static void handle(int _signal);
+
+    // Pending requests
+    static std::atomic<int> requests;
+};
+
+
+#endif // SIGNALHANDLER_H
@@ -0,0 +1,83 @@
+
+
+#include "utils/WorkerPool.h"
+#include <stdexcept>
+#include <algorithm>
+
+
+using namespace std;
+
+
+
+/**
+ * @brief WorkerPool::WorkerPool Start the worker threads
+ * @param _numWorkers # worker threads, besides the calling thread
+ */
+WorkerPool::WorkerPool(int _numWorkers)
+    : task(nullptr), numTasks(0), round(0), numPendingTasks(0), stopping(false) {
+    for (int k = 1; k <= _numWorkers; ++k)
+        threads.push_back(std::thread(&WorkerPool::workerLoop, this, k));
+}
+
+
+/**
+ * @brief WorkerPool::~WorkerPool Stop the worker threads
+ */
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    roundStarted.notify_all();
+    for (auto &thread : threads)
+        thread.join();
+}
+
+
+/**
+ * @brief WorkerPool::run Run _task(k), k = 0, ..., _numTasks-1, and wait for all of them.
+ * Task 0 runs on the calling thread
+ * @param _task
+ * @param _numTasks
+ */
+void WorkerPool::run(function<void(int)> const &_task, int _numTasks) {
+    if (_numTasks > (int)threads.size() + 1)
+        throw runtime_error("In [WorkerPool::run]: the # tasks exceeds the # workers + 1");
+    {
+        lock_guard<std::mutex> lock(mutex);
+        task = &_task;
+        numTasks = _numTasks;
+        numPendingTasks = max(0, _numTasks-1);
+        ++round;
+    }
+    roundStarted.notify_all();
+    if (_numTasks > 0)
+        _task(0);
+    unique_lock<std::mutex> lock(mutex);
+    roundFinished.wait(lock, [this] { return numPendingTasks == 0; });
+}
+
+
+/**
+ * @brief WorkerPool::workerLoop Worker thread loop. Worker _k runs task _k of each round
+ * with at least _k+1 tasks
+ * @param _k
+ */
+void WorkerPool::workerLoop(int _k) {
+    long lastRound = 0;
+    unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        roundStarted.wait(lock, [this, lastRound] { return round != lastRound || stopping; });
+        if (stopping)
+            break;
+        lastRound = round;
+        if (_k >= numTasks)
+            continue;
+        function<void(int)> const &roundTask = *task;
+        lock.unlock();
+        roundTask(_k);
+        lock.lock();
+        if (--numPendingTasks == 0)
+            roundFinished.notify_one();
+    }
+}
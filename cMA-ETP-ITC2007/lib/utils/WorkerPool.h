@@ -0,0 +1,70 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+/**
+ * @brief The WorkerPool class Persistent worker threads which run the tasks of a round in parallel.
+ *
+ * The threads are started once and live as long as the pool, so a pool can be shared by every
+ * local search run of an evolution. Between rounds the workers are parked on a condition
+ * variable and don't use any CPU. In each round, task 0 runs on the calling thread and tasks
+ * 1, 2, ... run on workers 1, 2, ...
+ */
+class WorkerPool {
+
+public:
+    /**
+     * @brief WorkerPool Start the worker threads
+     * @param _numWorkers # worker threads, besides the calling thread
+     */
+    explicit WorkerPool(int _numWorkers);
+
+    /**
+     * @brief ~WorkerPool Stop the worker threads
+     */
+    ~WorkerPool();
+
+    // Get # worker threads
+    int getNumWorkers() const { return threads.size(); }
+
+    /**
+     * @brief run Run _task(k), k = 0, ..., _numTasks-1, and wait for all of them.
+     * Pre-condition: _numTasks <= # workers + 1. The tasks must not throw
+     * @param _task
+     * @param _numTasks
+     */
+    void run(std::function<void(int)> const &_task, int _numTasks);
+
+private:
+    // Non-copyable
+    WorkerPool(WorkerPool const &);
+    WorkerPool &operator=(WorkerPool const &);
+
+    // Worker thread loop. Worker _k runs task _k of each round
+    void workerLoop(int _k);
+
+    std::vector<std::thread> threads;
+    // Task of the current round and its # tasks
+    std::function<void(int)> const *task;
+    int numTasks;
+    // Round counter. The workers start when it is incremented
+    long round;
+    // # worker tasks which didn't finish in the current round
+    int numPendingTasks;
+    // True when the workers must stop
+    bool stopping;
+    std::mutex mutex;
+    // Signalled when a round starts or the workers must stop
+    std::condition_variable roundStarted;
+    // Signalled when the worker tasks of the round are finished
+    std::condition_variable roundFinished;
+};
+
+
+#endif // WORKERPOOL_H